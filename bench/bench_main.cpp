@@ -0,0 +1,484 @@
+// Repeatable performance harness for the per-turn hot paths.
+//
+// Builds a fixed, seeded fixture on the reality bubble (a block of buildings with one
+// of them on fire, a vehicle convoy on the main road and a few hundred zombies), runs a
+// number of turns and reports the time and the number of heap allocations of each
+// subsystem as JSON, so results can be compared between builds.
+// Also reports how long loading the game data took, and how long parsing all of
+// data/json takes (from memory, so disk access is not measured).
+//
+// Usage: cata_bench [--turns=N] [--seed=N] [--zombies=N] [--json-passes=N] [--user-dir=DIR]
+//                   [--output=FILE]
+
+#include <assert.h>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "creature_tracker.h"
+#include "debug.h"
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
+#include "json.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "monster.h"
+#include "options.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "pathfinding.h"
+#include "color.h"
+#include "pldata.h"
+#include "rng.h"
+#include "type_id.h"
+#include "vpart_position.h"
+#include "worldfactory.h"
+#include "cata_utility.h"
+#include "game_constants.h"
+#include "point.h"
+
+// Every heap allocation of the whole program goes through here, so the counter tells
+// how many allocations a subsystem did while it was being measured.
+static std::atomic<long long> allocation_count( 0 );
+
+void *operator new( std::size_t size )
+{
+    ++allocation_count;
+    if( void *ptr = std::malloc( size == 0 ? 1 : size ) ) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+struct bench_options {
+    int turns = 100;
+    unsigned int seed = 42;
+    int zombies = 300;
+    int json_passes = 3;
+    std::string user_dir = "./";
+    std::string output;
+};
+
+struct subsystem_stats {
+    std::string name;
+    std::vector<long long> turn_ns;
+    long long allocations = 0;
+
+    explicit subsystem_stats( const std::string &name ) : name( name ) {}
+
+    template<typename F>
+    void measure( F f ) {
+        const long long allocations_before = allocation_count;
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        allocations += allocation_count - allocations_before;
+        turn_ns.push_back( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() );
+    }
+
+    void serialize( JsonOut &jsout ) const {
+        std::vector<long long> sorted = turn_ns;
+        std::sort( sorted.begin(), sorted.end() );
+        long long total = 0;
+        for( const long long ns : sorted ) {
+            total += ns;
+        }
+        const size_t turns = std::max<size_t>( sorted.size(), 1 );
+
+        jsout.start_object();
+        jsout.member( "name", name );
+        jsout.member( "total_us", total / 1000.0 );
+        jsout.member( "mean_us", total / 1000.0 / turns );
+        jsout.member( "median_us", sorted.empty() ? 0.0 : sorted[sorted.size() / 2] / 1000.0 );
+        jsout.member( "max_us", sorted.empty() ? 0.0 : sorted.back() / 1000.0 );
+        jsout.member( "allocations", allocations );
+        jsout.member( "allocations_per_turn", static_cast<double>( allocations ) / turns );
+        jsout.end_object();
+    }
+};
+
+static bool extract_argument( const char *arg, const char *tag, std::string &value )
+{
+    if( strncmp( arg, tag, strlen( tag ) ) != 0 ) {
+        return false;
+    }
+    value = arg + strlen( tag );
+    return true;
+}
+
+static bench_options parse_arguments( const int argc, const char *argv[] )
+{
+    bench_options opts;
+    for( int i = 1; i < argc; ++i ) {
+        std::string value;
+        if( extract_argument( argv[i], "--turns=", value ) ) {
+            opts.turns = std::max( 1, std::atoi( value.c_str() ) );
+        } else if( extract_argument( argv[i], "--seed=", value ) ) {
+            opts.seed = static_cast<unsigned int>( std::strtoul( value.c_str(), nullptr, 10 ) );
+        } else if( extract_argument( argv[i], "--zombies=", value ) ) {
+            opts.zombies = std::max( 0, std::atoi( value.c_str() ) );
+        } else if( extract_argument( argv[i], "--json-passes=", value ) ) {
+            opts.json_passes = std::max( 0, std::atoi( value.c_str() ) );
+        } else if( extract_argument( argv[i], "--user-dir=", value ) ) {
+            opts.user_dir = value;
+            if( !string_ends_with( opts.user_dir, "/" ) ) {
+                opts.user_dir += "/";
+            }
+        } else if( extract_argument( argv[i], "--output=", value ) ) {
+            opts.output = value;
+        } else {
+            std::cerr << "Unknown argument " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] <<
+                      " [--turns=N] [--seed=N] [--zombies=N] [--json-passes=N] [--user-dir=DIR]"
+                      " [--output=FILE]" << std::endl;
+            exit( EXIT_FAILURE );
+        }
+    }
+    return opts;
+}
+
+// Same setup as the test suite: a fresh world with the default mods and an empty overmap.
+// Returns how long loading the core data took, in milliseconds.
+static long long init_global_game_state( const std::string &user_dir )
+{
+    if( !assure_dir_exist( user_dir ) ) {
+        assert( !"Unable to make user_dir directory. Check permissions." );
+    }
+
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( user_dir.c_str() );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( FILENAMES["config_dir"] ) ) {
+        assert( !"Unable to make config directory. Check permissions." );
+    }
+
+    if( !assure_dir_exist( FILENAMES["savedir"] ) ) {
+        assert( !"Unable to make save directory. Check permissions." );
+    }
+
+    if( !assure_dir_exist( FILENAMES["templatedir"] ) ) {
+        assert( !"Unable to make templates directory. Check permissions." );
+    }
+
+    get_options().init();
+    get_options().load();
+    init_colors();
+
+    g.reset( new game );
+    g->new_game = true;
+    g->load_static_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->init();
+    WORLDPTR bench_world = world_generator->make_new_world( std::vector<mod_id>() );
+    assert( bench_world != NULL );
+    world_generator->set_active_world( bench_world );
+    assert( world_generator->active_world != NULL );
+
+    loading_ui ui( false );
+    const auto load_start = std::chrono::steady_clock::now();
+    g->load_core_data( ui );
+    const auto load_end = std::chrono::steady_clock::now();
+    g->load_world_modfiles( ui );
+
+    g->u = avatar();
+    g->u.create( PLTYPE_NOW );
+
+    g->m = map( get_option<bool>( "ZLEVELS" ) );
+
+    overmap_special_batch empty_specials( { 0, 0 } );
+    overmap_buffer.create_custom_overmap( point_zero, empty_specials );
+
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>( load_end - load_start ).count();
+}
+
+// Parses every value, including all strings and numbers, returns the number of values.
+static size_t parse_json_value( JsonIn &jsin )
+{
+    size_t values = 1;
+    if( jsin.test_object() ) {
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            jsin.get_member_name();
+            values += parse_json_value( jsin );
+        }
+    } else if( jsin.test_array() ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            values += parse_json_value( jsin );
+        }
+    } else if( jsin.test_string() ) {
+        jsin.get_string();
+    } else if( jsin.test_number() ) {
+        jsin.get_float();
+    } else if( jsin.test_bool() ) {
+        jsin.get_bool();
+    } else {
+        jsin.skip_null();
+    }
+    return values;
+}
+
+static void run_json_benchmark( const bench_options &opts, JsonOut &jsout )
+{
+    std::vector<std::string> contents;
+    size_t bytes = 0;
+    for( const std::string &file : get_files_from_path( ".json", "data/json", true, true ) ) {
+        std::ifstream fin( file, std::ifstream::in | std::ifstream::binary );
+        contents.emplace_back( ( std::istreambuf_iterator<char>( fin ) ),
+                               std::istreambuf_iterator<char>() );
+        bytes += contents.back().size();
+    }
+
+    subsystem_stats parse( "json_parse" );
+    size_t values = 0;
+    for( int pass = 0; pass < opts.json_passes; ++pass ) {
+        values = 0;
+        parse.measure( [&]() {
+            for( const std::string &content : contents ) {
+                JsonIn jsin( content.data(), content.size() );
+                values += parse_json_value( jsin );
+            }
+        } );
+    }
+
+    jsout.member( "json_files", static_cast<int>( contents.size() ) );
+    jsout.member( "json_bytes", static_cast<long long>( bytes ) );
+    jsout.member( "json_values", static_cast<long long>( values ) );
+    jsout.member( "json_parse" );
+    parse.serialize( jsout );
+}
+
+static tripoint random_passable_point( const int margin )
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    tripoint p;
+    do {
+        p = tripoint( rng( margin, mapsize - 1 - margin ), rng( margin, mapsize - 1 - margin ), 0 );
+    } while( !g->m.passable( p ) || g->m.veh_at( p ) || g->critter_at( p ) != nullptr );
+    return p;
+}
+
+// The fixture only depends on the seed, not on mapgen: every tile of the ground level
+// is overwritten.
+static void build_fixture( const bench_options &opts,
+                           std::vector<std::pair<tripoint, tripoint>> &routes )
+{
+    const ter_id t_grass( "t_grass" );
+    const ter_id t_pavement( "t_pavement" );
+    const ter_id t_floor( "t_floor" );
+    const ter_id t_wall( "t_wall" );
+    const ter_id t_door_c( "t_door_c" );
+    const ter_id t_window( "t_window" );
+    const ter_id t_open_air( "t_open_air" );
+
+    rng_set_engine_seed( opts.seed );
+    // Midnight, so light sources matter.
+    calendar::turn = DAYS( 1 );
+
+    g->clear_zombies();
+    for( wrapped_vehicle &veh : g->m.get_vehicles() ) {
+        g->m.destroy_vehicle( veh.v );
+    }
+    g->m.clear_traps();
+
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int z = g->m.has_zlevels() ? -OVERMAP_DEPTH : 0; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < mapsize; ++x ) {
+            for( int y = 0; y < mapsize; ++y ) {
+                const tripoint p( x, y, z );
+                g->m.set( p, z == 0 ? t_grass : t_open_air, f_null );
+                g->m.i_clear( p );
+            }
+        }
+    }
+
+    // A grid of streets with a building in each block.
+    constexpr int block = 22;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            if( x % block < 4 || y % block < 4 ) {
+                g->m.ter_set( tripoint( x, y, 0 ), t_pavement );
+            }
+        }
+    }
+    std::vector<tripoint> building_origins;
+    for( int bx = 0; bx + block <= mapsize; bx += block ) {
+        for( int by = 0; by + block <= mapsize; by += block ) {
+            const tripoint origin( bx + 6, by + 6, 0 );
+            const int w = rng( 8, 14 );
+            const int h = rng( 8, 14 );
+            for( int x = 0; x < w; ++x ) {
+                for( int y = 0; y < h; ++y ) {
+                    const tripoint p = origin + point( x, y );
+                    const bool edge = x == 0 || y == 0 || x == w - 1 || y == h - 1;
+                    if( !edge ) {
+                        g->m.ter_set( p, t_floor );
+                    } else if( ( x + y ) % 5 == 0 ) {
+                        g->m.ter_set( p, t_window );
+                    } else {
+                        g->m.ter_set( p, t_wall );
+                    }
+                }
+            }
+            g->m.ter_set( origin + point( w / 2, h - 1 ), t_door_c );
+            building_origins.push_back( origin );
+        }
+    }
+
+    // Set one building on fire, with some fuel so it keeps burning for a while.
+    const tripoint burning = building_origins[building_origins.size() / 2];
+    for( int x = 1; x < 7; ++x ) {
+        for( int y = 1; y < 7; ++y ) {
+            const tripoint p = burning + point( x, y );
+            g->m.spawn_item( p, "2x4", 4 );
+            if( one_in( 3 ) ) {
+                g->m.add_field( p, fd_fire, 3 );
+            }
+        }
+    }
+
+    // A convoy on the first street.
+    for( int i = 0; i < 4; ++i ) {
+        g->m.add_vehicle( vproto_id( "car" ), tripoint( 12 + i * 8, 1, 0 ), 0, 50, 0 );
+    }
+
+    // Candles in some of the buildings, they are active items.
+    for( size_t i = 0; i < building_origins.size(); i += 2 ) {
+        g->m.add_item( building_origins[i] + point( 2, 2 ), item( "candle_lit" ) );
+    }
+
+    g->place_player( tripoint( mapsize / 2, mapsize / 2, 0 ) );
+
+    for( int i = 0; i < opts.zombies; ++i ) {
+        monster zombie( mtype_id( "mon_zombie" ), random_passable_point( 0 ) );
+        // Bypassing game::add_zombie() since it sometimes upgrades the monster instantly.
+        g->critter_tracker->add( zombie );
+    }
+
+    routes.clear();
+    for( int i = 0; i < 16; ++i ) {
+        routes.emplace_back( random_passable_point( 2 ), random_passable_point( 2 ) );
+    }
+
+    g->m.invalidate_map_cache( 0 );
+    g->m.build_map_cache( 0 );
+}
+
+static void run_benchmark( const bench_options &opts, const long long load_core_data_ms,
+                           std::ostream &out )
+{
+    std::vector<std::pair<tripoint, tripoint>> routes;
+    build_fixture( opts, routes );
+
+    subsystem_stats map_cache( "build_map_cache" );
+    subsystem_stats route( "route" );
+    subsystem_stats monmove( "monmove" );
+    subsystem_stats fields( "process_fields" );
+    subsystem_stats active_items( "process_active_items" );
+    subsystem_stats vehicles( "vehmove" );
+    subsystem_stats total( "total" );
+
+    const pathfinding_settings route_settings( 0, 1000, 1000, 0, true, false, true, false );
+    size_t routes_found = 0;
+    const auto bench_start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < opts.turns; ++turn ) {
+        total.measure( [&]() {
+            map_cache.measure( []() {
+                g->m.build_map_cache( g->get_levz() );
+            } );
+            route.measure( [&]() {
+                for( const auto &r : routes ) {
+                    routes_found += !g->m.route( r.first, r.second, route_settings ).empty();
+                }
+            } );
+            monmove.measure( []() {
+                g->monmove();
+            } );
+            fields.measure( []() {
+                g->m.process_fields();
+            } );
+            active_items.measure( []() {
+                g->m.process_active_items();
+            } );
+            vehicles.measure( []() {
+                g->m.vehmove();
+            } );
+            g->cleanup_dead();
+            calendar::turn.increment();
+        } );
+    }
+    const auto bench_end = std::chrono::steady_clock::now();
+
+    JsonOut jsout( out, true );
+    jsout.start_object();
+    jsout.member( "seed", static_cast<int>( opts.seed ) );
+    jsout.member( "turns", opts.turns );
+    jsout.member( "zombies", opts.zombies );
+    jsout.member( "load_core_data_ms", load_core_data_ms );
+    run_json_benchmark( opts, jsout );
+    jsout.member( "monsters_left", static_cast<int>( g->num_creatures() ) - 1 );
+    jsout.member( "routes_found", static_cast<int>( routes_found ) );
+    jsout.member( "wall_time_ms", static_cast<long long>(
+                      std::chrono::duration_cast<std::chrono::milliseconds>( bench_end - bench_start ).count() ) );
+    jsout.member( "subsystems" );
+    jsout.start_array();
+    for( const subsystem_stats *stats : {
+             &map_cache, &route, &monmove, &fields, &active_items, &vehicles, &total
+         } ) {
+        stats->serialize( jsout );
+    }
+    jsout.end_array();
+    jsout.end_object();
+    out << std::endl;
+}
+
+int main( int argc, const char *argv[] )
+{
+    const bench_options opts = parse_arguments( argc, argv );
+
+    try {
+        // Debug messages would otherwise wait for a key press.
+        setupDebug( DebugOutput::std_err );
+        const long long load_core_data_ms = init_global_game_state( opts.user_dir );
+
+        if( opts.output.empty() ) {
+            run_benchmark( opts, load_core_data_ms, std::cout );
+        } else {
+            std::ofstream out( opts.output, std::ios::binary | std::ios::trunc );
+            run_benchmark( opts, load_core_data_ms, out );
+        }
+    } catch( const std::exception &err ) {
+        std::cerr << "Terminated: " << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,39 +1,103 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
+#include "calendar.h"
 #include "item.h"
 #include "safe_reference.h"
 
+static int current_turn_number()
+{
+    return to_turn<int>( calendar::turn );
+}
+
+active_item_cache::active_item_cache( const active_item_cache &other ) :
+    wheel( other.wheel ? new timing_wheel( *other.wheel ) : nullptr ),
+    current_turn( other.current_turn ), count( other.count ), next_offset( other.next_offset ),
+    processed_items( other.processed_items ), special_items( other.special_items )
+{
+}
+
+active_item_cache &active_item_cache::operator=( const active_item_cache &other )
+{
+    if( this != &other ) {
+        *this = active_item_cache( other );
+    }
+    return *this;
+}
+
+void active_item_cache::schedule( scheduled_item &&entry )
+{
+    entry.due = std::max( entry.due, current_turn );
+    const int delta = entry.due - current_turn;
+    for( int level = 0; level < wheel_levels; level++ ) {
+        const int shift = level * wheel_bits;
+        if( delta < ( wheel_size << shift ) ) {
+            wheel->levels[level][( entry.due >> shift ) & ( wheel_size - 1 )].push_back( std::move( entry ) );
+            return;
+        }
+    }
+    wheel->overflow.push_back( std::move( entry ) );
+}
+
+template<typename F>
+void active_item_cache::for_each_slot( F f )
+{
+    if( !wheel ) {
+        return;
+    }
+    for( wheel_level &level : wheel->levels ) {
+        for( std::vector<scheduled_item> &slot : level ) {
+            f( slot );
+        }
+    }
+    f( wheel->overflow );
+}
+
+template<typename F>
+void active_item_cache::remove_if( F f )
+{
+    for_each_slot( [this, &f]( std::vector<scheduled_item> &slot ) {
+        const auto new_end = std::remove_if( slot.begin(), slot.end(), f );
+        count -= std::distance( new_end, slot.end() );
+        slot.erase( new_end, slot.end() );
+    } );
+    if( count == 0 ) {
+        wheel.reset();
+    }
+}
+
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
+    const auto is_it_or_broken = [it]( const item_reference & active_item ) {
         item *const target = active_item.item_ref.get();
         return !target || target == it;
+    };
+    remove_if( [&]( const scheduled_item & entry ) {
+        return is_it_or_broken( entry.ref );
     } );
+    processed_items.erase( std::remove_if( processed_items.begin(), processed_items.end(),
+                                           is_it_or_broken ), processed_items.end() );
     if( it->can_revive() ) {
-        special_items[ "corpse" ].remove_if( [it]( const item_reference & active_item ) {
-            item *const target = active_item.item_ref.get();
-            return !target || target == it;
-        } );
+        special_items[ "corpse" ].remove_if( is_it_or_broken );
     }
     if( it->get_use( "explosion" ) ) {
-        special_items[ "explosives" ].remove_if( [it]( const item_reference & active_item ) {
-            item *const target = active_item.item_ref.get();
-            return !target || target == it;
-        } );
+        special_items[ "explosives" ].remove_if( is_it_or_broken );
     }
 }
 
 void active_item_cache::add( item &it, point location )
 {
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::list<item_reference> &target_list = active_items[it.processing_speed()];
-    if( std::find_if( target_list.begin(),
-    target_list.end(), [&it]( const item_reference & active_item_ref ) {
-    return &it == active_item_ref.item_ref.get();
-    } ) != target_list.end() ) {
+    bool found = false;
+    for_each_slot( [&]( const std::vector<scheduled_item> &slot ) {
+        found = found || std::any_of( slot.begin(), slot.end(), [&it]( const scheduled_item & entry ) {
+            return entry.ref.item_ref.get() == &it;
+        } );
+    } );
+    if( found ) {
         return;
     }
     if( it.can_revive() ) {
@@ -42,52 +106,117 @@ void active_item_cache::add( item &it, point location )
     if( it.get_use( "explosion" ) ) {
         special_items[ "explosives" ].push_back( item_reference{ location, it.get_safe_reference() } );
     }
-    target_list.push_back( item_reference{ location, it.get_safe_reference() } );
+    if( !wheel ) {
+        wheel.reset( new timing_wheel() );
+        current_turn = current_turn_number();
+    }
+    const int speed = std::max( 1, it.processing_speed() );
+    schedule( { item_reference{ location, it.get_safe_reference() },
+                current_turn_number() + next_offset++ % speed, speed } );
+    count++;
 }
 
 bool active_item_cache::empty() const
 {
-    return active_items.empty();
+    return count == 0;
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
-                ++it;
-            } else {
-                it = kv.second.erase( it );
-            }
+    remove_if( [&]( const scheduled_item & entry ) {
+        if( !entry.ref.item_ref ) {
+            return true;
         }
-    }
+        all_cached_items.push_back( entry.ref );
+        return false;
+    } );
     return all_cached_items;
 }
 
+void active_item_cache::reschedule( const int turn )
+{
+    std::vector<scheduled_item> entries;
+    remove_if( [&entries]( const scheduled_item & entry ) {
+        entries.push_back( entry );
+        return true;
+    } );
+    current_turn = turn;
+    if( entries.empty() ) {
+        return;
+    }
+    wheel.reset( new timing_wheel() );
+    count = entries.size();
+    for( scheduled_item &entry : entries ) {
+        if( entry.due < turn || entry.due > turn + entry.speed ) {
+            entry.due = turn + next_offset++ % entry.speed;
+        }
+        schedule( std::move( entry ) );
+    }
+}
+
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
-    std::vector<item_reference> items_to_process;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
-                --num_to_process;
-                ++it;
-            } else {
-                // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+    const int turn = current_turn_number();
+    if( turn == current_turn - 1 ) {
+        // Already processed this turn, return the same items again.
+        processed_items.erase( std::remove_if( processed_items.begin(), processed_items.end(),
+        []( const item_reference & ref ) {
+            return !ref.item_ref;
+        } ), processed_items.end() );
+        return processed_items;
+    }
+    processed_items.clear();
+    if( !wheel ) {
+        current_turn = turn + 1;
+        return processed_items;
+    }
+    if( turn < current_turn || turn - current_turn >= wheel_size ) {
+        reschedule( turn );
+        if( !wheel ) {
+            current_turn = turn + 1;
+            return processed_items;
+        }
+    }
+
+    std::vector<scheduled_item> due;
+    for( ; current_turn <= turn; current_turn++ ) {
+        // Move the items of the higher levels down once their slot is reached, starting
+        // with the highest level so that its items can end up in any lower level.
+        for( int level = wheel_levels - 1; level > 0; level-- ) {
+            const int shift = level * wheel_bits;
+            if( ( current_turn & ( ( 1 << shift ) - 1 ) ) != 0 ) {
+                continue;
+            }
+            std::vector<scheduled_item> entries;
+            entries.swap( wheel->levels[level][( current_turn >> shift ) & ( wheel_size - 1 )] );
+            if( level == wheel_levels - 1 ) {
+                std::move( wheel->overflow.begin(), wheel->overflow.end(), std::back_inserter( entries ) );
+                wheel->overflow.clear();
             }
+            for( scheduled_item &entry : entries ) {
+                schedule( std::move( entry ) );
+            }
+        }
+        std::vector<scheduled_item> &slot = wheel->levels[0][current_turn & ( wheel_size - 1 )];
+        std::move( slot.begin(), slot.end(), std::back_inserter( due ) );
+        slot.clear();
+    }
+
+    for( scheduled_item &entry : due ) {
+        if( !entry.ref.item_ref ) {
+            // The item has been destroyed, so remove the reference from the cache
+            count--;
+            continue;
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        processed_items.push_back( entry.ref );
+        entry.due = turn + entry.speed;
+        schedule( std::move( entry ) );
     }
-    return items_to_process;
+    if( count == 0 ) {
+        wheel.reset();
+    }
+    return processed_items;
 }
 
 std::vector<item_reference> active_item_cache::get_special( std::string type )
@@ -101,18 +230,24 @@ std::vector<item_reference> active_item_cache::get_special( std::string type )
 
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( auto &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location -= delta;
+    for_each_slot( [&delta]( std::vector<scheduled_item> &slot ) {
+        for( scheduled_item &entry : slot ) {
+            entry.ref.location -= delta;
         }
+    } );
+    for( item_reference &ir : processed_items ) {
+        ir.location -= delta;
     }
 }
 
 void active_item_cache::rotate_locations( int turns, const point &dim )
 {
-    for( auto &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location = ir.location.rotate( turns, dim );
+    for_each_slot( [turns, &dim]( std::vector<scheduled_item> &slot ) {
+        for( scheduled_item &entry : slot ) {
+            entry.ref.location = entry.ref.location.rotate( turns, dim );
         }
+    } );
+    for( item_reference &ir : processed_items ) {
+        ir.location = ir.location.rotate( turns, dim );
     }
 }
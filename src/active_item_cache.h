@@ -2,7 +2,10 @@
 #ifndef ACTIVE_ITEM_CACHE_H
 #define ACTIVE_ITEM_CACHE_H
 
+#include <array>
 #include <list>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -17,17 +20,71 @@ struct item_reference {
     safe_reference<item> item_ref;
 };
 
+/**
+ * The active items of a submap or vehicle, scheduled on a hierarchical timing wheel by
+ * the turn they are processed next (every item::processing_speed() turns).
+ *
+ * Processing only looks at the wheel slots of the turns that passed, so items that are
+ * not due (e.g. food, which is processed every 10 minutes) are not touched at all.
+ */
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        struct scheduled_item {
+            item_reference ref;
+            // Turn the item is processed next.
+            int due;
+            int speed;
+        };
+
+        // Level n of the wheel has wheel_size slots of wheel_size^n turns each.
+        static constexpr int wheel_bits = 6;
+        static constexpr int wheel_size = 1 << wheel_bits;
+        static constexpr int wheel_levels = 3;
+        using wheel_level = std::array<std::vector<scheduled_item>, wheel_size>;
+        struct timing_wheel {
+            std::array<wheel_level, wheel_levels> levels;
+            // Items due further ahead than the wheel reaches.
+            std::vector<scheduled_item> overflow;
+        };
+
+        // Only allocated while there are active items, most submaps have none.
+        std::unique_ptr<timing_wheel> wheel;
+        // First turn that has not been processed yet.
+        int current_turn = 0;
+        size_t count = 0;
+        // Spreads items with the same processing speed evenly over the turns.
+        int next_offset = 0;
+        // Items returned by get_for_processing for the last processed turn.
+        std::vector<item_reference> processed_items;
+
         std::unordered_map<std::string, std::list<item_reference>> special_items;
 
+        void schedule( scheduled_item &&entry );
+        /** Calls f for each slot (vector of scheduled items) of the wheel. */
+        template<typename F>
+        void for_each_slot( F f );
+        /** Removes the scheduled items for which f returns true. */
+        template<typename F>
+        void remove_if( F f );
+        /**
+         * Catch-up path if the last turns were not processed (the submap was outside the
+         * reality bubble) or the clock has been turned back: items that became due meanwhile
+         * are spread over their next processing interval instead of all being processed at
+         * once, and the wheel restarts at the given turn.
+         */
+        void reschedule( int turn );
+
     public:
+        active_item_cache() = default;
+        active_item_cache( const active_item_cache &other );
+        active_item_cache( active_item_cache && ) = default;
+        active_item_cache &operator=( const active_item_cache &other );
+        active_item_cache &operator=( active_item_cache && ) = default;
+
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
-         * Also removes any items that have been destroyed in the list containing it
+         * Also removes any items that have been destroyed.
          */
         void remove( const item *it );
 
@@ -49,11 +106,10 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
-         * Broken references encountered when collecting the items to be processed are removed from
-         * the cache.
+         * Returns the items that are due in the current turn (or became due in earlier turns
+         * that were not processed) and schedules them for their next processing.
+         * Calling it again in the same turn returns the same items.
+         * Broken references encountered when collecting the items are removed from the cache.
          * Relies on the fact that item::processing_speed() is a constant.
          */
         std::vector<item_reference> get_for_processing();
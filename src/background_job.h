@@ -0,0 +1,53 @@
+#pragma once
+#ifndef BACKGROUND_JOB_H
+#define BACKGROUND_JOB_H
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * A function running on its own thread. The game thread may only look at the data the
+ * function works on once @ref finished returns true or after @ref wait.
+ */
+class background_job
+{
+    public:
+        background_job() = default;
+        background_job( const background_job & ) = delete;
+        background_job &operator=( const background_job & ) = delete;
+        ~background_job() {
+            wait();
+        }
+
+        void start( const std::function<void()> &f ) {
+            wait();
+            done = false;
+            thread = std::thread( [this, f]() {
+                f();
+                done = true;
+            } );
+        }
+        /** Whether the job has been started and not been waited for yet. */
+        bool running() const {
+            return thread.joinable();
+        }
+        bool finished() const {
+            return done;
+        }
+        void wait() {
+            if( thread.joinable() ) {
+                thread.join();
+            }
+        }
+
+    private:
+        std::thread thread;
+        std::atomic<bool> done{ true };
+};
+
+#endif
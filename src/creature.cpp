@@ -240,6 +240,11 @@ bool Creature::sees( const Creature &critter ) const
     return sees( critter.pos(), p != nullptr ) && visible( p );
 }
 
+int Creature::max_sight_range() const
+{
+    return std::max( sight_range( DAYLIGHT_LEVEL ), sight_range( 0 ) );
+}
+
 bool Creature::sees( const tripoint &t, bool is_player, int range_mod ) const
 {
     if( !fov_3d && posz() != t.z ) {
@@ -247,9 +252,7 @@ bool Creature::sees( const tripoint &t, bool is_player, int range_mod ) const
     }
 
     const int range_cur = sight_range( g->m.ambient_light_at( t ) );
-    const int range_day = sight_range( DAYLIGHT_LEVEL );
-    const int range_night = sight_range( 0 );
-    const int range_max = std::max( range_day, range_night );
+    const int range_max = max_sight_range();
     const int range_min = std::min( range_cur, range_max );
     const int wanted_range = rl_dist( pos(), t );
     if( wanted_range <= range_min ||
@@ -169,6 +169,11 @@ class Creature
          * @param light_level See @ref game::light_level.
          */
         virtual int sight_range( int light_level ) const = 0;
+        /**
+         * Farthest distance at which @ref sees can see anything under any light. Brighter
+         * light than daylight does not extend the range beyond this.
+         */
+        int max_sight_range() const;
 
         /** Returns an approximation of the creature's strength. */
         virtual float power_rating() const = 0;
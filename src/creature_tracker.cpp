@@ -5,7 +5,10 @@
 #include <string>
 #include <utility>
 
+#include "coordinate_conversions.h"
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -81,7 +84,7 @@ bool Creature_tracker::add( monster &critter )
     }
 
     monsters_list.emplace_back( std::make_shared<monster>( critter ) );
-    monsters_by_location[critter.pos()] = monsters_list.back();
+    set_location( critter.pos(), monsters_list.back() );
     return true;
 }
 
@@ -116,8 +119,8 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        erase_location( critter.pos() );
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -138,11 +141,140 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
     const auto pos_iter = monsters_by_location.find( loc );
     if( pos_iter != monsters_by_location.end() ) {
         if( pos_iter->second.get() == &critter ) {
-            monsters_by_location.erase( pos_iter );
+            erase_location( loc );
         }
     }
 }
 
+static tripoint grid_cell( const tripoint &p )
+{
+    return ms_to_sm_copy( p );
+}
+
+void Creature_tracker::set_location( const tripoint &p, const std::shared_ptr<monster> &critter )
+{
+    erase_location( p );
+    monsters_by_location[p] = critter;
+    grid[grid_cell( p )].push_back( critter.get() );
+}
+
+void Creature_tracker::erase_location( const tripoint &p )
+{
+    const auto pos_iter = monsters_by_location.find( p );
+    if( pos_iter == monsters_by_location.end() ) {
+        return;
+    }
+    const auto cell_iter = grid.find( grid_cell( p ) );
+    if( cell_iter != grid.end() ) {
+        std::vector<monster *> &cell = cell_iter->second;
+        const auto iter = std::find( cell.begin(), cell.end(), pos_iter->second.get() );
+        if( iter != cell.end() ) {
+            *iter = cell.back();
+            cell.pop_back();
+        }
+        if( cell.empty() ) {
+            grid.erase( cell_iter );
+        }
+    }
+    monsters_by_location.erase( pos_iter );
+}
+
+void Creature_tracker::collect( const tripoint &center, const int radius, const int cell_radius,
+                                const int skip_radius, const monster_filter &filter,
+                                std::vector<monster *> &result ) const
+{
+    const tripoint center_cell = grid_cell( center );
+    const int min_z = std::max( center.z - radius, -OVERMAP_DEPTH );
+    const int max_z = std::min( center.z + radius, OVERMAP_HEIGHT );
+    const auto add_cell = [&]( const std::vector<monster *> &cell ) {
+        for( monster *const critter : cell ) {
+            if( !critter->is_dead() && rl_dist( center, critter->pos() ) <= radius &&
+                ( !filter || filter( *critter ) ) ) {
+                result.push_back( critter );
+            }
+        }
+    };
+    const auto in_range = [&]( const tripoint & cell ) {
+        const int d = std::max( std::abs( cell.x - center_cell.x ), std::abs( cell.y - center_cell.y ) );
+        return d > skip_radius && d <= cell_radius && cell.z >= min_z && cell.z <= max_z;
+    };
+
+    const size_t cells_in_box = static_cast<size_t>( 2 * cell_radius + 1 ) * ( 2 * cell_radius + 1 ) *
+                                std::max( 0, max_z - min_z + 1 );
+    if( cells_in_box > grid.size() ) {
+        // Sparse population (or a huge radius), cheaper to look at the occupied cells only.
+        for( const auto &elem : grid ) {
+            if( in_range( elem.first ) ) {
+                add_cell( elem.second );
+            }
+        }
+        return;
+    }
+    for( int z = min_z; z <= max_z; z++ ) {
+        for( int x = center_cell.x - cell_radius; x <= center_cell.x + cell_radius; x++ ) {
+            for( int y = center_cell.y - cell_radius; y <= center_cell.y + cell_radius; y++ ) {
+                const tripoint cell( x, y, z );
+                if( !in_range( cell ) ) {
+                    continue;
+                }
+                const auto iter = grid.find( cell );
+                if( iter != grid.end() ) {
+                    add_cell( iter->second );
+                }
+            }
+        }
+    }
+}
+
+static void sort_by_distance( const tripoint &center, std::vector<monster *> &critters )
+{
+    std::sort( critters.begin(), critters.end(), [&center]( const monster * a, const monster * b ) {
+        const int da = rl_dist( center, a->pos() );
+        const int db = rl_dist( center, b->pos() );
+        return da != db ? da < db : a->pos() < b->pos();
+    } );
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, const int radius,
+        const monster_filter &filter ) const
+{
+    std::vector<monster *> result;
+    if( radius < 0 ) {
+        return result;
+    }
+    // A monster in a cell n cells away is at least ( n - 1 ) * SEEX + 1 squares away.
+    collect( center, radius, radius / SEEX + 1, -1, filter, result );
+    sort_by_distance( center, result );
+    return result;
+}
+
+std::vector<monster *> Creature_tracker::find_nearest( const tripoint &center, const size_t k,
+        const int radius, const monster_filter &filter ) const
+{
+    std::vector<monster *> result;
+    if( radius < 0 || k == 0 ) {
+        return result;
+    }
+    const int max_cell_radius = radius / SEEX + 1;
+    if( static_cast<size_t>( 2 * max_cell_radius + 1 ) * ( 2 * max_cell_radius + 1 ) > grid.size() ) {
+        // Searching ring by ring would visit every occupied cell once per ring.
+        result = find_in_radius( center, radius, filter );
+    } else {
+        for( int ring = 0; ring <= max_cell_radius; ring++ ) {
+            collect( center, radius, ring, ring - 1, filter, result );
+            sort_by_distance( center, result );
+            // Everything in the following rings is more than ring * SEEX squares away.
+            if( result.size() >= k && rl_dist( center, result[k - 1]->pos() ) <= ring * SEEX ) {
+                break;
+            }
+        }
+    }
+    if( result.size() > k ) {
+        result.resize( k );
+    }
+    return result;
+}
+
 void Creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -162,13 +294,15 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    grid.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    grid.clear();
     for( const std::shared_ptr<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
     }
 }
 
@@ -186,14 +320,14 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     std::shared_ptr<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
     }
 
     std::shared_ptr<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
     }
+    erase_location( first.pos() );
+    erase_location( second.pos() );
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
     tripoint temp = second.pos();
@@ -202,10 +336,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -3,6 +3,7 @@
 #define CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -16,6 +17,8 @@ class JsonOut;
 class Creature_tracker
 {
     public:
+        using monster_filter = std::function<bool( const monster & )>;
+
         Creature_tracker();
         ~Creature_tracker();
         /**
@@ -54,14 +57,45 @@ class Creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Returns all living monsters within the given distance (@ref rl_dist) of center
+         * for which filter returns true (all if it is empty), nearest first. Monsters at
+         * the same distance are ordered by position, so the result is deterministic.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius,
+                                               const monster_filter &filter = nullptr ) const;
+        /**
+         * Like @ref find_in_radius, but returns at most the k nearest monsters. Only the
+         * cells needed to find them are searched.
+         */
+        std::vector<monster *> find_nearest( const tripoint &center, size_t k, int radius,
+                                             const monster_filter &filter = nullptr ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
     private:
         std::vector<std::shared_ptr<monster>> monsters_list;
         std::unordered_map<tripoint, std::shared_ptr<monster>> monsters_by_location;
+        /**
+         * The monsters of @ref monsters_by_location bucketed by the submap (in map square
+         * coordinates of the reality bubble) their location is in. Only non-empty cells
+         * are stored.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> grid;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Sets the entry of @ref monsters_by_location and @ref grid at the given location. */
+        void set_location( const tripoint &p, const std::shared_ptr<monster> &critter );
+        /** Removes whatever is at the given location from @ref monsters_by_location and @ref grid. */
+        void erase_location( const tripoint &p );
+        /**
+         * Adds the living monsters accepted by filter within radius of center from the grid
+         * cells within cell_radius (Chebyshev distance in submaps) of the center cell,
+         * skipping the cells within skip_radius.
+         */
+        void collect( const tripoint &center, int radius, int cell_radius, int skip_radius,
+                      const monster_filter &filter, std::vector<monster *> &result ) const;
 };
 
 #endif
@@ -0,0 +1,325 @@
+#include "data_snapshot.h"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "get_version.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "mapdata.h"
+#include "monstergenerator.h"
+#include "mtype.h"
+#include "recipe.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+#include "string_id.h"
+#include "units.h"
+
+namespace data_snapshot
+{
+
+static const std::string file_magic = "CDDASNAP";
+static constexpr uint64_t file_version = 1;
+
+uint64_t hash_bytes( const void *data, const size_t size, uint64_t hash )
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>( data );
+    for( size_t i = 0; i < size; ++i ) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t initial_key()
+{
+    const std::string version = getVersionString();
+    return hash_bytes( version.data(), version.size() );
+}
+
+// Accumulates the fields of one entry.
+class entry_hasher
+{
+    public:
+        entry_hasher &operator<<( const int64_t value ) {
+            hash = hash_bytes( &value, sizeof( value ), hash );
+            return *this;
+        }
+        entry_hasher &operator<<( const std::string &value ) {
+            // The length keeps consecutive strings apart.
+            *this << static_cast<int64_t>( value.size() );
+            hash = hash_bytes( value.data(), value.size(), hash );
+            return *this;
+        }
+        template<typename T>
+        entry_hasher &operator<<( const std::set<T> &values ) {
+            *this << static_cast<int64_t>( values.size() );
+            for( const T &value : values ) {
+                *this << value;
+            }
+            return *this;
+        }
+        template<typename K, typename V>
+        entry_hasher &operator<<( const std::map<K, V> &values ) {
+            *this << static_cast<int64_t>( values.size() );
+            for( const auto &value : values ) {
+                *this << value.first << value.second;
+            }
+            return *this;
+        }
+        template<typename T>
+        entry_hasher &operator<<( const string_id<T> &value ) {
+            return *this << value.str();
+        }
+        template<typename T>
+        entry_hasher &operator<<( const std::vector<std::vector<T>> &alternatives ) {
+            *this << static_cast<int64_t>( alternatives.size() );
+            for( const std::vector<T> &alternative : alternatives ) {
+                *this << static_cast<int64_t>( alternative.size() );
+                for( const T &comp : alternative ) {
+                    *this << comp;
+                }
+            }
+            return *this;
+        }
+        entry_hasher &operator<<( const component &comp ) {
+            return *this << comp.type << comp.count << static_cast<int64_t>( comp.recoverable );
+        }
+        entry_hasher &operator<<( const quality_requirement &qual ) {
+            return *this << qual.type << qual.count << qual.level;
+        }
+        entry_hasher &operator<<( const requirement_data &req ) {
+            return *this << req.get_tools() << req.get_components() << req.get_qualities();
+        }
+
+        uint64_t hash = fnv_offset_basis;
+};
+
+static digest digest_items()
+{
+    digest result;
+    for( const itype *type : item_controller->all() ) {
+        entry_hasher h;
+        h << type->get_item_type_string() << to_gram( type->weight ) << to_milliliter( type->volume )
+          << type->price << type->price_post << type->stack_size << type->damage_max()
+          << type->qualities << type->item_tags;
+        result[type->get_id()] = h.hash;
+    }
+    return result;
+}
+
+static digest digest_monsters()
+{
+    digest result;
+    for( const mtype &type : MonsterGenerator::generator().get_all_mtypes() ) {
+        entry_hasher h;
+        h << type.hp << type.speed << type.melee_dice << type.melee_sides << type.def_chance;
+        for( int i = 0; i < static_cast<int>( m_flag::MF_MAX ); ++i ) {
+            h << static_cast<int64_t>( type.has_flag( static_cast<m_flag>( i ) ) );
+        }
+        result[type.id.str()] = h.hash;
+    }
+    return result;
+}
+
+template<typename T>
+static void hash_map_data( entry_hasher &h, const T &data )
+{
+    h << data.movecost << data.light_emitted << static_cast<int64_t>( data.transparent )
+      << data.looks_like;
+    for( int i = 0; i < NUM_TERFLAGS; ++i ) {
+        h << static_cast<int64_t>( data.has_flag( static_cast<ter_bitflags>( i ) ) );
+    }
+}
+
+static digest digest_terrain()
+{
+    digest result;
+    for( size_t i = 0; i < ter_t::count(); ++i ) {
+        const ter_t &ter = ter_id( static_cast<int>( i ) ).obj();
+        entry_hasher h;
+        hash_map_data( h, ter );
+        h << ter.open << ter.close << ter.transforms_into << ter.roof;
+        result[ter.id.str()] = h.hash;
+    }
+    return result;
+}
+
+static digest digest_furniture()
+{
+    digest result;
+    for( size_t i = 0; i < furn_t::count(); ++i ) {
+        const furn_t &furn = furn_id( static_cast<int>( i ) ).obj();
+        entry_hasher h;
+        hash_map_data( h, furn );
+        h << furn.open << furn.close << furn.crafting_pseudo_item;
+        result[furn.id.str()] = h.hash;
+    }
+    return result;
+}
+
+static digest digest_recipes()
+{
+    digest result;
+    for( const auto &entry : recipe_dict ) {
+        const recipe &r = entry.second;
+        entry_hasher h;
+        h << r.result() << r.time << r.difficulty << r.skill_used << r.required_skills
+          << r.byproducts << r.requirements();
+        result[r.ident().str()] = h.hash;
+    }
+    return result;
+}
+
+static digest digest_requirements()
+{
+    digest result;
+    for( const auto &entry : requirement_data::all() ) {
+        entry_hasher h;
+        h << entry.second;
+        result[entry.first.str()] = h.hash;
+    }
+    return result;
+}
+
+std::map<std::string, digest> digest_finalized_data()
+{
+    return {
+        { "items", digest_items() },
+        { "monsters", digest_monsters() },
+        { "terrain", digest_terrain() },
+        { "furniture", digest_furniture() },
+        { "recipes", digest_recipes() },
+        { "requirements", digest_requirements() },
+    };
+}
+
+// The snapshot is only ever read by the build that wrote it, so integers are stored as
+// they are in memory.
+static void put_u64( std::ostream &out, const uint64_t value )
+{
+    out.write( reinterpret_cast<const char *>( &value ), sizeof( value ) );
+}
+
+static void put_string( std::ostream &out, const std::string &value )
+{
+    put_u64( out, value.size() );
+    out.write( value.data(), value.size() );
+}
+
+static bool get_u64( std::istream &in, uint64_t &value )
+{
+    return static_cast<bool>( in.read( reinterpret_cast<char *>( &value ), sizeof( value ) ) );
+}
+
+static bool get_string( std::istream &in, std::string &value )
+{
+    uint64_t size = 0;
+    // Ids are short, anything longer means the file is corrupt.
+    if( !get_u64( in, size ) || size > 4096 ) {
+        return false;
+    }
+    value.resize( size );
+    return size == 0 || static_cast<bool>( in.read( &value[0], size ) );
+}
+
+bool read( const std::string &path, snapshot &result )
+{
+    std::ifstream fin( path, std::ios::binary );
+    std::string magic( file_magic.size(), '\0' );
+    uint64_t version = 0;
+    uint64_t kinds = 0;
+    if( !fin.read( &magic[0], magic.size() ) || magic != file_magic || !get_u64( fin, version ) ||
+        version != file_version || !get_u64( fin, result.key ) || !get_u64( fin, kinds ) ) {
+        return false;
+    }
+    result.digests.clear();
+    for( ; kinds > 0; --kinds ) {
+        std::string kind;
+        uint64_t entries = 0;
+        if( !get_string( fin, kind ) || !get_u64( fin, entries ) ) {
+            return false;
+        }
+        digest &d = result.digests[kind];
+        for( ; entries > 0; --entries ) {
+            std::string id;
+            uint64_t hash = 0;
+            if( !get_string( fin, id ) || !get_u64( fin, hash ) ) {
+                return false;
+            }
+            d.emplace( id, hash );
+        }
+    }
+    return true;
+}
+
+bool write( const std::string &path, const snapshot &snap )
+{
+    return write_to_file( path, [&snap]( std::ostream & fout ) {
+        fout.write( file_magic.data(), file_magic.size() );
+        put_u64( fout, file_version );
+        put_u64( fout, snap.key );
+        put_u64( fout, snap.digests.size() );
+        for( const auto &kind : snap.digests ) {
+            put_string( fout, kind.first );
+            put_u64( fout, kind.second.size() );
+            for( const auto &entry : kind.second ) {
+                put_string( fout, entry.first );
+                put_u64( fout, entry.second );
+            }
+        }
+    }, nullptr );
+}
+
+int report_differences( const snapshot &stored, const snapshot &loaded )
+{
+    static constexpr int max_listed = 20;
+    int differences = 0;
+    std::ostringstream listed;
+    const auto add = [&]( const std::string &kind, const std::string &id, const char *what ) {
+        if( differences++ < max_listed ) {
+            listed << "\n" << kind << " " << id << ": " << what;
+        }
+    };
+    std::set<std::string> kinds;
+    for( const auto &kind : stored.digests ) {
+        kinds.insert( kind.first );
+    }
+    for( const auto &kind : loaded.digests ) {
+        kinds.insert( kind.first );
+    }
+    static const digest no_entries;
+    for( const std::string &kind : kinds ) {
+        const auto stored_iter = stored.digests.find( kind );
+        const auto loaded_iter = loaded.digests.find( kind );
+        const digest &before = stored_iter == stored.digests.end() ? no_entries : stored_iter->second;
+        const digest &now = loaded_iter == loaded.digests.end() ? no_entries : loaded_iter->second;
+        for( const auto &entry : before ) {
+            const auto iter = now.find( entry.first );
+            if( iter == now.end() ) {
+                add( kind, entry.first, "missing in the loaded data" );
+            } else if( iter->second != entry.second ) {
+                add( kind, entry.first, "differs" );
+            }
+        }
+        for( const auto &entry : now ) {
+            if( before.count( entry.first ) == 0 ) {
+                add( kind, entry.first, "missing in the snapshot" );
+            }
+        }
+    }
+    if( differences > 0 ) {
+        debugmsg( "The game data snapshot does not match the loaded data in %d entries:%s%s",
+                  differences, listed.str(), differences > max_listed ? "\n..." : "" );
+    }
+    return differences;
+}
+
+} // namespace data_snapshot
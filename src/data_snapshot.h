@@ -0,0 +1,67 @@
+#pragma once
+#ifndef DATA_SNAPSHOT_H
+#define DATA_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+ * Record of the game data that last passed all consistency checks, used if the
+ * DATA_SNAPSHOT option is enabled. Nothing is restored from it, the data is loaded and
+ * finalized as usual on every start.
+ *
+ * It is keyed by a hash of the build version and the content of all json files in the
+ * order they were loaded. If the stored key matches the data that has just been loaded,
+ * the consistency checks that only read the data (items, monster types, terrain and
+ * furniture, requirements) are skipped. The key is hashed while the files are parsed,
+ * so the only extra work on an unchanged start is reading the small snapshot file.
+ *
+ * The snapshot also contains a fingerprint of every item type, monster type, terrain,
+ * furniture, recipe and requirement. It only hashes some of their properties (see
+ * digest_finalized_data), not the complete entry. The fingerprints are only computed when
+ * the snapshot is written and with DATA_SNAPSHOT_VERIFY, which always runs the checks and
+ * reports entries whose fingerprint changed despite the same input. Differences in other
+ * properties go unnoticed.
+ */
+namespace data_snapshot
+{
+
+constexpr uint64_t fnv_offset_basis = 14695981039346656037ULL;
+
+/** 64 bit FNV-1a hash, pass the result of a previous call as @p hash to chain them. */
+uint64_t hash_bytes( const void *data, size_t size, uint64_t hash = fnv_offset_basis );
+
+/** Hash of one kind of data, by entry id. */
+using digest = std::map<std::string, uint64_t>;
+
+struct snapshot {
+    uint64_t key = 0;
+    /** By kind of data ("items", "monsters", ...). */
+    std::map<std::string, digest> digests;
+};
+
+/** Start of the key, depends on the build version. */
+uint64_t initial_key();
+/**
+ * Fingerprints of the currently loaded and finalized data: weight, volume, price, qualities
+ * and flags of items, stats and flags of monsters, movement cost, light, transparency, flags
+ * and transformations of terrain and furniture, and results, skills and components of
+ * recipes and requirements.
+ */
+std::map<std::string, digest> digest_finalized_data();
+
+/** Returns false if there is no (valid) snapshot at the path. */
+bool read( const std::string &path, snapshot &result );
+bool write( const std::string &path, const snapshot &snap );
+
+/**
+ * Shows a debug message listing the entries that differ between the two snapshots.
+ * @return Number of differing entries.
+ */
+int report_differences( const snapshot &stored, const snapshot &loaded );
+
+} // namespace data_snapshot
+
+#endif
@@ -81,11 +81,16 @@ static int debugClass = D_MAIN;
 extern bool test_mode;
 
 /** Set to true when any error is logged. */
-static bool error_observed = false;
+static int error_count = 0;
 
 bool debug_has_error_been_observed()
 {
-    return error_observed;
+    return error_count > 0;
+}
+
+int debug_error_count()
+{
+    return error_count;
 }
 
 bool debug_mode = false;
@@ -754,7 +759,7 @@ void debug_write_backtrace( std::ostream &out )
 std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
 {
     if( lev & D_ERROR ) {
-        error_observed = true;
+        ++error_count;
     }
 
     // If debugging has not been initialized then stop
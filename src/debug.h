@@ -181,6 +181,10 @@ void limitDebugClass( int );
  * @return true if any error has been logged in this run.
  */
 bool debug_has_error_been_observed();
+/**
+ * @return The number of errors logged in this run.
+ */
+int debug_error_count();
 
 // Debug Only                                                       {{{1
 // ---------------------------------------------------------------------
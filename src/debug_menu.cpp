@@ -15,6 +15,7 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <functional>
 #include <utility>
 #include <cstdlib>
 #include <ctime>
@@ -39,6 +40,7 @@
 #include "player.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "vitamin.h"
 #include "color.h"
@@ -55,6 +57,7 @@
 #include "translations.h"
 #include "type_id.h"
 #include "map.h"
+#include "mapbuffer.h"
 #include "veh_type.h"
 #include "weather.h"
 #include "recipe_dictionary.h"
@@ -140,7 +143,9 @@ enum debug_menu_index {
     DEBUG_DISPLAY_TEMP,
     DEBUG_DISPLAY_VISIBILITY,
     DEBUG_LEARN_SPELLS,
-    DEBUG_LEVEL_SPELLS
+    DEBUG_LEVEL_SPELLS,
+    DEBUG_TURN_PROFILE,
+    DEBUG_CONVERT_MAP_SAVES
 };
 
 class mission_debug
@@ -198,6 +203,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_DISPLAY_VISIBILITY, true, 'v', _( "Toggle display visibility" ) ) },
             { uilist_entry( DEBUG_SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILE, true, 'p', _( "Show turn profile" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -249,6 +255,7 @@ static int map_uilist()
         { uilist_entry( DEBUG_CHANGE_TIME, true, 't', _( "Change time" ) ) },
         { uilist_entry( DEBUG_OM_EDITOR, true, 'O', _( "Overmap editor" ) ) },
         { uilist_entry( DEBUG_MAP_EXTRA, true, 'm', _( "Spawn map extra" ) ) },
+        { uilist_entry( DEBUG_CONVERT_MAP_SAVES, true, 'c', _( "Convert map saves to the selected format" ) ) },
     };
 
     return uilist( _( "Map..." ), uilist_initializer );
@@ -1440,6 +1447,14 @@ void debug()
                 ui::omap::display_editor();
                 break;
 
+            case DEBUG_CONVERT_MAP_SAVES: {
+                const bool binary = get_option<bool>( "BINARY_MAP_SAVES" );
+                const int converted = MAPBUFFER.convert_saves( binary );
+                popup( _( "Converted %d map files to the %s format." ), converted,
+                       binary ? _( "binary" ) : _( "JSON" ) );
+                break;
+            }
+
             case DEBUG_BENCHMARK: {
                 const int ms = string_input_popup()
                     .title( _( "Enter benchmark length (in milliseconds):" ) )
@@ -1545,6 +1560,62 @@ void debug()
                 popup( popup_msg );
             }
                                     break;
+            case DEBUG_TURN_PROFILE: {
+#if defined(TURN_PROFILER)
+                const std::vector<turn_profiler::turn_record> turns = turn_profiler::history();
+                if( turns.empty() ) {
+                    popup( _( "No turns have been recorded yet." ) );
+                    break;
+                }
+                std::string table = string_format( _( "Last %d turns, in microseconds:\n" ),
+                                                   turns.size() );
+                table += string_format( "%-14s %9s %9s %9s\n", _( "stage" ), _( "last" ), _( "mean" ),
+                                        _( "max" ) );
+                const auto add_row = [&]( const std::string &name,
+                const std::function<long long( const turn_profiler::turn_record & )> &get ) {
+                    long long sum = 0;
+                    long long max = 0;
+                    for( const turn_profiler::turn_record &rec : turns ) {
+                        sum += get( rec );
+                        max = std::max( max, get( rec ) );
+                    }
+                    table += string_format( "%-14s %9lld %9lld %9lld\n", name, get( turns.back() ),
+                                            sum / static_cast<long long>( turns.size() ), max );
+                };
+                for( int i = 0; i < turn_profiler::num_stages; ++i ) {
+                    add_row( turn_profiler::stage_name( static_cast<turn_profiler::stage>( i ) ),
+                    [i]( const turn_profiler::turn_record & rec ) {
+                        return rec.stage_us[i];
+                    } );
+                }
+                add_row( _( "total" ), []( const turn_profiler::turn_record & rec ) {
+                    return rec.total_us;
+                } );
+                table += string_format( "\n%-14s %9s %9s %9s\n", _( "counter" ), _( "last" ), _( "mean" ),
+                                        _( "max" ) );
+                for( int i = 0; i < turn_profiler::num_counters; ++i ) {
+                    add_row( turn_profiler::counter_name( static_cast<turn_profiler::counter>( i ) ),
+                    [i]( const turn_profiler::turn_record & rec ) {
+                        return rec.counts[i];
+                    } );
+                }
+                long long los_hits = 0;
+                long long los_queries = 0;
+                for( const turn_profiler::turn_record &rec : turns ) {
+                    los_hits += rec.counts[static_cast<int>( turn_profiler::counter::los_cache_hit )];
+                    los_queries += rec.counts[static_cast<int>( turn_profiler::counter::los_cache_hit )] +
+                                   rec.counts[static_cast<int>( turn_profiler::counter::los_cache_miss )];
+                }
+                if( los_queries > 0 ) {
+                    table += string_format( _( "\nLine of sight cache hit rate: %.1f%%\n" ),
+                                            100.0 * los_hits / los_queries );
+                }
+                popup( table, PF_NONE );
+#else
+                popup( _( "This binary was not compiled with the turn profiler." ) );
+#endif
+            }
+            break;
             case DEBUG_LEARN_SPELLS:
                 if ( spell_type::get_all().empty() ) {
                     add_msg( m_bad, _( "There are no spells to learn.  You must install a mod that adds some." ) );
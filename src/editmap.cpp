@@ -1641,10 +1641,11 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
 
     // Coordinates of the overmap terrain that should be generated.
     const point omt_pos = ms_to_omt_copy( tc.abs_pos );
-    oter_id &omt_ref = overmap_buffer.ter( tripoint( omt_pos, target.z ) );
+    const tripoint omt_target( omt_pos, target.z );
+    const oter_id &omt_ref = overmap_buffer.ter( omt_target );
     // Copy to store the original value, to restore it upon canceling
     const oter_id orig_oters = omt_ref;
-    omt_ref = oter_id( gmenu.ret );
+    overmap_buffer.ter_set( omt_target, oter_id( gmenu.ret ) );
     tinymap tmpmap;
     // TODO: add a do-not-save-generated-submaps parameter
     // TODO: keep track of generated submaps to delete them properly and to avoid memory leaks
@@ -1679,7 +1680,7 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
     do {
         if( gmenu.selected != lastsel ) {
             lastsel = gmenu.selected;
-            omt_ref = oter_id( gmenu.selected );
+            overmap_buffer.ter_set( omt_target, oter_id( gmenu.selected ) );
             cleartmpmap( tmpmap );
             tmpmap.generate( omt_pos.x * 2, omt_pos.y * 2, target.z, calendar::turn );
             showpreview = true;
@@ -1773,7 +1774,7 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
     update_view( true );
     if( gpmenu.ret != 2 &&  // we didn't apply, so restore the original om_ter
         gpmenu.ret != 3 ) { // chose to change oter_id but not apply mapgen
-        omt_ref = orig_oters;
+        overmap_buffer.ter_set( omt_target, orig_oters );
     }
     gmenu.border_color = c_magenta;
     gmenu.hilight_color = h_white;
@@ -1971,9 +1972,10 @@ void editmap::cleartmpmap( tinymap &tmpmap )
         delete smap;
     }
 
+    // Also drops the vehicle bounds, which point to the vehicles just deleted.
+    tmpmap.clear_vehicle_cache( target.z );
     auto &ch = tmpmap.get_cache( target.z );
     std::memset( ch.veh_exists_at, 0, sizeof( ch.veh_exists_at ) );
-    ch.veh_cached_parts.clear();
     ch.vehicle_list.clear();
     ch.zone_vehicles.clear();
 }
@@ -5,6 +5,11 @@
 
 #include "calendar.h"
 
+// There is a field on every tile of every loaded submap, most of them empty. The list
+// must not grow beyond the 48 bytes an empty std::map takes with libstdc++ on 64 bit.
+static_assert( sizeof( field_entry ) <= 12, "two field entries must fit inline in 32 bytes" );
+static_assert( sizeof( field::field_list ) <= 48, "the field list must stay within 48 bytes" );
+
 int field_entry::move_cost() const
 {
     return type.obj().get_move_cost( intensity - 1 );
@@ -65,7 +70,9 @@ int field_entry::get_field_intensity() const
 int field_entry::set_field_intensity( int new_intensity )
 {
     is_alive = new_intensity > 0;
-    return intensity = std::max( std::min( new_intensity, get_max_field_intensity() ), 1 );
+    intensity = static_cast<int16_t>( std::max( std::min( new_intensity, get_max_field_intensity() ),
+                                      1 ) );
+    return intensity;
 
 }
 
@@ -132,7 +139,7 @@ bool field::add_field( const field_type_id field_type_to_add, const int new_inte
         it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
         return false;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    _field_type_list.emplace( field_type_to_add, field_type_to_add, new_intensity, new_age );
     return true;
 }
 
@@ -146,9 +153,9 @@ bool field::remove_field( field_type_id const field_to_remove )
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+field::field_list::iterator field::remove_field( field_list::iterator const it )
 {
-    _field_type_list.erase( it );
+    const field_list::iterator next = _field_type_list.erase( it );
     if( _field_type_list.empty() ) {
         _displayed_field_type = fd_null;
     } else {
@@ -159,6 +166,7 @@ void field::remove_field( std::map<field_type_id, field_entry>::iterator const i
             }
         }
     }
+    return next;
 }
 
 /*
@@ -170,22 +178,22 @@ unsigned int field::field_count() const
     return _field_type_list.size();
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::field_list::iterator field::begin()
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::field_list::const_iterator field::begin() const
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::field_list::iterator field::end()
 {
     return _field_type_list.end();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::field_list::const_iterator field::end() const
 {
     return _field_type_list.end();
 }
@@ -207,3 +215,15 @@ int field::total_move_cost() const
     }
     return current_cost;
 }
+
+float field::translucency() const
+{
+    float result = 1.0f;
+    for( const auto &fld : _field_type_list ) {
+        const field_entry &cur = fld.second;
+        if( !cur.is_transparent() ) {
+            result *= cur.translucency();
+        }
+    }
+    return result;
+}
@@ -2,12 +2,13 @@
 #ifndef FIELD_H
 #define FIELD_H
 
-#include <map>
+#include <cstdint>
 #include <string>
 
 #include "calendar.h"
 #include "color.h"
 #include "field_type.h"
+#include "small_slot_map.h"
 
 /**
  * An active or passive effect existing on a tile.
@@ -16,9 +17,9 @@
 class field_entry
 {
     public:
-        field_entry() : type( fd_null ), intensity( 1 ), age( 0_turns ), is_alive( false ) { }
+        field_entry() : type( fd_null ), age( 0_turns ), intensity( 1 ), is_alive( false ) { }
         field_entry( const field_type_id t, const int i, const time_duration &a ) : type( t ),
-            intensity( i ), age( a ), is_alive( true ) { }
+            age( a ), intensity( static_cast<int16_t>( i ) ), is_alive( true ) { }
 
         nc_color color() const;
 
@@ -89,10 +90,11 @@ class field_entry
     private:
         // The field identifier.
         field_type_id type;
-        // The intensity (higher is stronger), of the field entry.
-        int intensity;
         // The age, of the field effect. 0 is permanent.
         time_duration age;
+        // The intensity (higher is stronger), of the field entry. Intensities only go up to
+        // the few levels of the field type, the small type keeps two entries inline in a field.
+        int16_t intensity;
         // True if this is an active field, false if it should be destroyed next check.
         bool is_alive;
 };
@@ -108,6 +110,10 @@ class field_entry
 class field
 {
     public:
+        // Most tiles have no field at all and nearly all others at most two, those are
+        // stored without allocating, see field.cpp.
+        using field_list = cata::small_slot_map<field_type_id, field_entry, 2>;
+
         field();
 
         /**
@@ -146,8 +152,10 @@ class field
         /**
          * Make sure to decrement the field counter in the submap.
          * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * Other iterators and references to field entries stay valid.
+         * @return Iterator to the next field entry.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        field_list::iterator remove_field( field_list::iterator );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -158,21 +166,27 @@ class field
         field_type_id displayed_field_type() const;
 
         //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        field_list::iterator begin();
+        field_list::const_iterator begin() const;
 
         //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        field_list::iterator end();
+        field_list::const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
          */
         int total_move_cost() const;
 
+        /**
+         * Returns how much light passes through all fields combined, 1 if all of them are
+         * transparent (see @ref map::build_transparency_cache).
+         */
+        float translucency() const;
+
     private:
         // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        field_list _field_type_list;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
 };
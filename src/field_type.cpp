@@ -106,7 +106,6 @@ void field_type::load( JsonObject &jo, const std::string & )
     optional( jo, was_loaded, "apply_slime_factor", apply_slime_factor, 0 );
     optional( jo, was_loaded, "gas_absorption_factor", gas_absorption_factor, 0 );
     optional( jo, was_loaded, "is_splattering", is_splattering, false );
-    optional( jo, was_loaded, "dirty_transparency_cache", dirty_transparency_cache, false );
     optional( jo, was_loaded, "has_fire", has_fire, false );
     optional( jo, was_loaded, "has_acid", has_acid, false );
     optional( jo, was_loaded, "has_elec", has_elec, false );
@@ -54,7 +54,6 @@ struct field_type {
         int apply_slime_factor = 0;
         int gas_absorption_factor = 0;
         bool is_splattering = false;
-        bool dirty_transparency_cache = false;
         bool has_fire = false;
         bool has_acid = false;
         bool has_elec = false;
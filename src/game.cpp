@@ -105,6 +105,7 @@
 #include "submap.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "uistate.h"
 #include "veh_interact.h"
 #include "veh_type.h"
@@ -1340,6 +1341,44 @@ void game::calc_driving_offset( vehicle *veh )
     set_driving_view_offset( point( offset.x, offset.y ) );
 }
 
+// Reads the savefiles of the submaps ahead of the player in the background, so shifting
+// the map does not have to wait for the disk. The direction comes from the vehicle the
+// player is in, or from how the player moved since the last turn.
+static void prefetch_submaps_ahead( const map &m, const player &u )
+{
+    static tripoint last_pos = tripoint_min;
+    const tripoint abs_pos = m.getabs( u.pos() );
+    const tripoint moved = last_pos == tripoint_min ? tripoint_zero : abs_pos - last_pos;
+    last_pos = abs_pos;
+
+    point dir;
+    int lookahead = 1;
+    const vehicle *veh = u.in_vehicle ? veh_pointer_or_null( m.veh_at( u.pos() ) ) : nullptr;
+    if( veh != nullptr && veh->velocity != 0 ) {
+        const double angle = veh->face.dir() * M_PI / 180.0;
+        const int sign = veh->velocity > 0 ? 1 : -1;
+        // Diagonal if the heading is within 67.5 degrees of both axes.
+        const auto axis = []( const double d ) {
+            return d > 0.38 ? 1 : d < -0.38 ? -1 : 0;
+        };
+        dir = point( sign * axis( std::cos( angle ) ), sign * axis( std::sin( angle ) ) );
+        // 1 mph is about half a tile per turn, look ahead about 5 turns.
+        lookahead = clamp( 1 + std::abs( veh->velocity ) / 500, 1, 4 );
+    } else {
+        dir = point( sgn( moved.x ), sgn( moved.y ) );
+    }
+
+    if( dir != point_zero ) {
+        const tripoint abs_sub = m.get_abs_sub();
+        const tripoint sm_min( abs_sub.x + dir.x * lookahead, abs_sub.y + dir.y * lookahead,
+                               m.has_zlevels() ? -OVERMAP_DEPTH : abs_sub.z );
+        const tripoint sm_max( sm_min.x + MAPSIZE - 1, sm_min.y + MAPSIZE - 1,
+                               m.has_zlevels() ? OVERMAP_HEIGHT : abs_sub.z );
+        MAPBUFFER.prefetch( sm_min, sm_max );
+    }
+    MAPBUFFER.load_prefetched( 4 );
+}
+
 // MAIN GAME LOOP
 // Returns true if game is over (death, saved, quit, etc)
 bool game::do_turn()
@@ -1392,7 +1431,10 @@ bool game::do_turn()
         autosave();
     }
 
-    weather.update_weather();
+    {
+        CATA_PROFILE_STAGE( weather );
+        weather.update_weather();
+    }
     reset_light_level();
 
     perhaps_add_random_npc();
@@ -1487,39 +1529,65 @@ bool game::do_turn()
         scent.set( u.pos(), u.scent );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
+    {
+        CATA_PROFILE_STAGE( scent );
+        scent.update( u.pos(), m );
+    }
 
     // We need floor cache before checking falling 'n stuff
     m.build_floor_caches();
 
     m.process_falling();
-    m.vehmove();
+    {
+        CATA_PROFILE_STAGE( vehicles );
+        m.vehmove();
 
-    // Process power and fuel consumption for all vehicles, including off-map ones.
-    // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
-        point in_reality = m.getlocal( sm_topleft );
+        // Process power and fuel consumption for all vehicles, including off-map ones.
+        // m.vehmove used to do this, but now it only give them moves instead.
+        for( auto &elem : MAPBUFFER ) {
+            tripoint sm_loc = elem.first;
+            point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
+            point in_reality = m.getlocal( sm_topleft );
 
-        submap *sm = elem.second;
+            submap *sm = elem.second;
 
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->idle( in_bubble_z && m.inbounds( in_reality ) );
+            const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
+            for( auto &veh : sm->vehicles ) {
+                veh->idle( in_bubble_z && m.inbounds( in_reality ) );
+            }
         }
     }
-    m.process_fields();
-    m.process_active_items();
+    prefetch_submaps_ahead( m, u );
+    overmap_buffer.pregenerate_near( u.global_omt_location(),
+                                     get_option<int>( "OVERMAP_PREGENERATION" ) );
+    {
+        CATA_PROFILE_STAGE( fields );
+        m.process_fields();
+    }
+    {
+        CATA_PROFILE_STAGE( active_items );
+        m.process_active_items();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
+    {
+        CATA_PROFILE_STAGE( sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
+    {
+        CATA_PROFILE_STAGE( map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( get_levz(), true );
+    }
+    {
+        // NPC turns are timed separately, inside monmove.
+        CATA_PROFILE_STAGE( monmove );
+        monmove();
+    }
     if( calendar::once_every( 3_minutes ) ) {
+        CATA_PROFILE_STAGE( npc_planning );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
@@ -1590,6 +1658,8 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
+    CATA_PROFILE_END_TURN( calendar::turn );
+
     return false;
 }
 
@@ -4152,32 +4222,21 @@ void game::monmove()
 {
     cleanup_dead();
 
-    // Make sure these don't match the first time around.
-    tripoint cached_lev = m.get_abs_sub() + tripoint( 1, 0, 0 );
-
-    // used to force update of the monster factions if a monster has changed its z-level.
-    bool force_mfactions_update = false;
-
-    mfactions monster_factions;
-    const auto &playerfaction = mfaction_str_id( "player" );
-    for( monster &critter : all_monsters() ) {
-        // The first time through, and any time the map has been shifted, or a monster changed its z-level
-        // recalculate monster factions.
-        if( cached_lev != m.get_abs_sub() || force_mfactions_update ) {
-            force_mfactions_update = false;
-            // monster::plan() needs to know about all monsters on the same team as the monster.
-            monster_factions.clear();
-            for( monster &critter : all_monsters() ) {
-                if( critter.friendly == 0 ) {
-                    // Only 1 faction per mon at the moment.
-                    monster_factions[ critter.faction ].insert( &critter );
-                } else {
-                    monster_factions[ playerfaction ].insert( &critter );
-                }
+    if( get_option<bool>( "PARALLEL_MONSTER_PLANNING" ) ) {
+        // Most of the time monster::plan spends is walking lines of sight, which only
+        // read the map, so those are done for all monsters at once before any of them moves.
+        // The lines that are still valid when a monster plans are then looked up, the others
+        // (when something moved or the map changed) are walked again as usual.
+        std::vector<std::pair<tripoint, tripoint>> sight_lines;
+        for( const monster &critter : all_monsters() ) {
+            if( !critter.is_dead() && !critter.has_effect( effect_controlled ) ) {
+                critter.add_planning_sight_lines( sight_lines );
             }
-            cached_lev = m.get_abs_sub();
         }
+        m.precompute_sees( sight_lines );
+    }
 
+    for( monster &critter : all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
             dbg( D_ERROR ) << "game:monmove: " << critter.name()
@@ -4211,23 +4270,13 @@ void game::monmove()
             // Controlled critters don't make their own plans
             if( !critter.has_effect( effect_controlled ) ) {
                 // Formulate a path to follow
-                critter.plan( monster_factions );
+                critter.plan();
             }
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
             m.creature_in_field( critter );
         }
 
-        // FIX #28679
-        // It is possible that a monster has fallen down a z-level during critter.move() above, if it stepped on a trap.
-        // In this case the monster is deleted during the iteration of this `for` loop in
-        //  game::non_dead_range<monster>::iterator::operator++().
-        // We must make sure that we update the monster_factions so we don't pass a deleted monster later in critter.plan().
-        // Note that this only applies if z-levels are not active.
-        if( !g->m.has_zlevels() && critter.posz() != g->u.posz() ) {
-            force_mfactions_update = true;
-        }
-
         if( !critter.is_dead() &&
             u.has_active_bionic( bionic_id( "bio_alarm" ) ) &&
             u.power_level >= 25 &&
@@ -4259,6 +4308,7 @@ void game::monmove()
 
     // Now, do active NPCs.
     for( npc &guy : g->all_npcs() ) {
+        CATA_PROFILE_STAGE( npc_planning );
         int turns = 0;
         m.creature_in_field( guy );
         guy.process_turn();
@@ -2,6 +2,9 @@
 
 #include <cstddef>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <fstream>
 #include <sstream> // for throwing errors
 #include <string>
@@ -77,6 +80,10 @@
 #include "type_id.h"
 #include "construction_category.h"
 #include "overmap.h"
+#include "parallel.h"
+#include "data_snapshot.h"
+#include "options.h"
+#include "path_info.h"
 
 DynamicDataLoader::DynamicDataLoader()
 {
@@ -110,8 +117,7 @@ void DynamicDataLoader::load_deferred( deferred_json &data )
         auto it = data.begin();
         for( size_t idx = 0; idx != n; ++idx ) {
             try {
-                std::istringstream str( it->first );
-                JsonIn jsin( str );
+                JsonIn jsin( it->first.data(), it->first.size() );
                 JsonObject jo = jsin.get_object();
                 load_object( jo, it->second );
             } catch( const std::exception &err ) {
@@ -377,6 +383,60 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+// A json data file, read and indexed by the parallel stage of load_data_from_path.
+struct parsed_json_file {
+    std::string content;
+    uint64_t content_hash = 0;
+    std::unique_ptr<JsonIn> jsin;
+    // The top level objects of the file with their members indexed, in file order.
+    // Not a vector: destroying a relocated JsonObject would move the position of the JsonIn.
+    std::deque<JsonObject> objects;
+    // If false, the file could not be indexed. It is then loaded the usual way, which
+    // reports the error after loading the objects in front of it, same as before.
+    bool indexed = false;
+};
+
+// Must not touch any global state, it runs on worker threads.
+static void parse_json_file( const std::string &file, parsed_json_file &result )
+{
+    std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
+    // stuff it into ram in one go
+    if( infile.seekg( 0, std::ifstream::end ) ) {
+        const std::streamoff size = infile.tellg();
+        infile.seekg( 0 );
+        if( size > 0 ) {
+            result.content.resize( static_cast<size_t>( size ) );
+            infile.read( &result.content[0], size );
+            result.content.resize( static_cast<size_t>( infile.gcount() ) );
+        }
+    }
+    result.content_hash = data_snapshot::hash_bytes( result.content.data(), result.content.size() );
+    result.jsin.reset( new JsonIn( result.content.data(), result.content.size() ) );
+    JsonIn &jsin = *result.jsin;
+    try {
+        if( jsin.test_object() ) {
+            result.objects.emplace_back( jsin );
+            // if there's anything else in the file, it's an error.
+            jsin.eat_whitespace();
+            if( jsin.good() ) {
+                result.objects.clear();
+                return;
+            }
+        } else if( jsin.test_array() ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                result.objects.emplace_back( jsin );
+            }
+        } else {
+            return;
+        }
+    } catch( const JsonError & ) {
+        result.objects.clear();
+        return;
+    }
+    result.indexed = true;
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
@@ -397,24 +457,36 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( file + ": " + err.what() );
+    // Reading and parsing a file does not depend on any loaded data, so it is done for
+    // a batch of files in parallel. The objects are then loaded one after another in
+    // file order, so copy-from and deferred loading work exactly as before.
+    const size_t batch_size = 4 * parallel_thread_count();
+    for( size_t batch_start = 0; batch_start < files.size(); batch_start += batch_size ) {
+        const size_t batch_end = std::min( files.size(), batch_start + batch_size );
+        std::vector<parsed_json_file> parsed( batch_end - batch_start );
+        parallel_for( batch_start, batch_end, [&]( const int i ) {
+            parse_json_file( files[i], parsed[i - batch_start] );
+        } );
+        for( size_t i = batch_start; i < batch_end; ++i ) {
+            const std::string &file = files[i];
+            parsed_json_file &parsed_file = parsed[i - batch_start];
+            input_key = data_snapshot::hash_bytes( src.data(), src.size(), input_key );
+            input_key = data_snapshot::hash_bytes( file.data(), file.size(), input_key );
+            input_key = data_snapshot::hash_bytes( &parsed_file.content_hash,
+                                                   sizeof( parsed_file.content_hash ), input_key );
+            try {
+                if( parsed_file.indexed ) {
+                    for( JsonObject &jo : parsed_file.objects ) {
+                        load_object( jo, src, path, file );
+                        jo.finish();
+                    }
+                } else {
+                    parsed_file.jsin->seek( 0 );
+                    load_all_from_json( *parsed_file.jsin, src, ui, path, file );
+                }
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( file + ": " + err.what() );
+            }
         }
     }
 }
@@ -449,6 +521,7 @@ void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    input_key = data_snapshot::initial_key();
 
     harvest_list::reset();
     json_flag::reset();
@@ -590,45 +663,86 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
         ui.proceed();
     }
 
-    check_consistency( ui );
+    check_consistency_with_snapshot( ui );
     finalized = true;
 }
 
-void DynamicDataLoader::check_consistency( loading_ui &ui )
+void DynamicDataLoader::check_consistency_with_snapshot( loading_ui &ui )
+{
+    if( !get_option<bool>( "DATA_SNAPSHOT" ) ) {
+        check_consistency( ui );
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const bool verify = get_option<bool>( "DATA_SNAPSHOT_VERIFY" );
+    const std::string &path = FILENAMES["data_snapshot"];
+
+    data_snapshot::snapshot stored;
+    const bool same_input = data_snapshot::read( path, stored ) && stored.key == input_key;
+    if( same_input && !verify ) {
+        // The json files have not changed since they last passed all checks.
+        check_consistency( ui, true );
+    } else {
+        data_snapshot::snapshot loaded;
+        loaded.key = input_key;
+        loaded.digests = data_snapshot::digest_finalized_data();
+        const bool unchanged = same_input && stored.digests == loaded.digests;
+        if( same_input && !unchanged ) {
+            data_snapshot::report_differences( stored, loaded );
+        }
+        const int errors_before = debug_error_count();
+        check_consistency( ui );
+        // Only data that passed all checks may skip them next time.
+        if( !unchanged && debug_error_count() == errors_before ) {
+            data_snapshot::write( path, loaded );
+        }
+    }
+    const long long duration = std::chrono::duration_cast<std::chrono::milliseconds>
+                               ( std::chrono::steady_clock::now() - start ).count();
+    DebugLog( D_INFO, DC_ALL ) << "Consistency checks took " << duration << " ms, the game data "
+                               << ( same_input ? "hash matched" : "changed" );
+}
+
+void DynamicDataLoader::check_consistency( loading_ui &ui, const bool data_unchanged )
 {
     ui.new_context( _( "Verifying" ) );
 
+    // For checks that only read the data, they are not needed if it did not change.
+    const auto unless_unchanged = [data_unchanged]( const std::function<void()> &check ) {
+        return data_unchanged ? std::function<void()>( []() {} ) : check;
+    };
+
     using named_entry = std::pair<std::string, std::function<void()>>;
     const std::vector<named_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             {
-                _( "Crafting requirements" ), []()
+                _( "Crafting requirements" ), unless_unchanged( []()
                 {
                     requirement_data::check_consistency();
-                }
+                } )
             },
             { _( "Vitamins" ), &vitamin::check_consistency },
             { _( "Field types" ), &field_types::check_consistency },
             { _( "Emissions" ), &emit::check_consistency },
             { _( "Activities" ), &activity_type::check_consistency },
             {
-                _( "Items" ), []()
+                _( "Items" ), unless_unchanged( []()
                 {
                     item_controller->check_definitions();
-                }
+                } )
             },
             { _( "Materials" ), &materials::check },
             { _( "Engine faults" ), &fault::check_consistency },
             { _( "Vehicle parts" ), &vpart_info::check },
             { _( "Mapgen definitions" ), &check_mapgen_definitions },
             {
-                _( "Monster types" ), []()
+                _( "Monster types" ), unless_unchanged( []()
                 {
                     MonsterGenerator::generator().check_monster_definitions();
-                }
+                } )
             },
             { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions },
-            { _( "Furniture and terrain" ), &check_furniture_and_terrain },
+            { _( "Furniture and terrain" ), unless_unchanged( &check_furniture_and_terrain ) },
             { _( "Constructions" ), &check_constructions },
             { _( "Professions" ), &profession::check_definitions },
             { _( "Scenarios" ), &scenario::check_definitions },
@@ -2,6 +2,7 @@
 #ifndef INIT_H
 #define INIT_H
 
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
@@ -65,6 +66,8 @@ class DynamicDataLoader
 
     private:
         bool finalized = false;
+        /** Hash of the build version and all loaded json files, see @ref data_snapshot. */
+        uint64_t input_key = 0;
 
     protected:
         /**
@@ -108,8 +111,16 @@ class DynamicDataLoader
          * Check the consistency of all the loaded data.
          * May print a debugmsg if something seems wrong.
          * @param ui Finalization status display.
+         * @param data_unchanged The data is known to be the same as when it last passed
+         * all checks, the checks that only read the data are skipped.
          */
-        void check_consistency( loading_ui &ui );
+        void check_consistency( loading_ui &ui, bool data_unchanged = false );
+        /**
+         * Runs @ref check_consistency, skipping the checks that only read the data if
+         * the hash of the loaded json files matches the data snapshot, and updates the
+         * snapshot.
+         */
+        void check_consistency_with_snapshot( loading_ui &ui );
 
     public:
         /**
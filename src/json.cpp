@@ -694,43 +694,94 @@ void add_array_to_set( std::set<std::string> &s, JsonObject &json, const std::st
     }
 }
 
+// Reads everything from the current position of the stream to its end.
+static std::string read_remaining( std::istream &s )
+{
+    std::string result;
+    const std::istream::pos_type start = s.tellg();
+    if( start != std::istream::pos_type( -1 ) && s.seekg( 0, std::istream::end ) ) {
+        const std::istream::pos_type end = s.tellg();
+        s.seekg( start );
+        if( end != std::istream::pos_type( -1 ) && end >= start ) {
+            result.resize( static_cast<size_t>( end - start ) );
+            s.read( &result[0], result.size() );
+            result.resize( static_cast<size_t>( s.gcount() ) );
+            return result;
+        }
+    }
+    // Not seekable, read it piecewise.
+    s.clear();
+    result.assign( std::istreambuf_iterator<char>( s ), std::istreambuf_iterator<char>() );
+    return result;
+}
+
+// Returns the closing quote of the string starting at p, or the first character that
+// needs special handling (an escape sequence, a control character or the end of the input).
+static const char *find_string_end( const char *p, const char *const end )
+{
+    while( p < end && *p != '"' && *p != '\\' && static_cast<unsigned char>( *p ) >= 0x20 ) {
+        ++p;
+    }
+    return p;
+}
+
+JsonIn::JsonIn( std::istream &s ) : owned_input( read_remaining( s ) ),
+    input_begin( owned_input.data() ), input_end( input_begin + owned_input.size() ),
+    cursor( input_begin )
+{
+}
+
+JsonIn::JsonIn( const char *data, size_t size ) : input_begin( data ), input_end( data + size ),
+    cursor( data )
+{
+}
+
 int JsonIn::tell()
 {
-    return stream->tellg();
+    return cursor - input_begin;
 }
 char JsonIn::peek()
 {
-    return static_cast<char>( stream->peek() );
+    return cursor < input_end ? *cursor : static_cast<char>( EOF );
 }
 bool JsonIn::good()
 {
-    return stream->good();
+    return cursor < input_end;
 }
 
 void JsonIn::seek( int pos )
 {
-    stream->clear();
-    stream->seekg( pos );
+    cursor = input_begin + std::min<ptrdiff_t>( std::max( pos, 0 ), input_end - input_begin );
     ate_separator = false;
 }
 
 void JsonIn::eat_whitespace()
 {
-    while( is_whitespace( peek() ) ) {
-        stream->get();
+    while( cursor < input_end && is_whitespace( *cursor ) ) {
+        ++cursor;
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
-    while( tell() > 0 ) {
-        stream->seekg( -1, std::istream::cur );
-        if( !is_whitespace( peek() ) ) {
+    while( cursor > input_begin ) {
+        --cursor;
+        if( !is_whitespace( *cursor ) ) {
             break;
         }
     }
 }
 
+bool JsonIn::skip_literal( const char *literal, size_t length )
+{
+    if( static_cast<size_t>( input_end - cursor ) < length ||
+        memcmp( cursor, literal, length ) != 0 ) {
+        return false;
+    }
+    cursor += length;
+    return true;
+}
+
 void JsonIn::end_value()
 {
     ate_separator = false;
@@ -752,7 +803,7 @@ void JsonIn::skip_separator()
         if( ate_separator ) {
             error( "duplicate separator" );
         }
-        stream->get();
+        ++cursor;
         ate_separator = true;
     } else if( ch == ']' || ch == '}' || ch == ':' ) {
         // okay
@@ -779,34 +830,38 @@ void JsonIn::skip_separator()
 
 void JsonIn::skip_pair_separator()
 {
-    char ch;
     eat_whitespace();
-    stream->get( ch );
+    const char ch = peek();
     if( ch != ':' ) {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
-        error( err.str(), -1 );
+        error( err.str() );
     } else if( ate_separator ) {
-        error( "duplicate separator not strictly allowed", -1 );
+        error( "duplicate separator not strictly allowed" );
     }
+    ++cursor;
     ate_separator = true;
 }
 
 void JsonIn::skip_string()
 {
-    char ch;
     eat_whitespace();
-    stream->get( ch );
-    if( ch != '"' ) {
+    if( peek() != '"' ) {
         std::stringstream err;
-        err << "expecting string but found '" << ch << "'";
-        error( err.str(), -1 );
+        err << "expecting string but found '" << peek() << "'";
+        error( err.str() );
     }
-    while( stream->good() ) {
-        stream->get( ch );
+    ++cursor;
+    while( cursor < input_end ) {
+        cursor = find_string_end( cursor, input_end );
+        if( cursor == input_end ) {
+            break;
+        }
+        const char ch = *cursor++;
         if( ch == '\\' ) {
-            stream->get( ch );
-            continue;
+            if( cursor < input_end ) {
+                ++cursor;
+            }
         } else if( ch == '"' ) {
             break;
         } else if( ch == '\r' || ch == '\n' ) {
@@ -868,55 +923,48 @@ void JsonIn::skip_array()
 
 void JsonIn::skip_true()
 {
-    char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
-    if( strcmp( text, "true" ) != 0 ) {
+    if( !skip_literal( "true", 4 ) ) {
         std::stringstream err;
-        err << "expected \"true\", but found \"" << text << "\"";
-        error( err.str(), -4 );
+        err << "expected \"true\", but found \"" << substr( tell(), 4 ) << "\"";
+        error( err.str() );
     }
     end_value();
 }
 
 void JsonIn::skip_false()
 {
-    char text[6];
     eat_whitespace();
-    stream->get( text, 6 );
-    if( strcmp( text, "false" ) != 0 ) {
+    if( !skip_literal( "false", 5 ) ) {
         std::stringstream err;
-        err << "expected \"false\", but found \"" << text << "\"";
-        error( err.str(), -5 );
+        err << "expected \"false\", but found \"" << substr( tell(), 5 ) << "\"";
+        error( err.str() );
     }
     end_value();
 }
 
 void JsonIn::skip_null()
 {
-    char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
-    if( strcmp( text, "null" ) != 0 ) {
+    if( !skip_literal( "null", 4 ) ) {
         std::stringstream err;
-        err << "expected \"null\", but found \"" << text << "\"";
-        error( err.str(), -4 );
+        err << "expected \"null\", but found \"" << substr( tell(), 4 ) << "\"";
+        error( err.str() );
     }
     end_value();
 }
 
 void JsonIn::skip_number()
 {
-    char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while( stream->good() ) {
-        stream->get( ch );
+    while( cursor < input_end ) {
+        const char ch = *cursor;
         if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
             ch != 'e' && ch != 'E' && ch != '.' ) {
-            stream->unget();
             break;
         }
+        ++cursor;
     }
     end_value();
 }
@@ -928,40 +976,54 @@ std::string JsonIn::get_member_name()
     return s;
 }
 
+bool JsonIn::get_string_view( json_string_view &view )
+{
+    eat_whitespace();
+    if( peek() != '"' ) {
+        std::stringstream err;
+        err << "expecting string but got '" << peek() << "'";
+        error( err.str() );
+    }
+    const char *const end = find_string_end( cursor + 1, input_end );
+    if( end == input_end || *end != '"' ) {
+        return false;
+    }
+    view = json_string_view( cursor + 1, end - cursor - 1 );
+    cursor = end + 1;
+    end_value();
+    return true;
+}
+
 std::string JsonIn::get_string()
 {
-    std::string s;
-    char ch;
-    bool backslash = false;
-    char unihex[5] = "0000";
     eat_whitespace();
-    int startpos = tell();
+    const int startpos = tell();
     // the first character had better be a '"'
-    stream->get( ch );
-    if( ch != '"' ) {
+    if( peek() != '"' ) {
         std::stringstream err;
-        err << "expecting string but got '" << ch << "'";
-        error( err.str(), -1 );
+        err << "expecting string but got '" << peek() << "'";
+        error( err.str() );
     }
-    // add chars to the string, one at a time, converting:
+    ++cursor;
+    // Most strings have nothing to unescape, they are copied in one go.
+    const char *end = find_string_end( cursor, input_end );
+    std::string s( cursor, end );
+    cursor = end;
+    if( cursor < input_end && *cursor == '"' ) {
+        ++cursor;
+        end_value();
+        return s;
+    }
+    // add the rest one character at a time, converting:
     // \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-    while( stream->good() ) {
-        stream->get( ch );
+    while( cursor < input_end ) {
+        char ch = *cursor++;
         if( ch == '\\' ) {
-            if( backslash ) {
-                s += '\\';
-                backslash = false;
-            } else {
-                backslash = true;
-                continue;
+            if( cursor == input_end ) {
+                break;
             }
-        } else if( backslash ) {
-            backslash = false;
-            if( ch == '"' ) {
-                s += '"';
-            } else if( ch == '/' ) {
-                s += '/';
-            } else if( ch == 'b' ) {
+            ch = *cursor++;
+            if( ch == 'b' ) {
                 s += '\b';
             } else if( ch == 'f' ) {
                 s += '\f';
@@ -973,18 +1035,18 @@ std::string JsonIn::get_string()
                 s += '\t';
             } else if( ch == 'u' ) {
                 // get the next four characters as hexadecimal
-                stream->get( unihex, 5 );
+                const std::string unihex = substr( tell(), 4 );
+                cursor += unihex.size();
                 // insert the appropriate unicode character in utf8
                 // TODO: verify that unihex is in fact 4 hex digits.
-                char **endptr = nullptr;
-                uint32_t u = static_cast<uint32_t>( strtoul( unihex, endptr, 16 ) );
+                uint32_t u = static_cast<uint32_t>( strtoul( unihex.c_str(), nullptr, 16 ) );
                 try {
                     s += utf16_to_utf8( u );
                 } catch( const std::exception &err ) {
                     error( err.what() );
                 }
             } else {
-                // for anything else, just add the character, i suppose
+                // '"', '\\', '/' and anything else is just added, i suppose
                 s += ch;
             }
         } else if( ch == '"' ) {
@@ -996,18 +1058,15 @@ std::string JsonIn::get_string()
         } else if( static_cast<unsigned char>( ch ) < 0x20 ) {
             error( "invalid character inside string", -1 );
         } else {
+            end = find_string_end( cursor, input_end );
             s += ch;
+            s.append( cursor, end );
+            cursor = end;
         }
     }
-    // if we get to here, probably hit a premature EOF?
-    if( stream->eof() ) {
-        stream->clear();
-        seek( startpos );
-        error( "couldn't find end of string, reached EOF." );
-    } else if( stream->fail() ) {
-        throw JsonError( "stream failure while reading string." );
-    }
-    throw JsonError( "something went wrong D:" );
+    // if we get to here, we hit a premature EOF
+    seek( startpos );
+    error( "couldn't find end of string, reached EOF." );
 }
 
 int JsonIn::get_int()
@@ -1020,66 +1079,71 @@ int JsonIn::get_int()
 double JsonIn::get_float()
 {
     // this could maybe be prettier?
-    char ch;
     bool neg = false;
     int i = 0;
     int e = 0;
     int mod_e = 0;
     eat_whitespace();
-    stream->get( ch );
+    const char *p = cursor;
+    // The character at p, or '\0' at the end of the input.
+    const auto at = [this]( const char *ptr ) {
+        return ptr < input_end ? *ptr : '\0';
+    };
+    char ch = at( p );
     if( ch == '-' ) {
         neg = true;
-        stream->get( ch );
+        ch = at( ++p );
     } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
         // not a valid float
         std::stringstream err;
         err << "expecting number but found '" << ch << "'";
-        error( err.str(), -1 );
+        error( err.str() );
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
+        ch = at( ++p );
         if( ch >= '0' && ch <= '9' ) {
-            error( "leading zeros not strictly allowed", -1 );
+            cursor = p;
+            error( "leading zeros not strictly allowed" );
         }
     }
     while( ch >= '0' && ch <= '9' ) {
         i *= 10;
         i += ( ch - '0' );
-        stream->get( ch );
+        ch = at( ++p );
     }
     if( ch == '.' ) {
-        stream->get( ch );
+        ch = at( ++p );
         while( ch >= '0' && ch <= '9' ) {
             i *= 10;
             i += ( ch - '0' );
             mod_e -= 1;
-            stream->get( ch );
+            ch = at( ++p );
         }
     }
     if( neg ) {
         i *= -1;
     }
     if( ch == 'e' || ch == 'E' ) {
-        stream->get( ch );
+        ch = at( ++p );
         neg = false;
         if( ch == '-' ) {
             neg = true;
-            stream->get( ch );
+            ch = at( ++p );
         } else if( ch == '+' ) {
-            stream->get( ch );
+            ch = at( ++p );
         }
         while( ch >= '0' && ch <= '9' ) {
             e *= 10;
             e += ( ch - '0' );
-            stream->get( ch );
+            ch = at( ++p );
         }
         if( neg ) {
             e *= -1;
         }
     }
-    // unget the final non-number character (probably a separator)
-    stream->unget();
+    // p is at the final non-number character (probably a separator)
+    cursor = p;
     end_value();
     // now put it all together!
     return i * std::pow( 10.0f, e + mod_e );
@@ -1087,35 +1151,30 @@ double JsonIn::get_float()
 
 bool JsonIn::get_bool()
 {
-    char ch;
-    char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get( ch );
+    const char ch = peek();
     if( ch == 't' ) {
-        stream->get( text, 4 );
-        if( strcmp( text, "rue" ) == 0 ) {
+        if( skip_literal( "true", 4 ) ) {
             end_value();
             return true;
         } else {
             err << "not a boolean. expected \"true\", but got \"";
-            err << ch << text << "\"";
-            error( err.str(), -4 );
+            err << substr( tell(), 4 ) << "\"";
+            error( err.str() );
         }
     } else if( ch == 'f' ) {
-        stream->get( text, 5 );
-        if( strcmp( text, "alse" ) == 0 ) {
+        if( skip_literal( "false", 5 ) ) {
             end_value();
             return false;
         } else {
             err << "not a boolean. expected \"false\", but got \"";
-            err << ch << text << "\"";
-            error( err.str(), -5 );
+            err << substr( tell(), 5 ) << "\"";
+            error( err.str() );
         }
     }
     err << "not a boolean value! expected 't' or 'f' but got '" << ch << "'";
-    error( err.str(), -1 );
-    throw JsonError( "warnings are silly" );
+    error( err.str() );
 }
 
 JsonObject JsonIn::get_object()
@@ -1131,7 +1190,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if( peek() == '[' ) {
-        stream->get();
+        ++cursor;
         ate_separator = false;
         return;
     } else {
@@ -1151,7 +1210,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error( "separator not strictly allowed at end of array" );
         }
-        stream->get();
+        ++cursor;
         end_value();
         return true;
     } else {
@@ -1164,7 +1223,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if( peek() == '{' ) {
-        stream->get();
+        ++cursor;
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1184,7 +1243,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error( "separator not strictly allowed at end of object" );
         }
-        stream->get();
+        ++cursor;
         end_value();
         return true;
     } else {
@@ -1396,26 +1455,19 @@ bool JsonIn::read( JsonDeserializer &j )
 // WARNING: for occasional use only.
 std::string JsonIn::line_number( int offset_modifier )
 {
-    if( stream->eof() ) {
+    if( cursor >= input_end ) {
         return "EOF";
-    } else if( stream->fail() ) {
-        return "???";
-    } // else stream is fine
-    int pos = tell();
+    }
     int line = 1;
     int offset = 1;
-    char ch;
-    seek( 0 );
-    for( int i = 0; i < pos; ++i ) {
-        stream->get( ch );
-        if( ch == '\r' ) {
+    for( const char *p = input_begin; p < cursor; ++p ) {
+        if( *p == '\r' ) {
             offset = 1;
             ++line;
-            if( peek() == '\n' ) {
-                stream->get();
-                ++i;
+            if( p + 1 < cursor && p[1] == '\n' ) {
+                ++p;
             }
-        } else if( ch == '\n' ) {
+        } else if( *p == '\n' ) {
             offset = 1;
             ++line;
         } else {
@@ -1431,19 +1483,18 @@ void JsonIn::error( const std::string &message, int offset )
 {
     std::ostringstream err;
     err << line_number( offset ) << ": " << message;
-    // if we can't get more info from the stream don't try
-    if( !stream->good() ) {
+    // if we can't get more info from the input don't try
+    if( !good() ) {
         throw JsonError( err.str() );
     }
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg( offset, std::istream::cur );
+    seek( tell() + offset );
     size_t pos = tell();
     rewind( 3, 240 );
     size_t startpos = tell();
-    std::string buffer( pos - startpos, '\0' );
-    stream->read( &buffer[0], pos - startpos );
-    err << buffer;
+    err << substr( startpos, pos - startpos );
+    seek( pos );
     if( !is_whitespace( peek() ) ) {
         err << peek();
     }
@@ -1457,10 +1508,13 @@ void JsonIn::error( const std::string &message, int offset )
     err << "^\n";
     seek( pos );
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
+    char ch = peek();
+    if( cursor < input_end ) {
+        ++cursor;
+    }
     if( ch == '\r' ) {
         if( peek() == '\n' ) {
-            stream->get();
+            ++cursor;
         }
     } else if( ch == '\n' ) {
         // pass
@@ -1471,13 +1525,13 @@ void JsonIn::error( const std::string &message, int offset )
     }
     // print the next couple lines as well
     int line_count = 0;
-    for( int i = 0; i < 240; ++i ) {
-        stream->get( ch );
+    for( int i = 0; i < 240 && cursor < input_end; ++i ) {
+        ch = *cursor++;
         err << ch;
         if( ch == '\r' ) {
             ++line_count;
             if( peek() == '\n' ) {
-                err << stream->get();
+                err << *cursor++;
             }
         } else if( ch == '\n' ) {
             ++line_count;
@@ -1496,48 +1550,41 @@ void JsonIn::rewind( int max_lines, int max_chars )
         seek( 0 );
         return;
     }
-    if( tell() == 0 ) {
+    if( cursor == input_begin ) {
         return;
     }
     int lines_found = 0;
-    stream->seekg( -1, std::istream::cur );
+    --cursor;
     for( int i = 0; i < max_chars; ++i ) {
-        size_t tellpos = tell();
-        if( peek() == '\n' ) {
+        const char *const here = cursor;
+        if( *cursor == '\n' ) {
             ++lines_found;
-            if( tellpos > 0 ) {
-                stream->seekg( -1, std::istream::cur );
-                // note: does not update tellpos or count a character
-                if( peek() != '\r' ) {
+            if( here > input_begin ) {
+                --cursor;
+                // note: does not update here or count a character
+                if( *cursor != '\r' ) {
                     continue;
                 }
             }
-        } else if( peek() == '\r' ) {
+        } else if( *cursor == '\r' ) {
             ++lines_found;
         }
-        if( tellpos == 0 ) {
+        if( here == input_begin ) {
             break;
         } else if( lines_found == max_lines ) {
             // don't include the last \n or \r
-            stream->seekg( 1, std::istream::cur );
+            ++cursor;
             break;
         }
-        stream->seekg( -1, std::istream::cur );
+        --cursor;
     }
 }
 
 std::string JsonIn::substr( size_t pos, size_t len )
 {
-    std::string ret;
-    if( len == std::string::npos ) {
-        stream->seekg( 0, std::istream::end );
-        size_t end = tell();
-        len = end - pos;
-    }
-    ret.resize( len );
-    stream->seekg( pos );
-    stream->read( &ret[0], len );
-    return ret;
+    const size_t size = input_end - input_begin;
+    pos = std::min( pos, size );
+    return std::string( input_begin + pos, std::min( len, size - pos ) );
 }
 
 JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
@@ -88,8 +88,11 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 /* JsonIn
  * ======
  *
- * The JsonIn class provides a wrapper around a std::istream,
- * with methods for reading JSON data directly from the stream.
+ * The JsonIn class parses JSON from a contiguous block of memory,
+ * with methods for reading JSON data directly from it.
+ * It is either constructed from a std::istream, whose remaining content is
+ * read into memory in one go, or from a buffer owned by the caller
+ * (e.g. a std::string the file has been read into), which is not copied.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -111,7 +114,7 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
  *
  * If the JSON structure is not as expected,
  * verbose error messages are provided, indicating the problem,
- * and the exact line number and byte offset within the istream.
+ * and the exact line number and byte offset within the input.
  *
  *
  * Single-Pass Loading
@@ -165,18 +168,53 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
  * If an if;else if;... is missing the "else", it /will/ cause bugs,
  * so preindexing as a JsonObject is safer, as well as tidier.
  */
+/**
+ * A JSON string as it is in the input of a JsonIn, without the quotes.
+ * Only valid as long as the input of the JsonIn it has been read from.
+ */
+struct json_string_view {
+    const char *data = nullptr;
+    size_t size = 0;
+
+    json_string_view() = default;
+    json_string_view( const char *data, size_t size ) : data( data ), size( size ) {}
+
+    std::string str() const {
+        return std::string( data, size );
+    }
+    bool operator==( const std::string &rhs ) const {
+        return rhs.size() == size && rhs.compare( 0, size, data, size ) == 0;
+    }
+    bool operator!=( const std::string &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
 class JsonIn
 {
     private:
-        std::istream *stream;
+        // Only used when reading from a stream, otherwise the caller owns the input.
+        std::string owned_input;
+        const char *input_begin;
+        const char *input_end;
+        // Position of the next character to be parsed.
+        const char *cursor;
         bool ate_separator = false;
 
         void skip_separator();
         void skip_pair_separator();
         void end_value();
+        // Skips the literal if the input continues with it.
+        bool skip_literal( const char *literal, size_t length );
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
+        /** Reads the remaining content of the stream into memory and parses it from there. */
+        JsonIn( std::istream &s );
+        /**
+         * Parses the given memory in place, without copying it. It must outlive this
+         * object and all JsonObject and JsonArray instances created from it.
+         */
+        JsonIn( const char *data, size_t size );
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
 
@@ -214,6 +252,12 @@ class JsonIn
         bool get_bool(); // get the next value as a bool
         double get_float(); // get the next value as a double
         std::string get_member_name(); // also strips the ':'
+        /**
+         * Gets the next value as a string without copying or unescaping it. Only possible
+         * if it does not contain escape sequences, otherwise false is returned and nothing
+         * is consumed, so get_string() can be used instead.
+         */
+        bool get_string_view( json_string_view &view );
         JsonObject get_object();
         JsonArray get_array();
 
@@ -1,11 +1,13 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -244,10 +246,13 @@ void map::generate_lightmap( const int zlev )
 {
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
-    auto &sm = map_cache.sm;
     auto &outside_cache = map_cache.outside_cache;
+    // The sunlight cache overwrites the lightmap, keep the last one around so
+    // the light sources that did not change don't have to be cast again.
+    if( !map_cache.lightmap_dirty ) {
+        std::memcpy( map_cache.lm_prev, lm, sizeof( lm ) );
+    }
     std::memset( lm, 0, sizeof( lm ) );
-    std::memset( sm, 0, sizeof( sm ) );
 
     /* Bulk light sources wastefully cast rays into neighbors; a burning hospital can produce
          significant slowdown, so for stuff like fire and lava:
@@ -443,7 +448,34 @@ void map::generate_lightmap( const int zlev )
         }
     }
 
-    if( g->u.has_active_bionic( bionic_id( "bio_night" ) ) ) {
+    // Light sources on other z-levels end up on top of their sunlight cache, which
+    // is rebuilt each turn anyway, so they are cast right away.
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        if( z == zlev ) {
+            continue;
+        }
+        level_cache &other_cache = get_cache( z );
+        for( light_source &ls : other_cache.pending_light_sources ) {
+            if( ls.type == light_source::shape::arc ) {
+                cast_light_arc( ls );
+            } else {
+                cast_light_source( ls );
+            }
+        }
+        other_cache.pending_light_sources.clear();
+        // Its lightmap no longer matches its list of light sources.
+        other_cache.lightmap_dirty = true;
+    }
+
+    const bool night_vision = g->u.has_active_bionic( bionic_id( "bio_night" ) );
+    if( night_vision ) {
+        map_cache.lightmap_dirty = true;
+    }
+    apply_light_sources( zlev );
+
+    if( night_vision ) {
+        // Overwrites the light, so the next lightmap can't be built on top of this one.
+        map_cache.lightmap_dirty = true;
         for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
             if( rl_dist( p, g->u.pos() ) < 15 ) {
                 lm[p.x][p.y].fill( LIGHT_AMBIENT_MINIMAL );
@@ -452,6 +484,111 @@ void map::generate_lightmap( const int zlev )
     }
 }
 
+static void extend_bounds( rectangle &bounds, const point &p )
+{
+    bounds.p_min.x = std::min( bounds.p_min.x, p.x );
+    bounds.p_min.y = std::min( bounds.p_min.y, p.y );
+    bounds.p_max.x = std::max( bounds.p_max.x, p.x );
+    bounds.p_max.y = std::max( bounds.p_max.y, p.y );
+}
+
+static bool bounds_overlap( const rectangle &a, const rectangle &b )
+{
+    return a.p_min.x <= b.p_max.x && b.p_min.x <= a.p_max.x &&
+           a.p_min.y <= b.p_max.y && b.p_min.y <= a.p_max.y;
+}
+
+void map::apply_light_sources( const int zlev )
+{
+    auto &map_cache = get_cache( zlev );
+    auto &lm = map_cache.lm;
+    auto &sm = map_cache.sm;
+    auto &lm_base = map_cache.lm_base;
+    auto &transparency_cache = map_cache.transparency_cache;
+    std::vector<light_source> &sources = map_cache.pending_light_sources;
+    std::vector<light_source> &prev_sources = map_cache.light_sources;
+    std::sort( sources.begin(), sources.end() );
+
+    // At this point lm only holds sunlight and light from outside, which is the
+    // base the light sources are cast onto. If neither that nor the transparency
+    // changed, the previous lightmap only differs where light sources changed.
+    const bool incremental = !map_cache.lightmap_dirty &&
+                             std::memcmp( lm, lm_base, sizeof( lm ) ) == 0 &&
+                             std::memcmp( transparency_cache, map_cache.lm_transparency,
+                                          sizeof( transparency_cache ) ) == 0;
+    map_cache.lightmap_incremental = incremental;
+    if( !incremental ) {
+        std::memcpy( lm_base, lm, sizeof( lm ) );
+        std::memcpy( map_cache.lm_transparency, transparency_cache, sizeof( transparency_cache ) );
+        std::memset( sm, 0, sizeof( sm ) );
+        for( light_source &ls : sources ) {
+            if( ls.type == light_source::shape::arc ) {
+                cast_light_arc( ls );
+            } else {
+                cast_light_source( ls );
+            }
+        }
+        prev_sources.swap( sources );
+        sources.clear();
+        map_cache.lightmap_dirty = false;
+        return;
+    }
+
+    // Both lists are sorted, split them into removed, added and unchanged light sources.
+    // Light is only ever combined by taking the maximum, so added light sources can
+    // simply be cast on top. Regions lit by removed ones have to be reset to the base
+    // and every unchanged light source reaching into those regions has to be recast.
+    std::vector<rectangle> removed;
+    std::vector<bool> added( sources.size(), false );
+    auto prev_it = prev_sources.begin();
+    for( size_t i = 0; i < sources.size(); ++i ) {
+        light_source &ls = sources[i];
+        while( prev_it != prev_sources.end() && *prev_it < ls ) {
+            removed.push_back( prev_it->bounds );
+            ++prev_it;
+        }
+        if( prev_it != prev_sources.end() && *prev_it == ls ) {
+            ls.bounds = prev_it->bounds;
+            ++prev_it;
+        } else {
+            added[i] = true;
+        }
+    }
+    for( ; prev_it != prev_sources.end(); ++prev_it ) {
+        removed.push_back( prev_it->bounds );
+    }
+
+    std::memcpy( lm, map_cache.lm_prev, sizeof( lm ) );
+    for( const rectangle &r : removed ) {
+        const int min_y = std::max( r.p_min.y, 0 );
+        const int max_y = std::min( r.p_max.y, LIGHTMAP_CACHE_Y - 1 );
+        if( min_y > max_y ) {
+            continue;
+        }
+        for( int x = std::max( r.p_min.x, 0 ); x <= std::min( r.p_max.x, LIGHTMAP_CACHE_X - 1 ); x++ ) {
+            std::copy_n( &lm_base[x][min_y], max_y - min_y + 1, &lm[x][min_y] );
+            std::fill_n( &sm[x][min_y], max_y - min_y + 1, 0.0f );
+        }
+    }
+    for( size_t i = 0; i < sources.size(); ++i ) {
+        light_source &ls = sources[i];
+        const bool recast = added[i] || std::any_of( removed.begin(), removed.end(),
+        [&ls]( const rectangle & r ) {
+            return bounds_overlap( r, ls.bounds );
+        } );
+        if( !recast ) {
+            continue;
+        }
+        if( ls.type == light_source::shape::arc ) {
+            cast_light_arc( ls );
+        } else {
+            cast_light_source( ls );
+        }
+    }
+    prev_sources.swap( sources );
+    sources.clear();
+}
+
 void map::add_light_source( const tripoint &p, float luminance )
 {
     auto &light_source_buffer = get_cache( p.z ).light_source_buffer;
@@ -1042,6 +1179,178 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
     }
 }
 
+// Limits [lo, hi] to the values of dx for which 0 <= base + dx * step < size.
+static void clip_row( const int base, const int step, const int size, int &lo, int &hi )
+{
+    if( step == 0 ) {
+        if( base < 0 || base >= size ) {
+            hi = lo - 1;
+        }
+    } else if( step > 0 ) {
+        lo = std::max( lo, -base );
+        hi = std::min( hi, size - 1 - base );
+    } else {
+        lo = std::max( lo, base - size + 1 );
+        hi = std::min( hi, base );
+    }
+}
+
+// Same result as castLight, but instead of recursing into each new span it walks the
+// octant one row at a time, carrying the list of spans that are still open to the next
+// row. The cells a span covers in a row are first copied into contiguous buffers, and
+// their intensity and check are evaluated in one straight loop; only the span
+// bookkeeping is done cell by cell afterwards.
+// This visits the cells in a different order than castLight, so update_output must not
+// depend on the order of its calls (true for the max based updates used with floats).
+template<int xx, int xy, int yx, int yy, typename T, typename Out,
+         T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( Out &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void castLightRows( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                    const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                    const int offsetX, const int offsetY, const int offsetDistance,
+                    const T numerator = 1.0 )
+{
+    constexpr quadrant quad = quadrant_from_x_y( -xx - xy, -yx - yy );
+    // No row can have more cells inside the map than this.
+    constexpr int max_row_size = MAPSIZE_X > MAPSIZE_Y ? MAPSIZE_X : MAPSIZE_Y;
+    struct span {
+        float start;
+        float end;
+        T cumulative_transparency;
+        T last_intensity;
+    };
+    static thread_local std::vector<span> spans;
+    static thread_local std::vector<span> next_spans;
+    spans.assign( 1, span{ 1.0f, 0.0f, LIGHT_TRANSPARENCY_OPEN_AIR, 0.0 } );
+
+    // The cells of the current span in the current row.
+    std::array<T, max_row_size> transparency;
+    std::array<T, max_row_size> intensity;
+    std::array<bool, max_row_size> passes_check;
+    std::array<int, max_row_size> dists;
+
+    const float radius = 60.0f - offsetDistance;
+    static constexpr tripoint origin( 0, 0, 0 );
+    tripoint delta( 0, 0, 0 );
+    for( int distance = 1; distance <= radius && !spans.empty(); distance++ ) {
+        delta.y = -distance;
+        // The cells of this row that are inside the map.
+        int min_dx = -distance;
+        int max_dx = 0;
+        clip_row( offsetX + delta.y * xy, xx, MAPSIZE_X, min_dx, max_dx );
+        clip_row( offsetY + delta.y * yy, yx, MAPSIZE_Y, min_dx, max_dx );
+
+        next_spans.clear();
+        for( span &sp : spans ) {
+            //The distance between our first leadingEdge and start
+            const float away = sp.start - ( -distance + 0.5f ) / ( -distance - 0.5f );
+            const int first_dx = std::max( -distance + std::max( static_cast<int>( ceil( away *
+                                           ( -distance - 0.5f ) ) ), 0 ), min_dx );
+            int last_dx = first_dx;
+            while( last_dx <= max_dx && !( sp.end > ( last_dx - 0.5f ) / ( delta.y + 0.5f ) ) ) {
+                last_dx++;
+            }
+            const int num_cells = last_dx - first_dx;
+
+            const T cumulative_transparency = sp.cumulative_transparency;
+            for( int i = 0; i < num_cells; i++ ) {
+                delta.x = first_dx + i;
+                transparency[i] = input_array[offsetX + delta.x * xx + delta.y * xy]
+                                  [offsetY + delta.x * yx + delta.y * yy];
+            }
+            if( num_cells > 0 ) {
+                // The distance only grows with |delta.x| within a row, so if both ends of the
+                // span are at the same distance (always the case without trigdist), the
+                // whole span is and the intensity only has to be calculated once.
+                delta.x = first_dx;
+                const int first_dist = rl_dist( origin, delta );
+                delta.x = last_dx - 1;
+                const int last_dist = rl_dist( origin, delta );
+                if( first_dist == last_dist ) {
+                    std::fill_n( intensity.begin(), num_cells,
+                                 calc( numerator, cumulative_transparency, first_dist + offsetDistance ) );
+                } else {
+                    for( int i = 0; i < num_cells; i++ ) {
+                        delta.x = first_dx + i;
+                        dists[i] = rl_dist( origin, delta ) + offsetDistance;
+                    }
+                    for( int i = 0; i < num_cells; i++ ) {
+                        intensity[i] = calc( numerator, cumulative_transparency, dists[i] );
+                    }
+                }
+            }
+            for( int i = 0; i < num_cells; i++ ) {
+                passes_check[i] = check( transparency[i], intensity[i] );
+            }
+
+            T current_transparency = 0.0;
+            if( num_cells > 0 ) {
+                current_transparency = transparency[0];
+            }
+            float newStart = 0.0f;
+            bool span_done = false;
+            for( int i = 0; i < num_cells; i++ ) {
+                delta.x = first_dx + i;
+                T new_transparency = transparency[i];
+                sp.last_intensity = intensity[i];
+                update_output( output_cache[offsetX + delta.x * xx + delta.y * xy]
+                               [offsetY + delta.x * yx + delta.y * yy], intensity[i],
+                               passes_check[i] ? quadrant::default_ : quad );
+
+                const float leadingEdge = ( delta.x + 0.5f ) / ( delta.y - 0.5f );
+                if( new_transparency == current_transparency ) {
+                    newStart = leadingEdge;
+                    continue;
+                }
+                const float trailingEdge = ( delta.x - 0.5f ) / ( delta.y + 0.5f );
+                // Only continue the previous span if it was not opaque.
+                const bool previous_passes = check( current_transparency, sp.last_intensity );
+                if( previous_passes && !( sp.start < trailingEdge ) ) {
+                    next_spans.push_back( span{ sp.start, trailingEdge,
+                                                accumulate( cumulative_transparency, current_transparency, distance ),
+                                                0.0 } );
+                }
+                sp.start = previous_passes ? trailingEdge : newStart;
+                if( sp.start < sp.end ) {
+                    span_done = true;
+                    break;
+                }
+                current_transparency = new_transparency;
+                newStart = leadingEdge;
+            }
+            if( span_done || !check( current_transparency, sp.last_intensity ) ) {
+                continue;
+            }
+            sp.cumulative_transparency = accumulate( cumulative_transparency, current_transparency,
+                                         distance );
+            next_spans.push_back( sp );
+        }
+        spans.swap( next_spans );
+    }
+}
+
+// Casts one octant with either castLight or castLightRows, see row_shadowcasting.
+template<int xx, int xy, int yx, int yy, typename T, typename Out,
+         T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( Out &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void castLightOctant( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                      const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                      const int offsetX, const int offsetY, const int offsetDistance,
+                      const T numerator = 1.0 )
+{
+    if( row_shadowcasting && std::is_same<T, float>::value ) {
+        castLightRows<xx, xy, yx, yy, T, Out, calc, check, update_output, accumulate>(
+            output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
+    } else {
+        castLight<xx, xy, yx, yy, T, Out, calc, check, update_output, accumulate>(
+            output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
+    }
+}
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
@@ -1050,24 +1359,24 @@ void castLightAll( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                    const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
                    const int offsetX, const int offsetY, int offsetDistance, T numerator )
 {
-    castLight<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate>(
+    castLightOctant<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate>(
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
-    castLight<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate>(
+    castLightOctant<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate>(
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
 
-    castLight < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
-    castLight < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
 
-    castLight < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
-    castLight < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
 
-    castLight < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
-    castLight < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
+    castLightOctant < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
         output_cache, input_array, offsetX, offsetY, offsetDistance, numerator );
 }
 
@@ -1218,28 +1527,22 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
+// Upper bound of the distance castLight can reach with the given luminance: light_calc
+// never exceeds luminance / distance and a row is only continued while the intensity
+// stays above LIGHT_AMBIENT_LOW.
+static int light_source_radius( const float luminance )
+{
+    return std::min( 60, static_cast<int>( luminance / LIGHT_AMBIENT_LOW ) + 1 );
+}
+
 void map::apply_light_source( const tripoint &p, float luminance )
 {
     auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
     float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
 
     const int x = p.x;
     const int y = p.y;
 
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( LL_LOW ), luminance );
-        lm[x][y] = elementwise_max( lm[x][y], min_light );
-        sm[x][y] = std::max( sm[x][y], luminance );
-    }
-    if( luminance <= LL_LOW ) {
-        return;
-    } else if( luminance <= LL_BRIGHT_ONLY ) {
-        luminance = 1.49f;
-    }
-
     /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
          neighboring fires to the north and west that were applied via light_source_buffer
        If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
@@ -1256,44 +1559,90 @@ void map::apply_light_source( const tripoint &p, float luminance )
         sssSsss
            sy
     */
-    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( y != 0 && light_source_buffer[x][y - 1] < luminance );
-    bool south = ( y != peer_inbounds && light_source_buffer[x][y + 1] < luminance );
-    bool east = ( x != peer_inbounds && light_source_buffer[x + 1][y] < luminance );
-    bool west = ( x != 0 && light_source_buffer[x - 1][y] < luminance );
-
-    if( north ) {
-        castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
+    // This depends on the state of the buffer right now, so it's part of the light source.
+    int directions = 0;
+    if( luminance > LL_LOW ) {
+        const float cast_luminance = luminance <= LL_BRIGHT_ONLY ? 1.49f : luminance;
+        const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
+        if( y != 0 && light_source_buffer[x][y - 1] < cast_luminance ) {
+            directions |= light_source::dir_north;
+        }
+        if( y != peer_inbounds && light_source_buffer[x][y + 1] < cast_luminance ) {
+            directions |= light_source::dir_south;
+        }
+        if( x != peer_inbounds && light_source_buffer[x + 1][y] < cast_luminance ) {
+            directions |= light_source::dir_east;
+        }
+        if( x != 0 && light_source_buffer[x - 1][y] < cast_luminance ) {
+            directions |= light_source::dir_west;
+        }
+    }
+
+    cache.pending_light_sources.push_back( { light_source::shape::circle, p, luminance, 0, 0,
+                                             directions, rectangle()
+                                           } );
+}
+
+void map::cast_light_source( light_source &ls )
+{
+    auto &cache = get_cache( ls.p.z );
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
+    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+
+    const int x = ls.p.x;
+    const int y = ls.p.y;
+    float luminance = ls.luminance;
+
+    if( inbounds( ls.p ) ) {
+        const float min_light = std::max( static_cast<float>( LL_LOW ), luminance );
+        lm[x][y] = elementwise_max( lm[x][y], min_light );
+        sm[x][y] = std::max( sm[x][y], luminance );
+    }
+    if( luminance <= LL_LOW ) {
+        ls.bounds = rectangle( point( x, y ), point( x, y ) );
+        return;
+    } else if( luminance <= LL_BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+
+    const int radius = light_source_radius( luminance );
+    ls.bounds = rectangle( point( std::max( x - radius, 0 ), std::max( y - radius, 0 ) ),
+                           point( std::min( x + radius, LIGHTMAP_CACHE_X - 1 ),
+                                  std::min( y + radius, LIGHTMAP_CACHE_Y - 1 ) ) );
+
+    if( ls.directions & light_source::dir_north ) {
+        castLightOctant < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
+        castLightOctant < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     }
 
-    if( east ) {
-        castLight < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
+    if( ls.directions & light_source::dir_east ) {
+        castLightOctant < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     }
 
-    if( south ) {
-        castLight<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
+    if( ls.directions & light_source::dir_south ) {
+        castLightOctant<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
+        castLightOctant < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     }
 
-    if( west ) {
-        castLight<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
+    if( ls.directions & light_source::dir_west ) {
+        castLightOctant<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     }
@@ -1309,31 +1658,31 @@ void map::apply_directional_light( const tripoint &p, int direction, float lumin
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
 
     if( direction == 90 ) {
-        castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
+        castLightOctant < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     } else if( direction == 0 ) {
-        castLight < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     } else if( direction == 270 ) {
-        castLight<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
+        castLightOctant<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
+        castLightOctant < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     } else if( direction == 180 ) {
-        castLight<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, x, y, 0, luminance );
-        castLight < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
+        castLightOctant < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, x, y, 0, luminance );
     }
@@ -1345,10 +1694,24 @@ void map::apply_light_arc( const tripoint &p, int angle, float luminance, int wi
         return;
     }
 
-    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
-
     apply_light_source( p, LIGHT_SOURCE_LOCAL );
 
+    get_cache( p.z ).pending_light_sources.push_back( { light_source::shape::arc, p, luminance,
+            angle, wideangle, 0, rectangle()
+                                                      } );
+}
+
+void map::cast_light_arc( light_source &ls )
+{
+    const tripoint &p = ls.p;
+    const float luminance = ls.luminance;
+    const int angle = ls.angle;
+    const int wideangle = ls.width;
+    rectangle &bounds = ls.bounds;
+    bounds = rectangle( p.xy(), p.xy() );
+
+    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
+
     // Normalize (should work with negative values too)
     const double wangle = wideangle / 2.0;
 
@@ -1358,7 +1721,7 @@ void map::apply_light_arc( const tripoint &p, int angle, float luminance, int wi
     double rad = M_PI * static_cast<double>( nangle ) / 180;
     int range = LIGHT_RANGE( luminance );
     calc_ray_end( nangle, range, p, end );
-    apply_light_ray( lit, p, end, luminance );
+    apply_light_ray( lit, p, end, luminance, bounds );
 
     tripoint test;
     calc_ray_end( wangle + nangle, range, p, test );
@@ -1380,24 +1743,24 @@ void map::apply_light_arc( const tripoint &p, int angle, float luminance, int wi
                                           rad + orad ) );
             end.y = static_cast<int>( p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin(
                                           rad + orad ) );
-            apply_light_ray( lit, p, end, luminance );
+            apply_light_ray( lit, p, end, luminance, bounds );
 
             end.x = static_cast<int>( p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos(
                                           rad - orad ) );
             end.y = static_cast<int>( p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin(
                                           rad - orad ) );
-            apply_light_ray( lit, p, end, luminance );
+            apply_light_ray( lit, p, end, luminance, bounds );
         } else {
             calc_ray_end( nangle + ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
+            apply_light_ray( lit, p, end, luminance, bounds );
             calc_ray_end( nangle - ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
+            apply_light_ray( lit, p, end, luminance, bounds );
         }
     }
 }
 
 void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
-                           const tripoint &s, const tripoint &e, float luminance )
+                           const tripoint &s, const tripoint &e, float luminance, rectangle &bounds )
 {
     int ax = abs( e.x - s.x ) * 2;
     int ay = abs( e.y - s.y ) * 2;
@@ -1439,6 +1802,7 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
                 if( !lit[x][y] ) {
                     // Multiple rays will pass through the same squares so we need to record that
                     lit[x][y] = true;
+                    extend_bounds( bounds, point( x, y ) );
                     float lm_val = luminance / ( fastexp( transparency * distance ) * distance );
                     quadrant q = is_opaque ? quad : quadrant::default_;
                     lm[x][y][q] = std::max( lm[x][y][q], lm_val );
@@ -1471,6 +1835,7 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
                 if( !lit[x][y] ) {
                     // Multiple rays will pass through the same squares so we need to record that
                     lit[x][y] = true;
+                    extend_bounds( bounds, point( x, y ) );
                     float lm_val = luminance / ( fastexp( transparency * distance ) * distance );
                     quadrant q = is_opaque ? quad : quadrant::default_;
                     lm[x][y][q] = std::max( lm[x][y][q], lm_val );
@@ -2,6 +2,7 @@
 
 #include <climits>
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -46,6 +47,7 @@
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
+#include "parallel.h"
 #include "pathfinding.h"
 #include "projectile.h"
 #include "rng.h"
@@ -56,6 +58,7 @@
 #include "submap.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -208,6 +211,38 @@ void map::reset_vehicle_cache( const int zlev )
     }
 }
 
+// Cells of level_cache::veh_cells covered by the bounds, clamped to the map.
+static rectangle vehicle_cells( const rectangle &bounds )
+{
+    const auto cell = []( const int v ) {
+        return clamp( v / SEEX, 0, MAPSIZE - 1 );
+    };
+    return rectangle( point( cell( bounds.p_min.x ), cell( bounds.p_min.y ) ),
+                      point( cell( bounds.p_max.x ), cell( bounds.p_max.y ) ) );
+}
+
+static bool bounds_overlap( const rectangle &a, const rectangle &b )
+{
+    return a.p_min.x <= b.p_max.x && b.p_min.x <= a.p_max.x &&
+           a.p_min.y <= b.p_max.y && b.p_min.y <= a.p_max.y;
+}
+
+static void remove_vehicle_bounds( level_cache &ch, vehicle *const veh )
+{
+    const auto iter = ch.veh_bounds.find( veh );
+    if( iter == ch.veh_bounds.end() ) {
+        return;
+    }
+    const rectangle cells = vehicle_cells( iter->second );
+    for( int x = cells.p_min.x; x <= cells.p_max.x; x++ ) {
+        for( int y = cells.p_min.y; y <= cells.p_max.y; y++ ) {
+            std::vector<vehicle *> &cell = ch.veh_cells[x][y];
+            cell.erase( std::remove( cell.begin(), cell.end(), veh ), cell.end() );
+        }
+    }
+    ch.veh_bounds.erase( iter );
+}
+
 void map::add_vehicle_to_cache( vehicle *veh )
 {
     if( veh == nullptr ) {
@@ -217,6 +252,9 @@ void map::add_vehicle_to_cache( vehicle *veh )
 
     auto &ch = get_cache( veh->smz );
     ch.veh_in_active_range = true;
+    // Vehicles are sometimes added again without being removed first.
+    remove_vehicle_bounds( ch, veh );
+    cata::optional<rectangle> bounds;
     // Get parts
     std::vector<vehicle_part> &parts = veh->parts;
     int partid = 0;
@@ -231,6 +269,24 @@ void map::add_vehicle_to_cache( vehicle *veh )
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = true;
         }
+        if( !bounds ) {
+            bounds = rectangle( p.xy(), p.xy() );
+        } else {
+            bounds->p_min = point( std::min( bounds->p_min.x, p.x ),
+                                   std::min( bounds->p_min.y, p.y ) );
+            bounds->p_max = point( std::max( bounds->p_max.x, p.x ),
+                                   std::max( bounds->p_max.y, p.y ) );
+        }
+    }
+    if( !bounds ) {
+        return;
+    }
+    ch.veh_bounds[veh] = *bounds;
+    const rectangle cells = vehicle_cells( *bounds );
+    for( int x = cells.p_min.x; x <= cells.p_max.x; x++ ) {
+        for( int y = cells.p_min.y; y <= cells.p_max.y; y++ ) {
+            ch.veh_cells[x][y].push_back( veh );
+        }
     }
 }
 
@@ -243,6 +299,7 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 
     // Existing must be cleared
     auto &ch = get_cache( old_zlevel );
+    remove_vehicle_bounds( ch, veh );
     auto it = ch.veh_cached_parts.begin();
     const auto end = ch.veh_cached_parts.end();
     while( it != end ) {
@@ -273,6 +330,51 @@ void map::clear_vehicle_cache( const int zlev )
         }
         ch.veh_cached_parts.erase( part );
     }
+    ch.veh_bounds.clear();
+    for( auto &column : ch.veh_cells ) {
+        for( std::vector<vehicle *> &cell : column ) {
+            cell.clear();
+        }
+    }
+}
+
+std::vector<vehicle *> map::vehicles_near( const box &bounds, const vehicle *ignore ) const
+{
+    std::vector<vehicle *> result;
+    const rectangle area( bounds.p_min.xy(), bounds.p_max.xy() );
+    const rectangle cells = vehicle_cells( area );
+    const int zmin = std::max( bounds.p_min.z, -OVERMAP_DEPTH );
+    const int zmax = std::min( bounds.p_max.z, OVERMAP_HEIGHT );
+    for( int z = zmin; z <= zmax; z++ ) {
+        const level_cache &ch = get_cache_ref( z );
+        if( !ch.veh_in_active_range ) {
+            continue;
+        }
+        for( int x = cells.p_min.x; x <= cells.p_max.x; x++ ) {
+            for( int y = cells.p_min.y; y <= cells.p_max.y; y++ ) {
+                for( vehicle *const veh : ch.veh_cells[x][y] ) {
+                    // Vehicles spanning several cells are seen more than once.
+                    if( veh == ignore ||
+                        std::find( result.begin(), result.end(), veh ) != result.end() ||
+                        !bounds_overlap( ch.veh_bounds.at( veh ), area ) ) {
+                        continue;
+                    }
+                    result.push_back( veh );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+cata::optional<rectangle> map::vehicle_bounds( const vehicle &veh ) const
+{
+    const level_cache &ch = get_cache_ref( veh.smz );
+    const auto iter = ch.veh_bounds.find( const_cast<vehicle *>( &veh ) );
+    if( iter == ch.veh_bounds.end() ) {
+        return cata::nullopt;
+    }
+    return iter->second;
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -2143,7 +2245,7 @@ void map::drop_fields( const tripoint &p )
     }
 
     for( const auto &entry : dropped ) {
-        fld.remove_field( entry );
+        remove_field( p, entry );
     }
 }
 
@@ -2823,7 +2925,10 @@ bool map::mop_spills( const tripoint &p )
         fd_sludge
     };
     for( field_type_id fid : to_check ) {
-        retval |= fld.remove_field( fid );
+        if( fld.find_field( fid ) != nullptr ) {
+            remove_field( p, fid );
+            retval = true;
+        }
     }
 
     if( const optional_vpart_position vp = veh_at( p ) ) {
@@ -5321,7 +5426,11 @@ int map::set_field_intensity( const tripoint &p, const field_type_id type, const
     if( field_ptr != nullptr ) {
         int adj = ( isoffset ? field_ptr->get_field_intensity() : 0 ) + new_intensity;
         if( adj > 0 ) {
+            const bool was_transparent = field_ptr->is_transparent();
             field_ptr->set_field_intensity( adj );
+            if( !was_transparent || !field_ptr->is_transparent() ) {
+                set_transparency_cache_dirty( p.z );
+            }
             return adj;
         } else {
             remove_field( p, type );
@@ -5381,21 +5490,25 @@ bool map::add_field( const tripoint &p, const field_type_id type, int intensity,
     submap *const current_submap = get_submap_at( p, l );
     current_submap->is_uniform = false;
 
-    if( current_submap->fld[l.x][l.y].add_field( type, intensity, age ) ) {
+    field &fld = current_submap->fld[l.x][l.y];
+    const float old_translucency = fld.translucency();
+    if( fld.add_field( type, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( ! current_submap->field_count++ ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
+        current_submap->field_added( l );
     }
 
     if( g != nullptr && this == &g->m && p == g->u.pos() ) {
         creature_in_field( g->u ); //Hit the player with the field if it spawned on top of them.
     }
 
-    // Dirty the transparency cache now that field processing doesn't always do it
-    // TODO: Make it skip transparent fields
-    set_transparency_cache_dirty( p.z );
+    // Field processing only dirties the transparency cache for the fields it changed
+    if( fld.translucency() != old_translucency ) {
+        set_transparency_cache_dirty( p.z );
+    }
 
     if( type.obj().is_dangerous() ) {
         set_pathfinding_cache_dirty( p.z );
@@ -5424,8 +5537,9 @@ void map::remove_field( const tripoint &p, const field_type_id field_to_remove )
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
+        current_submap->field_removed( l );
         const auto &fdata = field_to_remove.obj();
-        if( fdata.is_transparent() ) {
+        if( !fdata.is_transparent() ) {
             set_transparency_cache_dirty( p.z );
         }
         if( fdata.is_dangerous() ) {
@@ -6049,6 +6163,24 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
     return sees( F, T, range, dummy );
 }
 
+// Packs the arguments of map::line_of_sight into a key for map::sees_cache, returns false if
+// they don't fit.
+static bool sees_cache_key( const tripoint &F, const tripoint &T, const int bresenham_slope,
+                            uint64_t &key )
+{
+    static_assert( MAPSIZE_X <= 256 && MAPSIZE_Y <= 256, "map coordinates must fit into 8 bits" );
+    static_assert( OVERMAP_LAYERS <= 32, "z-levels must fit into 5 bits" );
+    if( bresenham_slope < -32768 || bresenham_slope > 32767 ) {
+        return false;
+    }
+    const auto pack = []( const tripoint & p ) {
+        return static_cast<uint64_t>( p.x ) | static_cast<uint64_t>( p.y ) << 8 |
+               static_cast<uint64_t>( p.z + OVERMAP_DEPTH ) << 16;
+    };
+    key = pack( F ) | pack( T ) << 21 | static_cast<uint64_t>( bresenham_slope + 32768 ) << 42;
+    return true;
+}
+
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
@@ -6059,6 +6191,67 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
         bresenham_slope = 0;
         return false; // Out of range!
     }
+
+    uint64_t key = 0;
+    if( !inbounds( F ) || !sees_cache_key( F, T, bresenham_slope, key ) ) {
+        return line_of_sight( F, T, bresenham_slope );
+    }
+    validate_sees_cache();
+    const auto iter = sees_cache.find( key );
+    if( iter != sees_cache.end() ) {
+        CATA_PROFILE_COUNT( los_cache_hit );
+        return iter->second;
+    }
+    CATA_PROFILE_COUNT( los_cache_miss );
+    const bool visible = line_of_sight( F, T, bresenham_slope );
+    sees_cache.emplace( key, visible );
+    return visible;
+}
+
+void map::validate_sees_cache() const
+{
+    const int turn = to_turn<int>( calendar::turn );
+    if( sees_cache_dirty || sees_cache_turn != turn ) {
+        sees_cache.clear();
+        sees_cache_dirty = false;
+        sees_cache_turn = turn;
+    }
+}
+
+void map::precompute_sees( const std::vector<std::pair<tripoint, tripoint>> &lines ) const
+{
+    validate_sees_cache();
+    // Only the lines that are not known yet, each of them once.
+    std::vector<std::pair<uint64_t, size_t>> todo;
+    todo.reserve( lines.size() );
+    for( size_t i = 0; i < lines.size(); i++ ) {
+        const tripoint &F = lines[i].first;
+        const tripoint &T = lines[i].second;
+        uint64_t key = 0;
+        if( inbounds( F ) && inbounds( T ) && sees_cache_key( F, T, 0, key ) &&
+            sees_cache.count( key ) == 0 ) {
+            todo.emplace_back( key, i );
+        }
+    }
+    std::sort( todo.begin(), todo.end() );
+    todo.erase( std::unique( todo.begin(), todo.end(),
+    []( const std::pair<uint64_t, size_t> &a, const std::pair<uint64_t, size_t> &b ) {
+        return a.first == b.first;
+    } ), todo.end() );
+
+    // The workers only read the map caches, the results are stored afterwards.
+    std::vector<char> visible( todo.size() );
+    parallel_for( 0, static_cast<int>( todo.size() ), [&]( const int n ) {
+        const std::pair<tripoint, tripoint> &line = lines[todo[n].second];
+        visible[n] = line_of_sight( line.first, line.second, 0 );
+    } );
+    for( size_t n = 0; n < todo.size(); n++ ) {
+        sees_cache.emplace( todo[n].first, visible[n] != 0 );
+    }
+}
+
+bool map::line_of_sight( const tripoint &F, const tripoint &T, const int bresenham_slope ) const
+{
     bool visible = true;
 
     // Ugly `if` for now
@@ -7813,6 +8006,7 @@ bool map::build_floor_cache( const int zlev )
 
 void map::build_floor_caches()
 {
+    sees_cache_dirty = true;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
@@ -7861,15 +8055,31 @@ void map::do_vehicle_caching( int z )
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    // Vehicles and the player's tile change the transparency cache on every rebuild.
+    sees_cache_dirty = true;
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
-    bool seen_cache_dirty = false;
-    for( int z = minz; z <= maxz; z++ ) {
+    // Each z-level only touches its own cache here, so they can be built in parallel.
+    // The flags are combined afterwards so the result doesn't depend on the order.
+    std::array<bool, OVERMAP_LAYERS> level_dirty = {{}};
+    const auto build_level_caches = [this, &level_dirty]( const int z ) {
         build_outside_cache( z );
-        seen_cache_dirty |= build_transparency_cache( z );
-        seen_cache_dirty |= build_floor_cache( z );
+        const bool transparency_dirty = build_transparency_cache( z );
+        const bool floor_dirty = build_floor_cache( z );
+        level_dirty[z + OVERMAP_DEPTH] = transparency_dirty || floor_dirty;
         do_vehicle_caching( z );
+    };
+    if( minz != maxz && get_option<bool>( "PARALLEL_MAP_CACHE" ) ) {
+        parallel_for( minz, maxz + 1, build_level_caches );
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level_caches( z );
+        }
     }
+    const bool seen_cache_dirty = std::any_of( level_dirty.begin(), level_dirty.end(),
+    []( const bool dirty ) {
+        return dirty;
+    } );
 
     // The tile player is standing on should always be transparent
     const tripoint &p = g->u.pos();
@@ -8449,10 +8659,15 @@ level_cache::level_cache()
     transparency_cache_dirty = true;
     outside_cache_dirty = true;
     floor_cache_dirty = false;
+    lightmap_dirty = true;
+    lightmap_incremental = false;
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &lm_base[0][0], map_dimensions, four_zeros );
+    std::fill_n( &lm_transparency[0][0], map_dimensions, 0.0f );
+    std::fill_n( &lm_prev[0][0], map_dimensions, four_zeros );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
@@ -8565,6 +8780,11 @@ void map::update_pathfinding_cache( int zlev ) const
     }
 
     cache.dirty = false;
+    for( std::unique_ptr<pathfinding_graph> &graph : cache.graphs ) {
+        if( graph != nullptr ) {
+            graph->dirty = true;
+        }
+    }
 }
 
 void map::clip_to_bounds( tripoint &p ) const
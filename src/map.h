@@ -15,6 +15,7 @@
 #include <functional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "calendar.h"
 #include "colony.h"
@@ -28,6 +29,7 @@
 #include "units.h"
 #include "cata_utility.h"
 #include "faction.h"
+#include "optional.h"
 #include "point.h"
 
 struct furn_t;
@@ -91,6 +93,7 @@ class map;
 
 enum ter_bitflags : int;
 struct pathfinding_cache;
+struct pathfinding_graph;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
@@ -147,6 +150,44 @@ struct bash_params {
     bool bashing_from_above;
 };
 
+/**
+ * A single light source as applied to the lightmap by @ref map::generate_lightmap.
+ * The lightmap keeps the light sources of the last generation around, so the next
+ * generation only has to recast the regions of the light sources that changed.
+ */
+struct light_source {
+    enum class shape : int {
+        circle, // Cast in all directions, except those in @ref directions
+        arc,    // Cast as rays, see map::apply_light_arc
+    };
+    // Cardinal directions a circular light is cast into (bitmask)
+    enum direction : int {
+        dir_north = 1,
+        dir_east = 2,
+        dir_south = 4,
+        dir_west = 8,
+    };
+
+    shape type;
+    tripoint p;
+    float luminance;
+    int angle;
+    int width;
+    int directions;
+    // Tiles that were (possibly) touched by this light source, inclusive.
+    // Filled in when the light source is cast, not part of the comparison.
+    rectangle bounds;
+
+    bool operator==( const light_source &rhs ) const {
+        return type == rhs.type && p == rhs.p && luminance == rhs.luminance &&
+               angle == rhs.angle && width == rhs.width && directions == rhs.directions;
+    }
+    bool operator<( const light_source &rhs ) const {
+        return std::tie( p, type, luminance, angle, width, directions ) <
+               std::tie( rhs.p, rhs.type, rhs.luminance, rhs.angle, rhs.width, rhs.directions );
+    }
+};
+
 struct level_cache {
     level_cache(); // Zeros all relevant values
     level_cache( const level_cache &other ) = default;
@@ -154,12 +195,29 @@ struct level_cache {
     bool transparency_cache_dirty;
     bool outside_cache_dirty;
     bool floor_cache_dirty;
+    // If set, the lightmap is regenerated from scratch instead of incrementally.
+    bool lightmap_dirty;
+    // Whether the last lightmap was generated incrementally, only casting the light sources
+    // that changed.
+    bool lightmap_incremental;
 
     four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
     float sm[MAPSIZE_X][MAPSIZE_Y];
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Lightmap before any light source was applied (sunlight and light from outside only),
+    // and the transparency it was generated with. Used to check whether the last lightmap
+    // can be reused and to reset the regions of light sources that changed.
+    four_quadrants lm_base[MAPSIZE_X][MAPSIZE_Y];
+    float lm_transparency[MAPSIZE_X][MAPSIZE_Y];
+    // The last lightmap, generate_lightmap overwrites lm with the sunlight before the light
+    // sources are applied again.
+    four_quadrants lm_prev[MAPSIZE_X][MAPSIZE_Y];
+    // Light sources applied to the lightmap the last time it was generated, sorted.
+    std::vector<light_source> light_sources;
+    // Light sources collected during the current generate_lightmap, not yet cast.
+    std::vector<light_source> pending_light_sources;
     bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
     bool floor_cache[MAPSIZE_X][MAPSIZE_Y];
     float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -172,6 +230,11 @@ struct level_cache {
     bool veh_in_active_range;
     bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
     std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
+    // Broad phase for vehicle collisions, kept in sync with veh_cached_parts: the bounds of
+    // the cached parts of each vehicle and, for every submap sized cell of the map, the
+    // vehicles whose bounds overlap that cell. Parts outside the map count for the edge cells.
+    std::map<vehicle *, rectangle> veh_bounds;
+    std::vector<vehicle *> veh_cells[MAPSIZE][MAPSIZE];
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
 };
@@ -221,6 +284,7 @@ class map
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).transparency_cache_dirty = true;
+                sees_cache_dirty = true;
             }
         }
 
@@ -233,10 +297,17 @@ class map
         void set_floor_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).floor_cache_dirty = true;
+                sees_cache_dirty = true;
             }
         }
 
         void set_pathfinding_cache_dirty( const int zlev );
+
+        void set_lightmap_dirty( const int zlev ) {
+            if( inbounds_z( zlev ) ) {
+                get_cache( zlev ).lightmap_dirty = true;
+            }
+        }
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p ) {
@@ -252,6 +323,7 @@ class map
                 ch.floor_cache_dirty = true;
                 ch.transparency_cache_dirty = true;
                 ch.outside_cache_dirty = true;
+                sees_cache_dirty = true;
             }
         }
 
@@ -449,6 +521,12 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Walks the given lines of sight (from first to second) on several threads and
+         * remembers the results for @ref sees. This never changes what @ref sees returns,
+         * it only makes later calls for these lines cheap.
+         */
+        void precompute_sees( const std::vector<std::pair<tripoint, tripoint>> &lines ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -461,6 +539,10 @@ class map
          * Set to zero if the function returns false.
         **/
         bool sees( const tripoint &F, const tripoint &T, int range, int &bresenham_slope ) const;
+        /** Walks the line used by @ref sees, ignoring the range. Not memoized. */
+        bool line_of_sight( const tripoint &F, const tripoint &T, int bresenham_slope ) const;
+        /** Clears @ref sees_cache if it has been marked dirty or is from an earlier turn. */
+        void validate_sees_cache() const;
     public:
         /**
         * Returns coverage of target in relation to the observer. Target is loc2, observer is loc1.
@@ -535,6 +617,15 @@ class map
         void reset_vehicle_cache( int zlev );
         void clear_vehicle_cache( int zlev );
         void clear_vehicle_list( int zlev );
+        /**
+         * Vehicles other than @p ignore whose cached parts lie within bounds overlapping
+         * @p bounds (inclusive). Any vehicle part in @p bounds belongs to one of them, which
+         * makes this the broad phase of vehicle collision checks.
+         */
+        std::vector<vehicle *> vehicles_near( const box &bounds,
+                                              const vehicle *ignore = nullptr ) const;
+        /** Bounds (inclusive) of the cached parts of the vehicle, empty if it has none. */
+        cata::optional<rectangle> vehicle_bounds( const vehicle &veh ) const;
         void update_vehicle_list( submap *const to, const int zlev );
         //Returns true if vehicle zones are dirty and need to be recached
         bool check_vehicle_zones( const int zlev );
@@ -1055,7 +1146,7 @@ class map
         //Spawns byproducts from items destroyed in fire.
         void create_burnproducts( const tripoint &p, const item &fuel, const units::mass &burned_mass );
         bool process_fields(); // See fields.cpp
-        bool process_fields_in_submap( submap *const current_submap,
+        void process_fields_in_submap( submap *const current_submap,
                                        const int submap_x, const int submap_y, const int submap_z ); // See fields.cpp
         /**
          * Apply field effects to the creature when it's on a square with fields.
@@ -1577,16 +1668,22 @@ class map
                               bool low_light, bool bright_light, bool inorder ) const;
 
         int determine_wall_corner( const tripoint &p ) const;
-        // apply a circular light pattern immediately, however it's best to use...
+        // queue a circular light pattern, cast at the end of generate_lightmap, however it's best to use...
         void apply_light_source( const tripoint &p, float luminance );
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint &p, int direction, float luminance );
+        // queue a light arc, cast at the end of generate_lightmap.
         void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
         void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
-                              const tripoint &s, const tripoint &e, float luminance );
+                              const tripoint &s, const tripoint &e, float luminance, rectangle &bounds );
+        // Actually casts a queued light source into the lightmap of its z-level, sets its bounds.
+        void cast_light_source( light_source &ls );
+        void cast_light_arc( light_source &ls );
+        // Casts the queued light sources of zlev, reusing as much of the last lightmap as possible.
+        void apply_light_sources( int zlev );
         void add_light_from_items( const tripoint &p, item_stack::iterator begin,
                                    item_stack::iterator end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks );
@@ -1682,9 +1779,35 @@ class map
         }
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
+        /** Updates and returns the graph for settings of the given class, see pathfinding.cpp. */
+        const pathfinding_graph &update_pathfinding_graph( int zlev, int graph_class ) const;
+        /**
+         * Plans a long route on the submap level graph (see @ref pathfinding_graph) and
+         * refines it by routing between the submap entrances along the way.
+         * Returns an empty route if the target can't be reached at all, nothing if the
+         * regular search has to decide.
+         */
+        cata::optional<std::vector<tripoint>> route_hierarchical( const tripoint &f,
+                                           const tripoint &t, const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed ) const;
+        /** The A* search of @ref route, @p cost is set to the cost of the route found. */
+        std::vector<tripoint> route_astar( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed, int &cost ) const;
 
         visibility_variables visibility_variables_cache;
 
+        /**
+         * Results of @ref line_of_sight, keyed by the end points and the start slope.
+         * The same lines are checked over and over during a turn (monster planning,
+         * NPC threat assessment, targeting). They only depend on the transparency and
+         * floor caches, so this is cleared whenever those are marked dirty or rebuilt,
+         * and at the start of each turn.
+         */
+        mutable std::unordered_map<uint64_t, bool> sees_cache;
+        mutable bool sees_cache_dirty = false;
+        mutable int sees_cache_turn = -1;
+
     public:
         const level_cache &get_cache_ref( int zlev ) const {
             return *caches[zlev + OVERMAP_DEPTH];
@@ -123,29 +123,31 @@ int map::burn_body_part( player &u, field_entry &cur, body_part bp, const int sc
 
 bool map::process_fields()
 {
-    bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
-        bool zlev_dirty = false;
         auto &field_cache = get_cache( z ).field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 if( field_cache[ x + y * MAPSIZE ] ) {
                     submap *const current_submap = get_submap_at_grid( { x, y, z } );
-                    const bool cur_dirty = process_fields_in_submap( current_submap, x, y, z );
-                    zlev_dirty |= cur_dirty;
+                    process_fields_in_submap( current_submap, x, y, z );
                 }
             }
         }
+    }
 
+    // Fields spread to and modify fields on other submaps (and z-levels), so whether their
+    // translucency changed is only known once all of them have been processed.
+    bool dirty_transparency_cache = false;
+    for( int z = minz; z <= maxz; z++ ) {
+        bool zlev_dirty = false;
+        for( int x = 0; x < my_MAPSIZE; x++ ) {
+            for( int y = 0; y < my_MAPSIZE; y++ ) {
+                zlev_dirty |= get_submap_at_grid( { x, y, z } )->update_field_translucency();
+            }
+        }
         if( zlev_dirty ) {
-            // For now, just always dirty the transparency cache
-            // when a field might possibly be changed.
-            // TODO: check if there are any fields(mostly fire)
-            //       that frequently change, if so set the dirty
-            //       flag, otherwise only set the dirty flag if
-            //       something actually changed
             set_transparency_cache_dirty( z );
             dirty_transparency_cache = true;
         }
@@ -361,15 +363,11 @@ Iterates over every field on every tile of the given submap given as parameter.
 This is the general update function for field effects. This should only be called once per game turn.
 If you need to insert a new field behavior per unit time add a case statement in the switch below.
 */
-bool map::process_fields_in_submap( submap *const current_submap,
+void map::process_fields_in_submap( submap *const current_submap,
                                     const int submap_x, const int submap_y, const int submap_z )
 {
     scent_block sblk( submap_x, submap_y, submap_z, g->scent );
 
-    // This should be true only when the field changes transparency
-    // More correctly: not just when the field is opaque, but when it changes state
-    // to a more/less transparent one, or creates a non-transparent field nearby
-    bool dirty_transparency_cache = false;
     // Holds m.field_at(x,y).find_field(fd_some_field) type returns.
     // Just to avoid typing that long string for a temp value.
     field_entry *tmpfld = nullptr;
@@ -381,941 +379,936 @@ bool map::process_fields_in_submap( submap *const current_submap,
     maptile map_tile( current_submap, 0, 0 );
     size_t &locx = map_tile.x;
     size_t &locy = map_tile.y;
-    // Loop through all tiles in this submap indicated by current_submap
-    for( locx = 0; locx < SEEX; locx++ ) {
-        for( locy = 0; locy < SEEY; locy++ ) {
-            // This is a translation from local coordinates to submap coordinates.
-            // All submaps are in one long 1d array.
-            thep.x = locx + submap_x * SEEX;
-            thep.y = locy + submap_y * SEEY;
-            // A const reference to the tripoint above, so that the code below doesn't accidentally change it
-            const tripoint &p = thep;
-            // Get a reference to the field variable from the submap;
-            // contains all the pointers to the real field effects.
-            field &curfield = current_submap->fld[locx][locy];
-            for( auto it = curfield.begin(); it != curfield.end(); ) {
-                // Iterating through all field effects in the submap's field.
-                field_entry &cur = it->second;
-                // The field might have been killed by processing a neighbor field
-                if( !cur.is_field_alive() ) {
-                    if( !cur.get_field_type().obj().get_transparent( cur.get_field_intensity() - 1 ) ) {
-                        dirty_transparency_cache = true;
-                    }
-                    --current_submap->field_count;
-                    curfield.remove_field( it++ );
-                    continue;
-                }
+    // Loop through all tiles in this submap indicated by current_submap that have fields,
+    // this includes tiles that got fields from processing the tiles before them.
+    for( int index = current_submap->next_field_tile( -1 ); index >= 0;
+         index = current_submap->next_field_tile( index ) ) {
+        const point l = submap::field_tile_point( index );
+        locx = l.x;
+        locy = l.y;
+        // This is a translation from local coordinates to submap coordinates.
+        // All submaps are in one long 1d array.
+        thep.x = locx + submap_x * SEEX;
+        thep.y = locy + submap_y * SEEY;
+        // A const reference to the tripoint above, so that the code below doesn't accidentally change it
+        const tripoint &p = thep;
+        // Get a reference to the field variable from the submap;
+        // contains all the pointers to the real field effects.
+        field &curfield = current_submap->fld[locx][locy];
+        for( auto it = curfield.begin(); it != curfield.end(); ) {
+            // Iterating through all field effects in the submap's field.
+            field_entry &cur = it->second;
+            // The field might have been killed by processing a neighbor field
+            if( !cur.is_field_alive() ) {
+                --current_submap->field_count;
+                curfield.remove_field( it++ );
+                current_submap->field_removed( map_tile.pos() );
+                continue;
+            }
 
-                // Holds cur.get_field_type() as that is what the old system used before rewrite.
-                field_type_id curtype = cur.get_field_type();
-                // Again, legacy support in the event someone Mods set_field_intensity to allow more values.
-                if( cur.get_field_intensity() > 3 || cur.get_field_intensity() < 1 ) {
-                    debugmsg( "Whoooooa intensity of %d", cur.get_field_intensity() );
-                }
+            // Holds cur.get_field_type() as that is what the old system used before rewrite.
+            field_type_id curtype = cur.get_field_type();
+            // Again, legacy support in the event someone Mods set_field_intensity to allow more values.
+            if( cur.get_field_intensity() > 3 || cur.get_field_intensity() < 1 ) {
+                debugmsg( "Whoooooa intensity of %d", cur.get_field_intensity() );
+            }
 
-                dirty_transparency_cache = curtype.obj().dirty_transparency_cache;
+            // Don't process "newborn" fields. This gives the player time to run if they need to.
+            if( cur.get_field_age() == 0_turns ) {
+                curtype = fd_null;
+            }
 
-                // Don't process "newborn" fields. This gives the player time to run if they need to.
-                if( cur.get_field_age() == 0_turns ) {
-                    curtype = fd_null;
-                }
+            int part;
+            const ter_t &ter = map_tile.get_ter_t();
+            // Dissipate faster in water
+            if( ter.has_flag( TFLAG_SWIMMABLE ) ) {
+                cur.mod_field_age( cur.get_underwater_age_speedup() );
+            }
+            if( curtype == fd_acid ) {
+                // Try to fall by a z-level
+                if( zlevels && p.z > -OVERMAP_DEPTH ) {
+                    tripoint dst{ p.x, p.y, p.z - 1 };
+                    if( valid_move( p, dst, true, true ) ) {
+                        maptile dst_tile = maptile_at_internal( dst );
+                        field_entry *acid_there = dst_tile.find_field( fd_acid );
+                        if( acid_there == nullptr ) {
+                            dst_tile.add_field( fd_acid, cur.get_field_intensity(), cur.get_field_age() );
+                        } else {
+                            // Math can be a bit off,
+                            // but "boiling" falling acid can be allowed to be stronger
+                            // than acid that just lies there
+                            const int sum_intensity = cur.get_field_intensity() + acid_there->get_field_intensity();
+                            const int new_intensity = std::min( 3, sum_intensity );
+                            // No way to get precise elapsed time, let's always reset
+                            // Allow falling acid to last longer than regular acid to show it off
+                            const time_duration new_age = -1_minutes * ( sum_intensity - new_intensity );
+                            acid_there->set_field_intensity( new_intensity );
+                            acid_there->set_field_age( new_age );
+                        }
 
-                int part;
-                const ter_t &ter = map_tile.get_ter_t();
-                // Dissipate faster in water
-                if( ter.has_flag( TFLAG_SWIMMABLE ) ) {
-                    cur.mod_field_age( cur.get_underwater_age_speedup() );
+                        // Set ourselves up for removal
+                        cur.set_field_intensity( 0 );
+                    }
                 }
-                if( curtype == fd_acid ) {
-                    // Try to fall by a z-level
-                    if( zlevels && p.z > -OVERMAP_DEPTH ) {
-                        tripoint dst{ p.x, p.y, p.z - 1 };
-                        if( valid_move( p, dst, true, true ) ) {
-                            maptile dst_tile = maptile_at_internal( dst );
-                            field_entry *acid_there = dst_tile.find_field( fd_acid );
-                            if( acid_there == nullptr ) {
-                                dst_tile.add_field( fd_acid, cur.get_field_intensity(), cur.get_field_age() );
-                            } else {
-                                // Math can be a bit off,
-                                // but "boiling" falling acid can be allowed to be stronger
-                                // than acid that just lies there
-                                const int sum_intensity = cur.get_field_intensity() + acid_there->get_field_intensity();
-                                const int new_intensity = std::min( 3, sum_intensity );
-                                // No way to get precise elapsed time, let's always reset
-                                // Allow falling acid to last longer than regular acid to show it off
-                                const time_duration new_age = -1_minutes * ( sum_intensity - new_intensity );
-                                acid_there->set_field_intensity( new_intensity );
-                                acid_there->set_field_age( new_age );
+                // TODO: Allow spreading to the sides if age < 0 && intensity == 3
+            }
+            if( curtype.obj().apply_slime_factor > 0 ) {
+                sblk.apply_slime( p, cur.get_field_intensity() * curtype.obj().apply_slime_factor );
+            }
+            if( curtype == fd_fire ) {
+                // Entire objects for ter/frn for flags
+                const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
+                bool sheltered = g->is_sheltered( p );
+                int winddirection = g->weather.winddirection;
+                int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p, winddirection,
+                                                     sheltered );
+                const ter_t &ter = map_tile.get_ter_t();
+                const furn_t &frn = map_tile.get_furn_t();
+
+                // We've got ter/furn cached, so let's use that
+                const bool is_sealed = ter_furn_has_flag( ter, frn, TFLAG_SEALED ) &&
+                                       !ter_furn_has_flag( ter, frn, TFLAG_ALLOW_FIELD_EFFECT );
+                // Smoke generation probability, consumed items count
+                int smoke = 0;
+                int consumed = 0;
+                // How much time to add to the fire's life due to burned items/terrain/furniture
+                time_duration time_added = 0_turns;
+                // Checks if the fire can spread
+                const bool can_spread = !ter_furn_has_flag( ter, frn, TFLAG_FIRE_CONTAINER );
+                // If the flames are in furniture with fire_container flag like brazier or oven,
+                // they're fully contained, so skip consuming terrain
+                const bool can_burn = ( ter.is_flammable() || frn.is_flammable() ) &&
+                                      !ter_furn_has_flag( ter, frn, TFLAG_FIRE_CONTAINER );
+                // The huge indent below should probably be somehow moved away from here
+                // without forcing the function to use i_at( p ) for fires without items
+                if( !is_sealed && map_tile.get_item_count() > 0 ) {
+                    map_stack items_here = i_at( p );
+                    std::vector<item> new_content;
+                    for( auto explosive = items_here.begin(); explosive != items_here.end(); ) {
+                        if( explosive->will_explode_in_fire() ) {
+                            // We need to make a copy because the iterator validity is not predictable
+                            item copy = *explosive;
+                            explosive = items_here.erase( explosive );
+                            if( copy.detonate( p, new_content ) ) {
+                                // Need to restart, iterators may not be valid
+                                explosive = items_here.begin();
                             }
+                        } else {
+                            ++explosive;
+                        }
+                    }
 
-                            // Set ourselves up for removal
-                            cur.set_field_intensity( 0 );
+                    fire_data frd( cur.get_field_intensity(), !can_spread );
+                    // The highest # of items this fire can remove in one turn
+                    int max_consume = cur.get_field_intensity() * 2;
+
+                    for( auto fuel = items_here.begin(); fuel != items_here.end() && consumed < max_consume; ) {
+                        // `item::burn` modifies the charges in order to simulate some of them getting
+                        // destroyed by the fire, this changes the item weight, but may not actually
+                        // destroy it. We need to spawn products anyway.
+                        const units::mass old_weight = fuel->weight( false );
+                        bool destroyed = fuel->burn( frd );
+                        // If the item is considered destroyed, it may have negative charge count,
+                        // see `item::burn?. This in turn means `item::weight` returns a negative value,
+                        // which we can not use, so only call `weight` when it's still an existing item.
+                        const units::mass new_weight = destroyed ? 0_gram : fuel->weight( false );
+                        if( old_weight != new_weight ) {
+                            create_burnproducts( p, *fuel, old_weight - new_weight );
+                        }
+
+                        if( destroyed ) {
+                            // If we decided the item was destroyed by fire, remove it.
+                            // But remember its contents, except for irremovable mods, if any
+                            std::copy( fuel->contents.begin(), fuel->contents.end(),
+                                       std::back_inserter( new_content ) );
+                            new_content.erase( std::remove_if( new_content.begin(), new_content.end(), [&]( const item & i ) {
+                                return i.is_irremovable();
+                            } ), new_content.end() );
+                            fuel = items_here.erase( fuel );
+                            consumed++;
+                        } else {
+                            ++fuel;
                         }
                     }
-                    // TODO: Allow spreading to the sides if age < 0 && intensity == 3
+
+                    spawn_items( p, new_content );
+                    smoke = roll_remainder( frd.smoke_produced );
+                    time_added = 1_turns * roll_remainder( frd.fuel_produced );
                 }
-                if( curtype.obj().apply_slime_factor > 0 ) {
-                    sblk.apply_slime( p, cur.get_field_intensity() * curtype.obj().apply_slime_factor );
+
+                // Get the part of the vehicle in the fire (_internal skips the boundary check)
+                vehicle *veh = veh_at_internal( p, part );
+                if( veh != nullptr ) {
+                    veh->damage( part, cur.get_field_intensity() * 10, DT_HEAT, true );
+                    // Damage the vehicle in the fire.
                 }
-                if( curtype == fd_fire ) {
-                    // Entire objects for ter/frn for flags
-                    const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
-                    bool sheltered = g->is_sheltered( p );
-                    int winddirection = g->weather.winddirection;
-                    int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p, winddirection,
-                                                         sheltered );
-                    const ter_t &ter = map_tile.get_ter_t();
-                    const furn_t &frn = map_tile.get_furn_t();
-
-                    // We've got ter/furn cached, so let's use that
-                    const bool is_sealed = ter_furn_has_flag( ter, frn, TFLAG_SEALED ) &&
-                                           !ter_furn_has_flag( ter, frn, TFLAG_ALLOW_FIELD_EFFECT );
-                    // Smoke generation probability, consumed items count
-                    int smoke = 0;
-                    int consumed = 0;
-                    // How much time to add to the fire's life due to burned items/terrain/furniture
-                    time_duration time_added = 0_turns;
-                    // Checks if the fire can spread
-                    const bool can_spread = !ter_furn_has_flag( ter, frn, TFLAG_FIRE_CONTAINER );
-                    // If the flames are in furniture with fire_container flag like brazier or oven,
-                    // they're fully contained, so skip consuming terrain
-                    const bool can_burn = ( ter.is_flammable() || frn.is_flammable() ) &&
-                                          !ter_furn_has_flag( ter, frn, TFLAG_FIRE_CONTAINER );
-                    // The huge indent below should probably be somehow moved away from here
-                    // without forcing the function to use i_at( p ) for fires without items
-                    if( !is_sealed && map_tile.get_item_count() > 0 ) {
-                        map_stack items_here = i_at( p );
-                        std::vector<item> new_content;
-                        for( auto explosive = items_here.begin(); explosive != items_here.end(); ) {
-                            if( explosive->will_explode_in_fire() ) {
-                                // We need to make a copy because the iterator validity is not predictable
-                                item copy = *explosive;
-                                explosive = items_here.erase( explosive );
-                                if( copy.detonate( p, new_content ) ) {
-                                    // Need to restart, iterators may not be valid
-                                    explosive = items_here.begin();
-                                }
-                            } else {
-                                ++explosive;
-                            }
+                if( can_burn ) {
+                    if( ter.has_flag( TFLAG_SWIMMABLE ) ) {
+                        // Flames die quickly on water
+                        cur.set_field_age( cur.get_field_age() + 4_minutes );
+                    }
+
+                    // Consume the terrain we're on
+                    if( ter_furn_has_flag( ter, frn, TFLAG_FLAMMABLE ) ) {
+                        // The fire feeds on the ground itself until max intensity.
+                        time_added += 1_turns * ( 5 - cur.get_field_intensity() );
+                        smoke += 2;
+                        smoke += static_cast<int>( windpower / 5 );
+                        if( cur.get_field_intensity() > 1 &&
+                            one_in( 200 - cur.get_field_intensity() * 50 ) ) {
+                            destroy( p, false );
                         }
 
-                        fire_data frd( cur.get_field_intensity(), !can_spread );
-                        // The highest # of items this fire can remove in one turn
-                        int max_consume = cur.get_field_intensity() * 2;
-
-                        for( auto fuel = items_here.begin(); fuel != items_here.end() && consumed < max_consume; ) {
-                            // `item::burn` modifies the charges in order to simulate some of them getting
-                            // destroyed by the fire, this changes the item weight, but may not actually
-                            // destroy it. We need to spawn products anyway.
-                            const units::mass old_weight = fuel->weight( false );
-                            bool destroyed = fuel->burn( frd );
-                            // If the item is considered destroyed, it may have negative charge count,
-                            // see `item::burn?. This in turn means `item::weight` returns a negative value,
-                            // which we can not use, so only call `weight` when it's still an existing item.
-                            const units::mass new_weight = destroyed ? 0_gram : fuel->weight( false );
-                            if( old_weight != new_weight ) {
-                                create_burnproducts( p, *fuel, old_weight - new_weight );
-                            }
+                    } else if( ter_furn_has_flag( ter, frn, TFLAG_FLAMMABLE_HARD ) &&
+                               one_in( 3 ) ) {
+                        // The fire feeds on the ground itself until max intensity.
+                        time_added += 1_turns * ( 4 - cur.get_field_intensity() );
+                        smoke += 2;
+                        smoke += static_cast<int>( windpower / 5 );
+                        if( cur.get_field_intensity() > 1 &&
+                            one_in( 200 - cur.get_field_intensity() * 50 ) ) {
+                            destroy( p, false );
+                        }
 
-                            if( destroyed ) {
-                                // If we decided the item was destroyed by fire, remove it.
-                                // But remember its contents, except for irremovable mods, if any
-                                std::copy( fuel->contents.begin(), fuel->contents.end(),
-                                           std::back_inserter( new_content ) );
-                                new_content.erase( std::remove_if( new_content.begin(), new_content.end(), [&]( const item & i ) {
-                                    return i.is_irremovable();
-                                } ), new_content.end() );
-                                fuel = items_here.erase( fuel );
-                                consumed++;
+                    } else if( ter.has_flag( TFLAG_FLAMMABLE_ASH ) ) {
+                        // The fire feeds on the ground itself until max intensity.
+                        time_added += 1_turns * ( 5 - cur.get_field_intensity() );
+                        smoke += 2;
+                        smoke += static_cast<int>( windpower / 5 );
+                        if( cur.get_field_intensity() > 1 &&
+                            one_in( 200 - cur.get_field_intensity() * 50 ) ) {
+                            if( p.z > 0 ) {
+                                // We're in the air
+                                ter_set( p, t_open_air );
                             } else {
-                                ++fuel;
+                                ter_set( p, t_dirt );
                             }
                         }
 
-                        spawn_items( p, new_content );
-                        smoke = roll_remainder( frd.smoke_produced );
-                        time_added = 1_turns * roll_remainder( frd.fuel_produced );
-                    }
-
-                    // Get the part of the vehicle in the fire (_internal skips the boundary check)
-                    vehicle *veh = veh_at_internal( p, part );
-                    if( veh != nullptr ) {
-                        veh->damage( part, cur.get_field_intensity() * 10, DT_HEAT, true );
-                        // Damage the vehicle in the fire.
-                    }
-                    if( can_burn ) {
-                        if( ter.has_flag( TFLAG_SWIMMABLE ) ) {
-                            // Flames die quickly on water
-                            cur.set_field_age( cur.get_field_age() + 4_minutes );
+                    } else if( frn.has_flag( TFLAG_FLAMMABLE_ASH ) ) {
+                        // The fire feeds on the ground itself until max intensity.
+                        time_added += 1_turns * ( 5 - cur.get_field_intensity() );
+                        smoke += 2;
+                        smoke += static_cast<int>( windpower / 5 );
+                        if( cur.get_field_intensity() > 1 &&
+                            one_in( 200 - cur.get_field_intensity() * 50 ) ) {
+                            furn_set( p, f_ash );
+                            add_item_or_charges( p, item( "ash" ) );
                         }
 
-                        // Consume the terrain we're on
-                        if( ter_furn_has_flag( ter, frn, TFLAG_FLAMMABLE ) ) {
-                            // The fire feeds on the ground itself until max intensity.
-                            time_added += 1_turns * ( 5 - cur.get_field_intensity() );
-                            smoke += 2;
-                            smoke += static_cast<int>( windpower / 5 );
-                            if( cur.get_field_intensity() > 1 &&
-                                one_in( 200 - cur.get_field_intensity() * 50 ) ) {
-                                destroy( p, false );
-                            }
-
-                        } else if( ter_furn_has_flag( ter, frn, TFLAG_FLAMMABLE_HARD ) &&
-                                   one_in( 3 ) ) {
-                            // The fire feeds on the ground itself until max intensity.
-                            time_added += 1_turns * ( 4 - cur.get_field_intensity() );
-                            smoke += 2;
-                            smoke += static_cast<int>( windpower / 5 );
-                            if( cur.get_field_intensity() > 1 &&
-                                one_in( 200 - cur.get_field_intensity() * 50 ) ) {
-                                destroy( p, false );
-                            }
-
-                        } else if( ter.has_flag( TFLAG_FLAMMABLE_ASH ) ) {
-                            // The fire feeds on the ground itself until max intensity.
-                            time_added += 1_turns * ( 5 - cur.get_field_intensity() );
-                            smoke += 2;
-                            smoke += static_cast<int>( windpower / 5 );
-                            if( cur.get_field_intensity() > 1 &&
-                                one_in( 200 - cur.get_field_intensity() * 50 ) ) {
-                                if( p.z > 0 ) {
-                                    // We're in the air
-                                    ter_set( p, t_open_air );
-                                } else {
-                                    ter_set( p, t_dirt );
+                    } else if( ter.has_flag( TFLAG_NO_FLOOR ) && zlevels && p.z > -OVERMAP_DEPTH ) {
+                        // We're hanging in the air - let's fall down
+                        tripoint dst{ p.x, p.y, p.z - 1 };
+                        if( valid_move( p, dst, true, true ) ) {
+                            maptile dst_tile = maptile_at_internal( dst );
+                            field_entry *fire_there = dst_tile.find_field( fd_fire );
+                            if( fire_there == nullptr ) {
+                                dst_tile.add_field( fd_fire, 1, 0_turns );
+                                cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                            } else {
+                                // Don't fuel raging fires or they'll burn forever
+                                // as they can produce small fires above themselves
+                                int new_intensity = std::max( cur.get_field_intensity(),
+                                                              fire_there->get_field_intensity() );
+                                // Allow smaller fires to combine
+                                if( new_intensity < 3 &&
+                                    cur.get_field_intensity() == fire_there->get_field_intensity() ) {
+                                    new_intensity++;
                                 }
-                            }
-
-                        } else if( frn.has_flag( TFLAG_FLAMMABLE_ASH ) ) {
-                            // The fire feeds on the ground itself until max intensity.
-                            time_added += 1_turns * ( 5 - cur.get_field_intensity() );
-                            smoke += 2;
-                            smoke += static_cast<int>( windpower / 5 );
-                            if( cur.get_field_intensity() > 1 &&
-                                one_in( 200 - cur.get_field_intensity() * 50 ) ) {
-                                furn_set( p, f_ash );
-                                add_item_or_charges( p, item( "ash" ) );
-                            }
-
-                        } else if( ter.has_flag( TFLAG_NO_FLOOR ) && zlevels && p.z > -OVERMAP_DEPTH ) {
-                            // We're hanging in the air - let's fall down
-                            tripoint dst{ p.x, p.y, p.z - 1 };
-                            if( valid_move( p, dst, true, true ) ) {
-                                maptile dst_tile = maptile_at_internal( dst );
-                                field_entry *fire_there = dst_tile.find_field( fd_fire );
-                                if( fire_there == nullptr ) {
-                                    dst_tile.add_field( fd_fire, 1, 0_turns );
+                                fire_there->set_field_intensity( new_intensity );
+                                // A raging fire below us can support us for a while
+                                // Otherwise decay and decay fast
+                                if( new_intensity < 3 || one_in( 10 ) ) {
                                     cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                                } else {
-                                    // Don't fuel raging fires or they'll burn forever
-                                    // as they can produce small fires above themselves
-                                    int new_intensity = std::max( cur.get_field_intensity(),
-                                                                  fire_there->get_field_intensity() );
-                                    // Allow smaller fires to combine
-                                    if( new_intensity < 3 &&
-                                        cur.get_field_intensity() == fire_there->get_field_intensity() ) {
-                                        new_intensity++;
-                                    }
-                                    fire_there->set_field_intensity( new_intensity );
-                                    // A raging fire below us can support us for a while
-                                    // Otherwise decay and decay fast
-                                    if( new_intensity < 3 || one_in( 10 ) ) {
-                                        cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                                    }
                                 }
-                                break;
                             }
+                            break;
                         }
                     }
-                    // Lower age is a longer lasting fire
-                    if( time_added != 0_turns ) {
-                        cur.set_field_age( cur.get_field_age() - time_added );
-                    } else if( can_burn ) {
-                        // Nothing to burn = fire should be dying out faster
-                        // Drain more power from big fires, so that they stop raging over nothing
-                        // Except for fires on stoves and fireplaces, those are made to keep the fire alive
-                        cur.set_field_age( cur.get_field_age() + 10_seconds * cur.get_field_intensity() );
-                    }
+                }
+                // Lower age is a longer lasting fire
+                if( time_added != 0_turns ) {
+                    cur.set_field_age( cur.get_field_age() - time_added );
+                } else if( can_burn ) {
+                    // Nothing to burn = fire should be dying out faster
+                    // Drain more power from big fires, so that they stop raging over nothing
+                    // Except for fires on stoves and fireplaces, those are made to keep the fire alive
+                    cur.set_field_age( cur.get_field_age() + 10_seconds * cur.get_field_intensity() );
+                }
 
-                    // Below we will access our nearest 8 neighbors, so let's cache them now
-                    // This should probably be done more globally, because large fires will re-do it a lot
-                    auto neighs = get_neighbors( p );
-                    // Get the neighbours that are allowed due to wind direction
-                    auto maptiles = get_wind_blockers( winddirection, p );
-                    maptile remove_tile = std::get<0>( maptiles );
-                    maptile remove_tile2 = std::get<1>( maptiles );
-                    maptile remove_tile3 = std::get<2>( maptiles );
-                    std::vector<maptile> neighbour_vec;
-                    size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-                    // Start at end_it + 1, then wrap around until all elements have been processed
-                    for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
-                         count != neighs.size();
-                         i = ( i + 1 ) % neighs.size(), count++ ) {
-                        const auto &neigh = neighs[i];
-                        if( ( neigh.x != remove_tile.x && neigh.y != remove_tile.y ) ||
-                            ( neigh.x != remove_tile2.x && neigh.y != remove_tile2.y ) ||
-                            ( neigh.x != remove_tile3.x && neigh.y != remove_tile3.y ) ) {
-                            neighbour_vec.push_back( neigh );
-                        } else if( x_in_y( 1, std::max( 2, windpower ) ) ) {
-                            neighbour_vec.push_back( neigh );
-                        }
+                // Below we will access our nearest 8 neighbors, so let's cache them now
+                // This should probably be done more globally, because large fires will re-do it a lot
+                auto neighs = get_neighbors( p );
+                // Get the neighbours that are allowed due to wind direction
+                auto maptiles = get_wind_blockers( winddirection, p );
+                maptile remove_tile = std::get<0>( maptiles );
+                maptile remove_tile2 = std::get<1>( maptiles );
+                maptile remove_tile3 = std::get<2>( maptiles );
+                std::vector<maptile> neighbour_vec;
+                size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
+                // Start at end_it + 1, then wrap around until all elements have been processed
+                for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
+                     count != neighs.size();
+                     i = ( i + 1 ) % neighs.size(), count++ ) {
+                    const auto &neigh = neighs[i];
+                    if( ( neigh.x != remove_tile.x && neigh.y != remove_tile.y ) ||
+                        ( neigh.x != remove_tile2.x && neigh.y != remove_tile2.y ) ||
+                        ( neigh.x != remove_tile3.x && neigh.y != remove_tile3.y ) ) {
+                        neighbour_vec.push_back( neigh );
+                    } else if( x_in_y( 1, std::max( 2, windpower ) ) ) {
+                        neighbour_vec.push_back( neigh );
                     }
-                    // If the flames are in a pit, it can't spread to non-pit
-                    const bool in_pit = ter.id.id() == t_pit;
-
-                    // Count adjacent fires, to optimize out needless smoke and hot air
-                    int adjacent_fires = 0;
-
-                    // If the flames are big, they contribute to adjacent flames
-                    if( can_spread ) {
-                        if( cur.get_field_intensity() > 1 && one_in( 3 ) ) {
-                            // Basically: Scan around for a spot,
-                            // if there is more fire there, make it bigger and give it some fuel.
-                            // This is how big fires spend their excess age:
-                            // making other fires bigger. Flashpoint.
-                            if( sheltered || windpower < 5 ) {
-                                end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-                                for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
-                                     count != neighs.size() && cur.get_field_age() < 0_turns;
-                                     i = ( i + 1 ) % neighs.size(), count++ ) {
-                                    maptile &dst = neighs[i];
-                                    auto dstfld = dst.find_field( fd_fire );
-                                    // If the fire exists and is weaker than ours, boost it
-                                    if( dstfld != nullptr &&
-                                        ( dstfld->get_field_intensity() <= cur.get_field_intensity() ||
-                                          dstfld->get_field_age() > cur.get_field_age() ) &&
-                                        ( in_pit == ( dst.get_ter() == t_pit ) ) ) {
-                                        if( dstfld->get_field_intensity() < 2 ) {
-                                            dstfld->set_field_intensity( dstfld->get_field_intensity() + 1 );
-                                        }
-
-                                        dstfld->set_field_age( dstfld->get_field_age() - 5_minutes );
-                                        cur.set_field_age( cur.get_field_age() + 5_minutes );
-                                    }
-                                    if( dstfld != nullptr ) {
-                                        adjacent_fires++;
-                                    }
-                                }
-                            } else {
-                                end_it = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
-                                for( size_t i = ( end_it + 1 ) % neighbour_vec.size(), count = 0;
-                                     count != neighbour_vec.size() && cur.get_field_age() < 0_turns;
-                                     i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
-                                    maptile &dst = neighbour_vec[i];
-                                    field_entry *dstfld = dst.find_field( fd_fire );
-                                    // If the fire exists and is weaker than ours, boost it
-                                    if( dstfld != nullptr &&
-                                        ( dstfld->get_field_intensity() <= cur.get_field_intensity() ||
-                                          dstfld->get_field_age() > cur.get_field_age() ) &&
-                                        ( in_pit == ( dst.get_ter() == t_pit ) ) ) {
-                                        if( dstfld->get_field_intensity() < 2 ) {
-                                            dstfld->set_field_intensity( dstfld->get_field_intensity() + 1 );
-                                        }
-
-                                        dstfld->set_field_age( dstfld->get_field_age() - 5_minutes );
-                                        cur.set_field_age( cur.get_field_age() + 5_minutes );
+                }
+                // If the flames are in a pit, it can't spread to non-pit
+                const bool in_pit = ter.id.id() == t_pit;
+
+                // Count adjacent fires, to optimize out needless smoke and hot air
+                int adjacent_fires = 0;
+
+                // If the flames are big, they contribute to adjacent flames
+                if( can_spread ) {
+                    if( cur.get_field_intensity() > 1 && one_in( 3 ) ) {
+                        // Basically: Scan around for a spot,
+                        // if there is more fire there, make it bigger and give it some fuel.
+                        // This is how big fires spend their excess age:
+                        // making other fires bigger. Flashpoint.
+                        if( sheltered || windpower < 5 ) {
+                            end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
+                            for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
+                                 count != neighs.size() && cur.get_field_age() < 0_turns;
+                                 i = ( i + 1 ) % neighs.size(), count++ ) {
+                                maptile &dst = neighs[i];
+                                auto dstfld = dst.find_field( fd_fire );
+                                // If the fire exists and is weaker than ours, boost it
+                                if( dstfld != nullptr &&
+                                    ( dstfld->get_field_intensity() <= cur.get_field_intensity() ||
+                                      dstfld->get_field_age() > cur.get_field_age() ) &&
+                                    ( in_pit == ( dst.get_ter() == t_pit ) ) ) {
+                                    if( dstfld->get_field_intensity() < 2 ) {
+                                        dstfld->set_field_intensity( dstfld->get_field_intensity() + 1 );
                                     }
 
-                                    if( dstfld != nullptr ) {
-                                        adjacent_fires++;
-                                    }
+                                    dstfld->set_field_age( dstfld->get_field_age() - 5_minutes );
+                                    cur.set_field_age( cur.get_field_age() + 5_minutes );
+                                }
+                                if( dstfld != nullptr ) {
+                                    adjacent_fires++;
                                 }
                             }
-                        } else if( cur.get_field_age() < 0_turns && cur.get_field_intensity() < 3 ) {
-                            // See if we can grow into a stage 2/3 fire, for this
-                            // burning neighbors are necessary in addition to
-                            // field age < 0, or alternatively, a LOT of fuel.
-
-                            // The maximum fire intensity is 1 for a lone fire, 2 for at least 1 neighbor,
-                            // 3 for at least 2 neighbors.
-                            int maximum_intensity = 1;
-
-                            // The following logic looks a bit complex due to optimization concerns, so here are the semantics:
-                            // 1. Calculate maximum field intensity based on fuel, -50 minutes is 2(medium), -500 minutes is 3(raging)
-                            // 2. Calculate maximum field intensity based on neighbors, 3 neighbors is 2(medium), 7 or more neighbors is 3(raging)
-                            // 3. Pick the higher maximum between 1. and 2.
-                            if( cur.get_field_age() < -500_minutes ) {
-                                maximum_intensity = 3;
-                            } else {
-                                for( auto &neigh : neighs ) {
-                                    if( neigh.get_field().find_field( fd_fire ) != nullptr ) {
-                                        adjacent_fires++;
+                        } else {
+                            end_it = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
+                            for( size_t i = ( end_it + 1 ) % neighbour_vec.size(), count = 0;
+                                 count != neighbour_vec.size() && cur.get_field_age() < 0_turns;
+                                 i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
+                                maptile &dst = neighbour_vec[i];
+                                field_entry *dstfld = dst.find_field( fd_fire );
+                                // If the fire exists and is weaker than ours, boost it
+                                if( dstfld != nullptr &&
+                                    ( dstfld->get_field_intensity() <= cur.get_field_intensity() ||
+                                      dstfld->get_field_age() > cur.get_field_age() ) &&
+                                    ( in_pit == ( dst.get_ter() == t_pit ) ) ) {
+                                    if( dstfld->get_field_intensity() < 2 ) {
+                                        dstfld->set_field_intensity( dstfld->get_field_intensity() + 1 );
                                     }
+
+                                    dstfld->set_field_age( dstfld->get_field_age() - 5_minutes );
+                                    cur.set_field_age( cur.get_field_age() + 5_minutes );
                                 }
-                                maximum_intensity = 1 + ( adjacent_fires >= 3 ) + ( adjacent_fires >= 7 );
 
-                                if( maximum_intensity < 2 && cur.get_field_age() < -50_minutes ) {
-                                    maximum_intensity = 2;
+                                if( dstfld != nullptr ) {
+                                    adjacent_fires++;
+                                }
+                            }
+                        }
+                    } else if( cur.get_field_age() < 0_turns && cur.get_field_intensity() < 3 ) {
+                        // See if we can grow into a stage 2/3 fire, for this
+                        // burning neighbors are necessary in addition to
+                        // field age < 0, or alternatively, a LOT of fuel.
+
+                        // The maximum fire intensity is 1 for a lone fire, 2 for at least 1 neighbor,
+                        // 3 for at least 2 neighbors.
+                        int maximum_intensity = 1;
+
+                        // The following logic looks a bit complex due to optimization concerns, so here are the semantics:
+                        // 1. Calculate maximum field intensity based on fuel, -50 minutes is 2(medium), -500 minutes is 3(raging)
+                        // 2. Calculate maximum field intensity based on neighbors, 3 neighbors is 2(medium), 7 or more neighbors is 3(raging)
+                        // 3. Pick the higher maximum between 1. and 2.
+                        if( cur.get_field_age() < -500_minutes ) {
+                            maximum_intensity = 3;
+                        } else {
+                            for( auto &neigh : neighs ) {
+                                if( neigh.get_field().find_field( fd_fire ) != nullptr ) {
+                                    adjacent_fires++;
                                 }
                             }
+                            maximum_intensity = 1 + ( adjacent_fires >= 3 ) + ( adjacent_fires >= 7 );
 
-                            // If we consumed a lot, the flames grow higher
-                            if( cur.get_field_intensity() < maximum_intensity && cur.get_field_age() < 0_turns ) {
-                                // Fires under 0 age grow in size. Level 3 fires under 0 spread later on.
-                                // Weaken the newly-grown fire
-                                cur.set_field_intensity( cur.get_field_intensity() + 1 );
-                                cur.set_field_age( cur.get_field_age() + 10_minutes * cur.get_field_intensity() );
+                            if( maximum_intensity < 2 && cur.get_field_age() < -50_minutes ) {
+                                maximum_intensity = 2;
                             }
                         }
+
+                        // If we consumed a lot, the flames grow higher
+                        if( cur.get_field_intensity() < maximum_intensity && cur.get_field_age() < 0_turns ) {
+                            // Fires under 0 age grow in size. Level 3 fires under 0 spread later on.
+                            // Weaken the newly-grown fire
+                            cur.set_field_intensity( cur.get_field_intensity() + 1 );
+                            cur.set_field_age( cur.get_field_age() + 10_minutes * cur.get_field_intensity() );
+                        }
                     }
-                    // Consume adjacent fuel / terrain / webs to spread.
-                    // Allow raging fires (and only raging fires) to spread up
-                    // Spreading down is achieved by wrecking the walls/floor and then falling
-                    if( zlevels && cur.get_field_intensity() == 3 && p.z < OVERMAP_HEIGHT ) {
-                        // Let it burn through the floor
-                        maptile dst = maptile_at_internal( {p.x, p.y, p.z + 1} );
-                        const auto &dst_ter = dst.get_ter_t();
-                        if( dst_ter.has_flag( TFLAG_NO_FLOOR ) ||
-                            dst_ter.has_flag( TFLAG_FLAMMABLE ) ||
-                            dst_ter.has_flag( TFLAG_FLAMMABLE_ASH ) ||
-                            dst_ter.has_flag( TFLAG_FLAMMABLE_HARD ) ) {
-                            field_entry *nearfire = dst.find_field( fd_fire );
-                            if( nearfire != nullptr ) {
-                                nearfire->set_field_age( nearfire->get_field_age() - 2_minutes );
-                            } else {
-                                dst.add_field( fd_fire, 1, 0_turns );
-                            }
-                            // Fueling fires above doesn't cost fuel
+                }
+                // Consume adjacent fuel / terrain / webs to spread.
+                // Allow raging fires (and only raging fires) to spread up
+                // Spreading down is achieved by wrecking the walls/floor and then falling
+                if( zlevels && cur.get_field_intensity() == 3 && p.z < OVERMAP_HEIGHT ) {
+                    // Let it burn through the floor
+                    maptile dst = maptile_at_internal( {p.x, p.y, p.z + 1} );
+                    const auto &dst_ter = dst.get_ter_t();
+                    if( dst_ter.has_flag( TFLAG_NO_FLOOR ) ||
+                        dst_ter.has_flag( TFLAG_FLAMMABLE ) ||
+                        dst_ter.has_flag( TFLAG_FLAMMABLE_ASH ) ||
+                        dst_ter.has_flag( TFLAG_FLAMMABLE_HARD ) ) {
+                        field_entry *nearfire = dst.find_field( fd_fire );
+                        if( nearfire != nullptr ) {
+                            nearfire->set_field_age( nearfire->get_field_age() - 2_minutes );
+                        } else {
+                            dst.add_field( fd_fire, 1, 0_turns );
                         }
+                        // Fueling fires above doesn't cost fuel
                     }
-                    // Our iterator will start at end_i + 1 and increment from there and then wrap around.
-                    // This guarantees it will check all neighbors, starting from a random one
-                    if( sheltered || windpower < 5 ) {
-                        const size_t end_i = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-                        for( size_t i = ( end_i + 1 ) % neighs.size(), count = 0;
-                             count != neighs.size();
-                             i = ( i + 1 ) % neighs.size(), count++ ) {
-                            if( one_in( cur.get_field_intensity() * 2 ) ) {
-                                // Skip some processing to save on CPU
-                                continue;
-                            }
+                }
+                // Our iterator will start at end_i + 1 and increment from there and then wrap around.
+                // This guarantees it will check all neighbors, starting from a random one
+                if( sheltered || windpower < 5 ) {
+                    const size_t end_i = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
+                    for( size_t i = ( end_i + 1 ) % neighs.size(), count = 0;
+                         count != neighs.size();
+                         i = ( i + 1 ) % neighs.size(), count++ ) {
+                        if( one_in( cur.get_field_intensity() * 2 ) ) {
+                            // Skip some processing to save on CPU
+                            continue;
+                        }
 
-                            maptile &dst = neighs[i];
-                            // No bounds checking here: we'll treat the invalid neighbors as valid.
-                            // We're using the map tile wrapper, so we can treat invalid tiles as sentinels.
-                            // This will create small oddities on map edges, but nothing more noticeable than
-                            // "cut-off" that happens with bounds checks.
+                        maptile &dst = neighs[i];
+                        // No bounds checking here: we'll treat the invalid neighbors as valid.
+                        // We're using the map tile wrapper, so we can treat invalid tiles as sentinels.
+                        // This will create small oddities on map edges, but nothing more noticeable than
+                        // "cut-off" that happens with bounds checks.
 
-                            field_entry *nearfire = dst.find_field( fd_fire );
-                            if( nearfire != nullptr ) {
-                                // We handled supporting fires in the section above, no need to do it here
-                                continue;
-                            }
+                        field_entry *nearfire = dst.find_field( fd_fire );
+                        if( nearfire != nullptr ) {
+                            // We handled supporting fires in the section above, no need to do it here
+                            continue;
+                        }
 
-                            field_entry *nearwebfld = dst.find_field( fd_web );
-                            int spread_chance = 25 * ( cur.get_field_intensity() - 1 );
-                            if( nearwebfld != nullptr ) {
-                                spread_chance = 50 + spread_chance / 2;
-                            }
+                        field_entry *nearwebfld = dst.find_field( fd_web );
+                        int spread_chance = 25 * ( cur.get_field_intensity() - 1 );
+                        if( nearwebfld != nullptr ) {
+                            spread_chance = 50 + spread_chance / 2;
+                        }
 
-                            const ter_t &dster = dst.get_ter_t();
-                            const furn_t &dsfrn = dst.get_furn_t();
-                            // Allow weaker fires to spread occasionally
-                            const int power = cur.get_field_intensity() + one_in( 5 );
-                            if( can_spread && rng( 1, 100 ) < spread_chance &&
-                                ( dster.is_flammable() || dsfrn.is_flammable() ) &&
-                                ( in_pit == ( dster.id.id() == t_pit ) ) &&
-                                (
-                                    ( power >= 3 && cur.get_field_age() < 0_turns && one_in( 20 ) ) ||
-                                    ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE ) && one_in( 2 ) ) ) ||
-                                    ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_ASH ) && one_in( 2 ) ) ) ||
-                                    ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_HARD ) && one_in( 5 ) ) ) ||
-                                    nearwebfld || ( dst.get_item_count() > 0 &&
-                                                    flammable_items_at( p + eight_horizontal_neighbors[i] ) &&
-                                                    one_in( 5 ) )
-                                ) ) {
-                                // Nearby open flammable ground? Set it on fire.
-                                dst.add_field( fd_fire, 1, 0_turns );
-                                tmpfld = dst.find_field( fd_fire );
-                                if( tmpfld != nullptr ) {
-                                    // Make the new fire quite weak, so that it doesn't start jumping around instantly
-                                    tmpfld->set_field_age( 2_minutes );
-                                    // Consume a bit of our fuel
-                                    cur.set_field_age( cur.get_field_age() + 1_minutes );
-                                }
-                                if( nearwebfld ) {
-                                    nearwebfld->set_field_intensity( 0 );
-                                }
+                        const ter_t &dster = dst.get_ter_t();
+                        const furn_t &dsfrn = dst.get_furn_t();
+                        // Allow weaker fires to spread occasionally
+                        const int power = cur.get_field_intensity() + one_in( 5 );
+                        if( can_spread && rng( 1, 100 ) < spread_chance &&
+                            ( dster.is_flammable() || dsfrn.is_flammable() ) &&
+                            ( in_pit == ( dster.id.id() == t_pit ) ) &&
+                            (
+                                ( power >= 3 && cur.get_field_age() < 0_turns && one_in( 20 ) ) ||
+                                ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE ) && one_in( 2 ) ) ) ||
+                                ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_ASH ) && one_in( 2 ) ) ) ||
+                                ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_HARD ) && one_in( 5 ) ) ) ||
+                                nearwebfld || ( dst.get_item_count() > 0 &&
+                                                flammable_items_at( p + eight_horizontal_neighbors[i] ) &&
+                                                one_in( 5 ) )
+                            ) ) {
+                            // Nearby open flammable ground? Set it on fire.
+                            dst.add_field( fd_fire, 1, 0_turns );
+                            tmpfld = dst.find_field( fd_fire );
+                            if( tmpfld != nullptr ) {
+                                // Make the new fire quite weak, so that it doesn't start jumping around instantly
+                                tmpfld->set_field_age( 2_minutes );
+                                // Consume a bit of our fuel
+                                cur.set_field_age( cur.get_field_age() + 1_minutes );
                             }
-                        }
-                    } else {
-                        const size_t end_i = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
-                        for( size_t i = ( end_i + 1 ) % neighbour_vec.size(), count = 0;
-                             count != neighbour_vec.size();
-                             i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
-                            if( one_in( cur.get_field_intensity() * 2 ) ) {
-                                // Skip some processing to save on CPU
-                                continue;
+                            if( nearwebfld ) {
+                                nearwebfld->set_field_intensity( 0 );
                             }
+                        }
+                    }
+                } else {
+                    const size_t end_i = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
+                    for( size_t i = ( end_i + 1 ) % neighbour_vec.size(), count = 0;
+                         count != neighbour_vec.size();
+                         i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
+                        if( one_in( cur.get_field_intensity() * 2 ) ) {
+                            // Skip some processing to save on CPU
+                            continue;
+                        }
 
-                            if( neighbour_vec.empty() ) {
-                                continue;
-                            }
+                        if( neighbour_vec.empty() ) {
+                            continue;
+                        }
 
-                            maptile &dst = neighbour_vec[i];
-                            // No bounds checking here: we'll treat the invalid neighbors as valid.
-                            // We're using the map tile wrapper, so we can treat invalid tiles as sentinels.
-                            // This will create small oddities on map edges, but nothing more noticeable than
-                            // "cut-off" that happens with bounds checks.
+                        maptile &dst = neighbour_vec[i];
+                        // No bounds checking here: we'll treat the invalid neighbors as valid.
+                        // We're using the map tile wrapper, so we can treat invalid tiles as sentinels.
+                        // This will create small oddities on map edges, but nothing more noticeable than
+                        // "cut-off" that happens with bounds checks.
 
-                            field_entry *nearfire = dst.find_field( fd_fire );
-                            if( nearfire != nullptr ) {
-                                // We handled supporting fires in the section above, no need to do it here
-                                continue;
-                            }
+                        field_entry *nearfire = dst.find_field( fd_fire );
+                        if( nearfire != nullptr ) {
+                            // We handled supporting fires in the section above, no need to do it here
+                            continue;
+                        }
 
-                            field_entry *nearwebfld = dst.find_field( fd_web );
-                            int spread_chance = 25 * ( cur.get_field_intensity() - 1 );
-                            if( nearwebfld != nullptr ) {
-                                spread_chance = 50 + spread_chance / 2;
-                            }
+                        field_entry *nearwebfld = dst.find_field( fd_web );
+                        int spread_chance = 25 * ( cur.get_field_intensity() - 1 );
+                        if( nearwebfld != nullptr ) {
+                            spread_chance = 50 + spread_chance / 2;
+                        }
 
-                            const ter_t &dster = dst.get_ter_t();
-                            const furn_t &dsfrn = dst.get_furn_t();
-                            // Allow weaker fires to spread occasionally
-                            const int power = cur.get_field_intensity() + one_in( 5 );
-                            if( can_spread && rng( 1, 100 - windpower ) < spread_chance &&
-                                ( dster.is_flammable() || dsfrn.is_flammable() ) &&
-                                ( in_pit == ( dster.id.id() == t_pit ) ) &&
-                                (
-                                    ( power >= 3 && cur.get_field_age() < 0_turns && one_in( 20 ) ) ||
-                                    ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE ) && one_in( 2 ) ) ) ||
-                                    ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_ASH ) && one_in( 2 ) ) ) ||
-                                    ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_HARD ) && one_in( 5 ) ) ) ||
-                                    nearwebfld || ( dst.get_item_count() > 0 &&
-                                                    flammable_items_at( p + eight_horizontal_neighbors[i] ) &&
-                                                    one_in( 5 ) )
-                                ) ) {
-                                // Nearby open flammable ground? Set it on fire.
-                                dst.add_field( fd_fire, 1, 0_turns );
-                                tmpfld = dst.find_field( fd_fire );
-                                if( tmpfld != nullptr ) {
-                                    // Make the new fire quite weak, so that it doesn't start jumping around instantly
-                                    tmpfld->set_field_age( 2_minutes );
-                                    // Consume a bit of our fuel
-                                    cur.set_field_age( cur.get_field_age() + 1_minutes );
-                                }
-                                if( nearwebfld ) {
-                                    nearwebfld->set_field_intensity( 0 );
-                                }
+                        const ter_t &dster = dst.get_ter_t();
+                        const furn_t &dsfrn = dst.get_furn_t();
+                        // Allow weaker fires to spread occasionally
+                        const int power = cur.get_field_intensity() + one_in( 5 );
+                        if( can_spread && rng( 1, 100 - windpower ) < spread_chance &&
+                            ( dster.is_flammable() || dsfrn.is_flammable() ) &&
+                            ( in_pit == ( dster.id.id() == t_pit ) ) &&
+                            (
+                                ( power >= 3 && cur.get_field_age() < 0_turns && one_in( 20 ) ) ||
+                                ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE ) && one_in( 2 ) ) ) ||
+                                ( power >= 2 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_ASH ) && one_in( 2 ) ) ) ||
+                                ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, TFLAG_FLAMMABLE_HARD ) && one_in( 5 ) ) ) ||
+                                nearwebfld || ( dst.get_item_count() > 0 &&
+                                                flammable_items_at( p + eight_horizontal_neighbors[i] ) &&
+                                                one_in( 5 ) )
+                            ) ) {
+                            // Nearby open flammable ground? Set it on fire.
+                            dst.add_field( fd_fire, 1, 0_turns );
+                            tmpfld = dst.find_field( fd_fire );
+                            if( tmpfld != nullptr ) {
+                                // Make the new fire quite weak, so that it doesn't start jumping around instantly
+                                tmpfld->set_field_age( 2_minutes );
+                                // Consume a bit of our fuel
+                                cur.set_field_age( cur.get_field_age() + 1_minutes );
                             }
-                        }
-                    }
-                    // Create smoke once - above us if possible, at us otherwise
-                    if( !ter_furn_has_flag( ter, frn, TFLAG_SUPPRESS_SMOKE ) &&
-                        rng( 0, 100 - windpower ) <= smoke &&
-                        rng( 3, 35 ) < cur.get_field_intensity() * 10 ) {
-                        bool smoke_up = zlevels && p.z < OVERMAP_HEIGHT;
-                        if( smoke_up ) {
-                            tripoint up{p.x, p.y, p.z + 1};
-                            maptile dst = maptile_at_internal( up );
-                            const ter_t &dst_ter = dst.get_ter_t();
-                            if( dst_ter.has_flag( TFLAG_NO_FLOOR ) ) {
-                                dst.add_field( fd_smoke, rng( 1, cur.get_field_intensity() ), 0_turns );
-                            } else {
-                                // Can't create smoke above
-                                smoke_up = false;
+                            if( nearwebfld ) {
+                                nearwebfld->set_field_intensity( 0 );
                             }
                         }
-
-                        if( !smoke_up ) {
-                            maptile dst = maptile_at_internal( p );
-                            // Create thicker smoke
-                            dst.add_field( fd_smoke, cur.get_field_intensity(), 0_turns );
+                    }
+                }
+                // Create smoke once - above us if possible, at us otherwise
+                if( !ter_furn_has_flag( ter, frn, TFLAG_SUPPRESS_SMOKE ) &&
+                    rng( 0, 100 - windpower ) <= smoke &&
+                    rng( 3, 35 ) < cur.get_field_intensity() * 10 ) {
+                    bool smoke_up = zlevels && p.z < OVERMAP_HEIGHT;
+                    if( smoke_up ) {
+                        tripoint up{p.x, p.y, p.z + 1};
+                        maptile dst = maptile_at_internal( up );
+                        const ter_t &dst_ter = dst.get_ter_t();
+                        if( dst_ter.has_flag( TFLAG_NO_FLOOR ) ) {
+                            dst.add_field( fd_smoke, rng( 1, cur.get_field_intensity() ), 0_turns );
+                        } else {
+                            // Can't create smoke above
+                            smoke_up = false;
                         }
-
-                        // Smoke affects transparency
-                        dirty_transparency_cache = true;
                     }
 
-                    // Hot air is a load on the CPU
-                    // Don't produce too much of it if we have a lot fires nearby, they produce
-                    // radiant heat which does what hot air would do anyway
-                    if( adjacent_fires < 5 && rng( 0, 4 - adjacent_fires ) ) {
-                        create_hot_air( p, cur.get_field_intensity() );
+                    if( !smoke_up ) {
+                        maptile dst = maptile_at_internal( p );
+                        // Create thicker smoke
+                        dst.add_field( fd_smoke, cur.get_field_intensity(), 0_turns );
                     }
                 }
-                if( curtype == fd_smoke || curtype == fd_tear_gas ) {
-                    spread_gas( cur, p, 10, 0_turns, sblk );
-                }
-                if( curtype == fd_relax_gas ) {
-                    spread_gas( cur, p, 15, 5_minutes, sblk );
-                }
-                if( curtype == fd_fungal_haze ) {
-                    spread_gas( cur, p, 13, 5_turns, sblk );
-                    if( one_in( 10 - 2 * cur.get_field_intensity() ) ) {
-                        // Haze'd terrain
-                        fungal_effects( *g, g->m ).spread_fungus( p );
-                    }
+
+                // Hot air is a load on the CPU
+                // Don't produce too much of it if we have a lot fires nearby, they produce
+                // radiant heat which does what hot air would do anyway
+                if( adjacent_fires < 5 && rng( 0, 4 - adjacent_fires ) ) {
+                    create_hot_air( p, cur.get_field_intensity() );
                 }
-                if( curtype == fd_toxic_gas ) {
-                    spread_gas( cur, p, 30, 3_minutes, sblk );
+            }
+            if( curtype == fd_smoke || curtype == fd_tear_gas ) {
+                spread_gas( cur, p, 10, 0_turns, sblk );
+            }
+            if( curtype == fd_relax_gas ) {
+                spread_gas( cur, p, 15, 5_minutes, sblk );
+            }
+            if( curtype == fd_fungal_haze ) {
+                spread_gas( cur, p, 13, 5_turns, sblk );
+                if( one_in( 10 - 2 * cur.get_field_intensity() ) ) {
+                    // Haze'd terrain
+                    fungal_effects( *g, g->m ).spread_fungus( p );
                 }
+            }
+            if( curtype == fd_toxic_gas ) {
+                spread_gas( cur, p, 30, 3_minutes, sblk );
+            }
 
-                if( curtype == fd_cigsmoke ) {
-                    spread_gas( cur, p, 250, 6_minutes, sblk );
-                }
-                if( curtype == fd_weedsmoke ) {
-                    spread_gas( cur, p, 200, 6_minutes, sblk );
+            if( curtype == fd_cigsmoke ) {
+                spread_gas( cur, p, 250, 6_minutes, sblk );
+            }
+            if( curtype == fd_weedsmoke ) {
+                spread_gas( cur, p, 200, 6_minutes, sblk );
 
-                    if( one_in( 20 ) ) {
-                        if( npc *const np = g->critter_at<npc>( p ) ) {
-                            np->complain_about( "weed_smell", 10_minutes, "<weed_smell>" );
-                        }
+                if( one_in( 20 ) ) {
+                    if( npc *const np = g->critter_at<npc>( p ) ) {
+                        np->complain_about( "weed_smell", 10_minutes, "<weed_smell>" );
                     }
-
                 }
 
-                if( curtype == fd_methsmoke ) {
-                    spread_gas( cur, p, 175, 7_minutes, sblk );
-                    if( one_in( 20 ) ) {
-                        if( npc *const np = g->critter_at<npc>( p ) ) {
-                            np->complain_about( "meth_smell", 30_minutes, "<meth_smell>" );
-                        }
+            }
+
+            if( curtype == fd_methsmoke ) {
+                spread_gas( cur, p, 175, 7_minutes, sblk );
+                if( one_in( 20 ) ) {
+                    if( npc *const np = g->critter_at<npc>( p ) ) {
+                        np->complain_about( "meth_smell", 30_minutes, "<meth_smell>" );
                     }
                 }
-                if( curtype == fd_cracksmoke ) {
-                    spread_gas( cur, p, 175, 8_minutes, sblk );
+            }
+            if( curtype == fd_cracksmoke ) {
+                spread_gas( cur, p, 175, 8_minutes, sblk );
 
-                    if( one_in( 20 ) ) {
-                        if( npc *const np = g->critter_at<npc>( p ) ) {
-                            np->complain_about( "crack_smell", 30_minutes, "<crack_smell>" );
-                        }
+                if( one_in( 20 ) ) {
+                    if( npc *const np = g->critter_at<npc>( p ) ) {
+                        np->complain_about( "crack_smell", 30_minutes, "<crack_smell>" );
                     }
                 }
-                if( curtype == fd_nuke_gas ) {
-                    int extra_radiation = rng( 0, cur.get_field_intensity() );
-                    adjust_radiation( p, extra_radiation );
-                    spread_gas( cur, p, 15, 1_minutes, sblk );
-                }
-                if( curtype == fd_cold_air1 || curtype == fd_cold_air2 ||
-                    curtype == fd_cold_air3 || curtype == fd_cold_air4 ||
-                    curtype == fd_hot_air1 || curtype == fd_hot_air2 ||
-                    curtype == fd_hot_air3 || curtype == fd_hot_air4 ) {
-                    // No transparency cache wrecking here!
-                    spread_gas( cur, p, 100, 100_minutes, sblk );
-                }
-                if( curtype == fd_gas_vent ) {
-                    for( const tripoint &pnt : points_in_radius( p, cur.get_field_intensity() - 1 ) ) {
-                        field &wandering_field = get_field( pnt );
-                        tmpfld = wandering_field.find_field( fd_toxic_gas );
-                        if( tmpfld && tmpfld->get_field_intensity() < cur.get_field_intensity() ) {
-                            tmpfld->set_field_intensity( tmpfld->get_field_intensity() + 1 );
-                        } else {
-                            add_field( pnt, fd_toxic_gas, cur.get_field_intensity() );
-                        }
+            }
+            if( curtype == fd_nuke_gas ) {
+                int extra_radiation = rng( 0, cur.get_field_intensity() );
+                adjust_radiation( p, extra_radiation );
+                spread_gas( cur, p, 15, 1_minutes, sblk );
+            }
+            if( curtype == fd_cold_air1 || curtype == fd_cold_air2 ||
+                curtype == fd_cold_air3 || curtype == fd_cold_air4 ||
+                curtype == fd_hot_air1 || curtype == fd_hot_air2 ||
+                curtype == fd_hot_air3 || curtype == fd_hot_air4 ) {
+                // No transparency cache wrecking here!
+                spread_gas( cur, p, 100, 100_minutes, sblk );
+            }
+            if( curtype == fd_gas_vent ) {
+                for( const tripoint &pnt : points_in_radius( p, cur.get_field_intensity() - 1 ) ) {
+                    field &wandering_field = get_field( pnt );
+                    tmpfld = wandering_field.find_field( fd_toxic_gas );
+                    if( tmpfld && tmpfld->get_field_intensity() < cur.get_field_intensity() ) {
+                        tmpfld->set_field_intensity( tmpfld->get_field_intensity() + 1 );
+                    } else {
+                        add_field( pnt, fd_toxic_gas, cur.get_field_intensity() );
                     }
                 }
-                if( curtype == fd_smoke_vent ) {
-                    for( const tripoint &pnt : points_in_radius( p, cur.get_field_intensity() - 1 ) ) {
-                        field &wandering_field = get_field( pnt );
-                        tmpfld = wandering_field.find_field( fd_smoke );
-                        if( tmpfld && tmpfld->get_field_intensity() < cur.get_field_intensity() ) {
-                            tmpfld->set_field_intensity( tmpfld->get_field_intensity() + 1 );
-                        } else {
-                            add_field( pnt, fd_smoke, cur.get_field_intensity() );
-                        }
+            }
+            if( curtype == fd_smoke_vent ) {
+                for( const tripoint &pnt : points_in_radius( p, cur.get_field_intensity() - 1 ) ) {
+                    field &wandering_field = get_field( pnt );
+                    tmpfld = wandering_field.find_field( fd_smoke );
+                    if( tmpfld && tmpfld->get_field_intensity() < cur.get_field_intensity() ) {
+                        tmpfld->set_field_intensity( tmpfld->get_field_intensity() + 1 );
+                    } else {
+                        add_field( pnt, fd_smoke, cur.get_field_intensity() );
                     }
                 }
+            }
 
-                if( curtype == fd_fire_vent ) {
+            if( curtype == fd_fire_vent ) {
 
-                    if( cur.get_field_intensity() > 1 ) {
-                        if( one_in( 3 ) ) {
-                            cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                        }
-                        create_hot_air( p, cur.get_field_intensity() );
-                    } else {
-                        dirty_transparency_cache = true;
-                        add_field( p, fd_flame_burst, 3, cur.get_field_age() );
-                        cur.set_field_intensity( 0 );
-                    }
-                }
-                if( curtype == fd_flame_burst ) {
-                    if( cur.get_field_intensity() > 1 ) {
+                if( cur.get_field_intensity() > 1 ) {
+                    if( one_in( 3 ) ) {
                         cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                        create_hot_air( p, cur.get_field_intensity() );
-                    } else {
-                        dirty_transparency_cache = true;
-                        add_field( p, fd_fire_vent, 3, cur.get_field_age() );
-                        cur.set_field_intensity( 0 );
                     }
+                    create_hot_air( p, cur.get_field_intensity() );
+                } else {
+                    add_field( p, fd_flame_burst, 3, cur.get_field_age() );
+                    cur.set_field_intensity( 0 );
                 }
-                if( curtype == fd_electricity ) {
-                    // 4 in 5 chance to spread
-                    if( !one_in( 5 ) ) {
-                        std::vector<tripoint> valid;
-                        // We're grounded
-                        if( impassable( p ) && cur.get_field_intensity() > 1 ) {
-                            int tries = 0;
-                            tripoint pnt;
-                            pnt.z = p.z;
-                            while( tries < 10 && cur.get_field_age() < 5_minutes && cur.get_field_intensity() > 1 ) {
-                                pnt.x = p.x + rng( -1, 1 );
-                                pnt.y = p.y + rng( -1, 1 );
-                                if( passable( pnt ) ) {
-                                    add_field( pnt, fd_electricity, 1, cur.get_field_age() + 1_turns );
-                                    cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                                    tries = 0;
-                                } else {
-                                    tries++;
-                                }
-                            }
-                            // We're not grounded; attempt to ground
-                        } else {
-                            for( const tripoint &dst : points_in_radius( p, 1 ) ) {
-                                // Grounded tiles first
-                                if( impassable( dst ) ) {
-                                    valid.push_back( dst );
-                                }
-                            }
-                            // Spread to adjacent space, then
-                            if( valid.empty() ) {
-                                tripoint dst( p.x + rng( -1, 1 ), p.y + rng( -1, 1 ), p.z );
-                                field_entry *elec = get_field( dst ).find_field( fd_electricity );
-                                if( passable( dst ) && elec != nullptr &&
-                                    elec->get_field_intensity() < 3 ) {
-                                    elec->set_field_intensity( elec->get_field_intensity() + 1 );
-                                    cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                                } else if( passable( dst ) ) {
-                                    add_field( dst, fd_electricity, 1, cur.get_field_age() + 1_turns );
-                                }
+            }
+            if( curtype == fd_flame_burst ) {
+                if( cur.get_field_intensity() > 1 ) {
+                    cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                    create_hot_air( p, cur.get_field_intensity() );
+                } else {
+                    add_field( p, fd_fire_vent, 3, cur.get_field_age() );
+                    cur.set_field_intensity( 0 );
+                }
+            }
+            if( curtype == fd_electricity ) {
+                // 4 in 5 chance to spread
+                if( !one_in( 5 ) ) {
+                    std::vector<tripoint> valid;
+                    // We're grounded
+                    if( impassable( p ) && cur.get_field_intensity() > 1 ) {
+                        int tries = 0;
+                        tripoint pnt;
+                        pnt.z = p.z;
+                        while( tries < 10 && cur.get_field_age() < 5_minutes && cur.get_field_intensity() > 1 ) {
+                            pnt.x = p.x + rng( -1, 1 );
+                            pnt.y = p.y + rng( -1, 1 );
+                            if( passable( pnt ) ) {
+                                add_field( pnt, fd_electricity, 1, cur.get_field_age() + 1_turns );
                                 cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                                tries = 0;
+                            } else {
+                                tries++;
+                            }
+                        }
+                        // We're not grounded; attempt to ground
+                    } else {
+                        for( const tripoint &dst : points_in_radius( p, 1 ) ) {
+                            // Grounded tiles first
+                            if( impassable( dst ) ) {
+                                valid.push_back( dst );
                             }
-                            while( !valid.empty() && cur.get_field_intensity() > 1 ) {
-                                const tripoint target = random_entry_removed( valid );
-                                add_field( target, fd_electricity, 1, cur.get_field_age() + 1_turns );
+                        }
+                        // Spread to adjacent space, then
+                        if( valid.empty() ) {
+                            tripoint dst( p.x + rng( -1, 1 ), p.y + rng( -1, 1 ), p.z );
+                            field_entry *elec = get_field( dst ).find_field( fd_electricity );
+                            if( passable( dst ) && elec != nullptr &&
+                                elec->get_field_intensity() < 3 ) {
+                                elec->set_field_intensity( elec->get_field_intensity() + 1 );
                                 cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                            } else if( passable( dst ) ) {
+                                add_field( dst, fd_electricity, 1, cur.get_field_age() + 1_turns );
                             }
+                            cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                        }
+                        while( !valid.empty() && cur.get_field_intensity() > 1 ) {
+                            const tripoint target = random_entry_removed( valid );
+                            add_field( target, fd_electricity, 1, cur.get_field_age() + 1_turns );
+                            cur.set_field_intensity( cur.get_field_intensity() - 1 );
                         }
                     }
                 }
-                if( curtype == fd_fatigue ) {
-                    static const std::array<mtype_id, 9> monids = { {
-                            mtype_id( "mon_flying_polyp" ), mtype_id( "mon_hunting_horror" ),
-                            mtype_id( "mon_mi_go" ), mtype_id( "mon_yugg" ), mtype_id( "mon_gelatin" ),
-                            mtype_id( "mon_flaming_eye" ), mtype_id( "mon_kreck" ), mtype_id( "mon_gracke" ),
-                            mtype_id( "mon_blank" ),
-                        }
-                    };
-                    if( cur.get_field_intensity() < 3 && calendar::once_every( 6_hours ) && one_in( 10 ) ) {
-                        cur.set_field_intensity( cur.get_field_intensity() + 1 );
-                        // Spawn nether creature!
-                    } else if( cur.get_field_intensity() == 3 && one_in( 600 ) ) {
-                        g->summon_mon( random_entry( monids ), p );
+            }
+            if( curtype == fd_fatigue ) {
+                static const std::array<mtype_id, 9> monids = { {
+                        mtype_id( "mon_flying_polyp" ), mtype_id( "mon_hunting_horror" ),
+                        mtype_id( "mon_mi_go" ), mtype_id( "mon_yugg" ), mtype_id( "mon_gelatin" ),
+                        mtype_id( "mon_flaming_eye" ), mtype_id( "mon_kreck" ), mtype_id( "mon_gracke" ),
+                        mtype_id( "mon_blank" ),
                     }
+                };
+                if( cur.get_field_intensity() < 3 && calendar::once_every( 6_hours ) && one_in( 10 ) ) {
+                    cur.set_field_intensity( cur.get_field_intensity() + 1 );
+                    // Spawn nether creature!
+                } else if( cur.get_field_intensity() == 3 && one_in( 600 ) ) {
+                    g->summon_mon( random_entry( monids ), p );
                 }
+            }
 
-                if( curtype == fd_push_items ) {
-                    map_stack items = i_at( p );
-                    for( auto pushee = items.begin(); pushee != items.end(); ) {
-                        if( pushee->typeId() != "rock" ||
-                            pushee->age() < 1_turns ) {
-                            pushee++;
-                        } else {
-                            item tmp = *pushee;
-                            tmp.set_age( 0_turns );
-                            pushee = items.erase( pushee );
-                            std::vector<tripoint> valid;
-                            for( const tripoint &dst : points_in_radius( p, 1 ) ) {
-                                if( get_field( dst, fd_push_items ) != nullptr ) {
-                                    valid.push_back( dst );
-                                }
+            if( curtype == fd_push_items ) {
+                map_stack items = i_at( p );
+                for( auto pushee = items.begin(); pushee != items.end(); ) {
+                    if( pushee->typeId() != "rock" ||
+                        pushee->age() < 1_turns ) {
+                        pushee++;
+                    } else {
+                        item tmp = *pushee;
+                        tmp.set_age( 0_turns );
+                        pushee = items.erase( pushee );
+                        std::vector<tripoint> valid;
+                        for( const tripoint &dst : points_in_radius( p, 1 ) ) {
+                            if( get_field( dst, fd_push_items ) != nullptr ) {
+                                valid.push_back( dst );
+                            }
+                        }
+                        if( !valid.empty() ) {
+                            tripoint newp = random_entry( valid );
+                            add_item_or_charges( newp, tmp );
+                            if( g->u.pos() == newp ) {
+                                add_msg( m_bad, _( "A %s hits you!" ), tmp.tname() );
+                                body_part hit = random_body_part();
+                                g->u.deal_damage( nullptr, hit, damage_instance( DT_BASH, 6 ) );
+                                g->u.check_dead_state();
                             }
-                            if( !valid.empty() ) {
-                                tripoint newp = random_entry( valid );
-                                add_item_or_charges( newp, tmp );
-                                if( g->u.pos() == newp ) {
-                                    add_msg( m_bad, _( "A %s hits you!" ), tmp.tname() );
-                                    body_part hit = random_body_part();
-                                    g->u.deal_damage( nullptr, hit, damage_instance( DT_BASH, 6 ) );
-                                    g->u.check_dead_state();
-                                }
 
-                                if( npc *const p = g->critter_at<npc>( newp ) ) {
-                                    // TODO: combine with player character code above
-                                    body_part hit = random_body_part();
-                                    p->deal_damage( nullptr, hit, damage_instance( DT_BASH, 6 ) );
-                                    if( g->u.sees( newp ) ) {
-                                        add_msg( _( "A %1$s hits %2$s!" ), tmp.tname(), p->name );
-                                    }
-                                    p->check_dead_state();
-                                } else if( monster *const mon = g->critter_at<monster>( newp ) ) {
-                                    mon->apply_damage( nullptr, bp_torso, 6 - mon->get_armor_bash( bp_torso ) );
-                                    if( g->u.sees( newp ) ) {
-                                        add_msg( _( "A %1$s hits the %2$s!" ), tmp.tname(), mon->name() );
-                                    }
-                                    mon->check_dead_state();
+                            if( npc *const p = g->critter_at<npc>( newp ) ) {
+                                // TODO: combine with player character code above
+                                body_part hit = random_body_part();
+                                p->deal_damage( nullptr, hit, damage_instance( DT_BASH, 6 ) );
+                                if( g->u.sees( newp ) ) {
+                                    add_msg( _( "A %1$s hits %2$s!" ), tmp.tname(), p->name );
                                 }
+                                p->check_dead_state();
+                            } else if( monster *const mon = g->critter_at<monster>( newp ) ) {
+                                mon->apply_damage( nullptr, bp_torso, 6 - mon->get_armor_bash( bp_torso ) );
+                                if( g->u.sees( newp ) ) {
+                                    add_msg( _( "A %1$s hits the %2$s!" ), tmp.tname(), mon->name() );
+                                }
+                                mon->check_dead_state();
                             }
                         }
                     }
                 }
-                if( curtype == fd_shock_vent ) {
-                    if( cur.get_field_intensity() > 1 ) {
-                        if( one_in( 5 ) ) {
-                            cur.set_field_intensity( cur.get_field_intensity() - 1 );
+            }
+            if( curtype == fd_shock_vent ) {
+                if( cur.get_field_intensity() > 1 ) {
+                    if( one_in( 5 ) ) {
+                        cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                    }
+                } else {
+                    cur.set_field_intensity( 3 );
+                    int num_bolts = rng( 3, 6 );
+                    for( int i = 0; i < num_bolts; i++ ) {
+                        int xdir = 0;
+                        int ydir = 0;
+                        while( xdir == 0 && ydir == 0 ) {
+                            xdir = rng( -1, 1 );
+                            ydir = rng( -1, 1 );
                         }
-                    } else {
-                        cur.set_field_intensity( 3 );
-                        int num_bolts = rng( 3, 6 );
-                        for( int i = 0; i < num_bolts; i++ ) {
-                            int xdir = 0;
-                            int ydir = 0;
-                            while( xdir == 0 && ydir == 0 ) {
-                                xdir = rng( -1, 1 );
-                                ydir = rng( -1, 1 );
-                            }
-                            int dist = rng( 4, 12 );
-                            int boltx = p.x;
-                            int bolty = p.y;
-                            for( int n = 0; n < dist; n++ ) {
-                                boltx += xdir;
-                                bolty += ydir;
-                                add_field( tripoint( boltx, bolty, p.z ), fd_electricity, rng( 2, 3 ) );
-                                if( one_in( 4 ) ) {
-                                    if( xdir == 0 ) {
-                                        xdir = rng( 0, 1 ) * 2 - 1;
-                                    } else {
-                                        xdir = 0;
-                                    }
+                        int dist = rng( 4, 12 );
+                        int boltx = p.x;
+                        int bolty = p.y;
+                        for( int n = 0; n < dist; n++ ) {
+                            boltx += xdir;
+                            bolty += ydir;
+                            add_field( tripoint( boltx, bolty, p.z ), fd_electricity, rng( 2, 3 ) );
+                            if( one_in( 4 ) ) {
+                                if( xdir == 0 ) {
+                                    xdir = rng( 0, 1 ) * 2 - 1;
+                                } else {
+                                    xdir = 0;
                                 }
-                                if( one_in( 4 ) ) {
-                                    if( ydir == 0 ) {
-                                        ydir = rng( 0, 1 ) * 2 - 1;
-                                    } else {
-                                        ydir = 0;
-                                    }
+                            }
+                            if( one_in( 4 ) ) {
+                                if( ydir == 0 ) {
+                                    ydir = rng( 0, 1 ) * 2 - 1;
+                                } else {
+                                    ydir = 0;
                                 }
                             }
                         }
                     }
                 }
-                if( curtype == fd_acid_vent ) {
+            }
+            if( curtype == fd_acid_vent ) {
 
-                    if( cur.get_field_intensity() > 1 ) {
-                        if( cur.get_field_age() >= 1_minutes ) {
-                            cur.set_field_intensity( cur.get_field_intensity() - 1 );
-                            cur.set_field_age( 0_turns );
-                        }
-                    } else {
-                        cur.set_field_intensity( 3 );
-                        for( const tripoint &t : points_in_radius( p, 5 ) ) {
-                            const field_entry *acid = get_field( t, fd_acid );
-                            if( acid != nullptr && acid->get_field_intensity() == 0 ) {
-                                int new_intensity = 3 - rl_dist( p, t ) / 2 + ( one_in( 3 ) ? 1 : 0 );
-                                if( new_intensity > 3 ) {
-                                    new_intensity = 3;
-                                }
-                                if( new_intensity > 0 ) {
-                                    add_field( t, fd_acid, new_intensity );
-                                }
+                if( cur.get_field_intensity() > 1 ) {
+                    if( cur.get_field_age() >= 1_minutes ) {
+                        cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                        cur.set_field_age( 0_turns );
+                    }
+                } else {
+                    cur.set_field_intensity( 3 );
+                    for( const tripoint &t : points_in_radius( p, 5 ) ) {
+                        const field_entry *acid = get_field( t, fd_acid );
+                        if( acid != nullptr && acid->get_field_intensity() == 0 ) {
+                            int new_intensity = 3 - rl_dist( p, t ) / 2 + ( one_in( 3 ) ? 1 : 0 );
+                            if( new_intensity > 3 ) {
+                                new_intensity = 3;
+                            }
+                            if( new_intensity > 0 ) {
+                                add_field( t, fd_acid, new_intensity );
                             }
                         }
                     }
                 }
-                if( curtype == fd_bees ) {
-                    // Poor bees are vulnerable to so many other fields.
-                    // TODO: maybe adjust effects based on different fields.
-                    if( curfield.find_field( fd_web ) ||
-                        curfield.find_field( fd_fire ) ||
-                        curfield.find_field( fd_smoke ) ||
-                        curfield.find_field( fd_toxic_gas ) ||
-                        curfield.find_field( fd_tear_gas ) ||
-                        curfield.find_field( fd_relax_gas ) ||
-                        curfield.find_field( fd_nuke_gas ) ||
-                        curfield.find_field( fd_gas_vent ) ||
-                        curfield.find_field( fd_smoke_vent ) ||
-                        curfield.find_field( fd_fungicidal_gas ) ||
-                        curfield.find_field( fd_fire_vent ) ||
-                        curfield.find_field( fd_flame_burst ) ||
-                        curfield.find_field( fd_electricity ) ||
-                        curfield.find_field( fd_fatigue ) ||
-                        curfield.find_field( fd_shock_vent ) ||
-                        curfield.find_field( fd_plasma ) ||
-                        curfield.find_field( fd_laser ) ||
-                        curfield.find_field( fd_dazzling ) ||
-                        curfield.find_field( fd_electricity ) ||
-                        curfield.find_field( fd_incendiary ) ) {
-                        // Kill them at the end of processing.
-                        cur.set_field_intensity( 0 );
-                    } else {
-                        // Bees chase the player if in range, wander randomly otherwise.
-                        if( !g->u.is_underwater() &&
-                            rl_dist( p, g->u.pos() ) < 10 &&
-                            clear_path( p, g->u.pos(), 10, 0, 100 ) ) {
-
-                            std::vector<point> candidate_positions =
-                                squares_in_direction( p.x, p.y, g->u.posx(), g->u.posy() );
-                            for( point &candidate_position : candidate_positions ) {
-                                field &target_field =
-                                    get_field( tripoint( candidate_position, p.z ) );
-                                // Only shift if there are no bees already there.
-                                // TODO: Figure out a way to merge bee fields without allowing
-                                // Them to effectively move several times in a turn depending
-                                // on iteration direction.
-                                if( !target_field.find_field( fd_bees ) ) {
-                                    add_field( tripoint( candidate_position, p.z ), fd_bees,
-                                               cur.get_field_intensity(), cur.get_field_age() );
-                                    cur.set_field_intensity( 0 );
-                                    break;
-                                }
+            }
+            if( curtype == fd_bees ) {
+                // Poor bees are vulnerable to so many other fields.
+                // TODO: maybe adjust effects based on different fields.
+                if( curfield.find_field( fd_web ) ||
+                    curfield.find_field( fd_fire ) ||
+                    curfield.find_field( fd_smoke ) ||
+                    curfield.find_field( fd_toxic_gas ) ||
+                    curfield.find_field( fd_tear_gas ) ||
+                    curfield.find_field( fd_relax_gas ) ||
+                    curfield.find_field( fd_nuke_gas ) ||
+                    curfield.find_field( fd_gas_vent ) ||
+                    curfield.find_field( fd_smoke_vent ) ||
+                    curfield.find_field( fd_fungicidal_gas ) ||
+                    curfield.find_field( fd_fire_vent ) ||
+                    curfield.find_field( fd_flame_burst ) ||
+                    curfield.find_field( fd_electricity ) ||
+                    curfield.find_field( fd_fatigue ) ||
+                    curfield.find_field( fd_shock_vent ) ||
+                    curfield.find_field( fd_plasma ) ||
+                    curfield.find_field( fd_laser ) ||
+                    curfield.find_field( fd_dazzling ) ||
+                    curfield.find_field( fd_electricity ) ||
+                    curfield.find_field( fd_incendiary ) ) {
+                    // Kill them at the end of processing.
+                    cur.set_field_intensity( 0 );
+                } else {
+                    // Bees chase the player if in range, wander randomly otherwise.
+                    if( !g->u.is_underwater() &&
+                        rl_dist( p, g->u.pos() ) < 10 &&
+                        clear_path( p, g->u.pos(), 10, 0, 100 ) ) {
+
+                        std::vector<point> candidate_positions =
+                            squares_in_direction( p.x, p.y, g->u.posx(), g->u.posy() );
+                        for( point &candidate_position : candidate_positions ) {
+                            field &target_field =
+                                get_field( tripoint( candidate_position, p.z ) );
+                            // Only shift if there are no bees already there.
+                            // TODO: Figure out a way to merge bee fields without allowing
+                            // Them to effectively move several times in a turn depending
+                            // on iteration direction.
+                            if( !target_field.find_field( fd_bees ) ) {
+                                add_field( tripoint( candidate_position, p.z ), fd_bees,
+                                           cur.get_field_intensity(), cur.get_field_age() );
+                                cur.set_field_intensity( 0 );
+                                break;
                             }
-                        } else {
-                            spread_gas( cur, p, 5, 0_turns, sblk );
                         }
+                    } else {
+                        spread_gas( cur, p, 5, 0_turns, sblk );
                     }
                 }
-                if( curtype == fd_incendiary ) {
-                    // Needed for variable scope
-                    tripoint dst( p.x + rng( -1, 1 ), p.y + rng( -1, 1 ), p.z );
-                    if( has_flag( TFLAG_FLAMMABLE, dst ) ||
-                        has_flag( TFLAG_FLAMMABLE_ASH, dst ) ||
-                        has_flag( TFLAG_FLAMMABLE_HARD, dst ) ) {
-                        add_field( dst, fd_fire, 1 );
-                    }
-
-                    // Check piles for flammable items and set those on fire
-                    if( flammable_items_at( dst ) ) {
-                        add_field( dst, fd_fire, 1 );
-                    }
-
-                    spread_gas( cur, p, 66, 4_minutes, sblk );
-                    create_hot_air( p, cur.get_field_intensity() );
-                }
-                if( curtype == fd_rubble ) {
-                    // Legacy Stuff
-                    make_rubble( p );
+            }
+            if( curtype == fd_incendiary ) {
+                // Needed for variable scope
+                tripoint dst( p.x + rng( -1, 1 ), p.y + rng( -1, 1 ), p.z );
+                if( has_flag( TFLAG_FLAMMABLE, dst ) ||
+                    has_flag( TFLAG_FLAMMABLE_ASH, dst ) ||
+                    has_flag( TFLAG_FLAMMABLE_HARD, dst ) ) {
+                    add_field( dst, fd_fire, 1 );
                 }
-                if( curtype == fd_fungicidal_gas ) {
-                    spread_gas( cur, p, 120, 1_minutes, sblk );
-                    // Check the terrain and replace it accordingly to simulate the fungus dieing off
-                    const ter_t &ter = map_tile.get_ter_t();
-                    const furn_t &frn = map_tile.get_furn_t();
-                    const int intensity = cur.get_field_intensity();
-                    if( ter.has_flag( "FUNGUS" ) && one_in( 10 / intensity ) ) {
-                        ter_set( p, t_dirt );
-                    }
-                    if( frn.has_flag( "FUNGUS" ) && one_in( 10 / intensity ) ) {
-                        furn_set( p, f_null );
-                    }
+
+                // Check piles for flammable items and set those on fire
+                if( flammable_items_at( dst ) ) {
+                    add_field( dst, fd_fire, 1 );
                 }
 
-                cur.set_field_age( cur.get_field_age() + 1_turns );
-                auto &fdata = cur.get_field_type().obj();
-                if( fdata.half_life > 0_turns && cur.get_field_age() > 0_turns &&
-                    dice( 2, to_turns<int>( cur.get_field_age() ) ) > to_turns<int>( fdata.half_life ) ) {
-                    cur.set_field_age( 0_turns );
-                    cur.set_field_intensity( cur.get_field_intensity() - 1 );
+                spread_gas( cur, p, 66, 4_minutes, sblk );
+                create_hot_air( p, cur.get_field_intensity() );
+            }
+            if( curtype == fd_rubble ) {
+                // Legacy Stuff
+                make_rubble( p );
+            }
+            if( curtype == fd_fungicidal_gas ) {
+                spread_gas( cur, p, 120, 1_minutes, sblk );
+                // Check the terrain and replace it accordingly to simulate the fungus dieing off
+                const ter_t &ter = map_tile.get_ter_t();
+                const furn_t &frn = map_tile.get_furn_t();
+                const int intensity = cur.get_field_intensity();
+                if( ter.has_flag( "FUNGUS" ) && one_in( 10 / intensity ) ) {
+                    ter_set( p, t_dirt );
                 }
-                if( !cur.is_field_alive() ) {
-                    --current_submap->field_count;
-                    curfield.remove_field( it++ );
-                } else {
-                    ++it;
+                if( frn.has_flag( "FUNGUS" ) && one_in( 10 / intensity ) ) {
+                    furn_set( p, f_null );
                 }
             }
+
+            cur.set_field_age( cur.get_field_age() + 1_turns );
+            auto &fdata = cur.get_field_type().obj();
+            if( fdata.half_life > 0_turns && cur.get_field_age() > 0_turns &&
+                dice( 2, to_turns<int>( cur.get_field_age() ) ) > to_turns<int>( fdata.half_life ) ) {
+                cur.set_field_age( 0_turns );
+                cur.set_field_intensity( cur.get_field_intensity() - 1 );
+            }
+            if( !cur.is_field_alive() ) {
+                --current_submap->field_count;
+                curfield.remove_field( it++ );
+                current_submap->field_removed( map_tile.pos() );
+            } else {
+                ++it;
+            }
         }
     }
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
@@ -1333,7 +1326,6 @@ bool map::process_fields_in_submap( submap *const current_submap,
         }
     }
     sblk.commit_modifications();
-    return dirty_transparency_cache;
 }
 
 // This entire function makes very little sense. Why are the rules the way they are? Why does walking into some things destroy them but not others?
@@ -3,11 +3,15 @@
 #include <sstream>
 #include <algorithm>
 #include <exception>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
 
+#include "background_job.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -15,8 +19,10 @@
 #include "game.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "translations.h"
 #include "game_constants.h"
 
@@ -24,16 +30,147 @@
 
 mapbuffer MAPBUFFER;
 
-mapbuffer::mapbuffer() = default;
+struct quad_file {
+    tripoint om_addr;
+    std::string path;
+    /** Serialized quad. Empty if the file does not exist (a saved quad is never empty). */
+    std::string contents;
+};
+
+/**
+ * Background file I/O of the mapbuffer.
+ *
+ * Submaps are serialized and deserialized on the game thread only, that code uses
+ * global state (item types, debugmsg, ...) that is not safe to touch from other threads.
+ * The workers only read and write the files.
+ */
+struct mapbuffer_io {
+    /** Files written by @ref writer, read-only while it runs. */
+    std::vector<quad_file> writes;
+    /** Errors of the last @ref writer run. */
+    std::vector<std::string> write_errors;
+    background_job writer;
+
+    /** Files read by @ref reader, it fills in their contents. */
+    std::vector<quad_file> reads;
+    background_job reader;
+
+    /** Contents of quads that have been read ahead, by path. */
+    std::map<std::string, quad_file> prefetched;
+    /** Quads that have no savefile (yet), so there is no point in reading them again. */
+    std::set<std::string> missing;
+
+    void start_writes() {
+        write_errors.clear();
+        writer.start( [this]() {
+            for( const quad_file &file : writes ) {
+                try {
+                    write_to_file( file.path, [&file]( std::ostream & fout ) {
+                        fout << file.contents;
+                    } );
+                } catch( const std::exception &err ) {
+                    write_errors.push_back( file.path + ": " + err.what() );
+                }
+            }
+        } );
+    }
+
+    void finish_writes() {
+        if( !writer.running() ) {
+            return;
+        }
+        writer.wait();
+        for( const std::string &error : write_errors ) {
+            debugmsg( "Failed to save map file %s", error );
+        }
+        writes.clear();
+    }
+
+    /** The file if it is (still) being written, its contents are what the file will contain. */
+    const quad_file *find_write( const std::string &path ) const {
+        if( !writer.running() ) {
+            return nullptr;
+        }
+        const auto iter = std::find_if( writes.begin(), writes.end(), [&path]( const quad_file & file ) {
+            return file.path == path;
+        } );
+        return iter == writes.end() ? nullptr : &*iter;
+    }
+
+    void start_reads() {
+        reader.start( [this]() {
+            for( quad_file &file : reads ) {
+                std::ifstream fin( file.path, std::ios::binary );
+                if( fin ) {
+                    file.contents.assign( std::istreambuf_iterator<char>( fin ),
+                                          std::istreambuf_iterator<char>() );
+                }
+                if( fin.bad() ) {
+                    file.contents.clear();
+                }
+            }
+        } );
+    }
+
+    /** Moves the results of the reader into @ref prefetched, if it is done (or if wait is true). */
+    void finish_reads( const bool wait ) {
+        if( !reader.running() || ( !wait && !reader.finished() ) ) {
+            return;
+        }
+        reader.wait();
+        for( quad_file &file : reads ) {
+            if( file.contents.empty() ) {
+                missing.insert( file.path );
+            } else {
+                prefetched[file.path] = std::move( file );
+            }
+        }
+        reads.clear();
+    }
+
+    bool is_read( const std::string &path ) const {
+        return reader.running() && std::any_of( reads.begin(), reads.end(),
+        [&path]( const quad_file & file ) {
+            return file.path == path;
+        } );
+    }
+};
+
+static std::string quad_file_path( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    std::stringstream quad_path;
+    quad_path << g->get_world_base_save_path() << "/maps/" <<
+              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
+              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    return quad_path.str();
+}
+
+mapbuffer::mapbuffer() : io( std::make_unique<mapbuffer_io>() )
+{
+}
 
 mapbuffer::~mapbuffer()
 {
     reset();
 }
 
+void mapbuffer::flush()
+{
+    io->finish_writes();
+    io->finish_reads( true );
+}
+
 void mapbuffer::reset()
 {
-    for( auto &elem : submaps ) {
+    // The game resets MAPBUFFER again when it is destroyed, which may happen after
+    // MAPBUFFER itself (and its I/O) was destroyed at exit.
+    if( io != nullptr ) {
+        flush();
+        io->prefetched.clear();
+        io->missing.clear();
+    }
+    for( const auto &elem : submaps ) {
         delete elem.second;
     }
     submaps.clear();
@@ -41,13 +178,7 @@ void mapbuffer::reset()
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 {
-    if( submaps.count( p ) != 0 ) {
-        return false;
-    }
-
-    submaps[p] = sm;
-
-    return true;
+    return submaps.insert( p, sm );
 }
 
 bool mapbuffer::add_submap( int x, int y, int z, submap *sm )
@@ -71,13 +202,12 @@ bool mapbuffer::add_submap( int x, int y, int z, std::unique_ptr<submap> &sm )
 
 void mapbuffer::remove_submap( tripoint addr )
 {
-    auto m_target = submaps.find( addr );
-    if( m_target == submaps.end() ) {
+    submap *const target = submaps.erase( addr );
+    if( target == nullptr ) {
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
         return;
     }
-    delete m_target->second;
-    submaps.erase( m_target );
+    delete target;
 }
 
 submap *mapbuffer::lookup_submap( int x, int y, int z )
@@ -89,8 +219,8 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
 {
     dbg( D_INFO ) << "mapbuffer::lookup_submap( x[" << p.x << "], y[" << p.y << "], z[" << p.z << "])";
 
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    submap *const sm = submaps.find( p );
+    if( sm == nullptr ) {
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -99,11 +229,67 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
-    return iter->second;
+    return sm;
+}
+
+void mapbuffer::prefetch( const tripoint &sm_min, const tripoint &sm_max )
+{
+    io->finish_reads( false );
+    if( io->reader.running() || !get_option<bool>( "ASYNC_MAP_IO" ) ) {
+        return;
+    }
+    const tripoint om_min = sm_to_omt_copy( sm_min );
+    const tripoint om_max = sm_to_omt_copy( sm_max );
+    for( int z = om_min.z; z <= om_max.z; z++ ) {
+        for( int x = om_min.x; x <= om_max.x; x++ ) {
+            for( int y = om_min.y; y <= om_max.y; y++ ) {
+                const tripoint om_addr( x, y, z );
+                if( submaps.find( omt_to_sm_copy( om_addr ) ) != nullptr ) {
+                    continue;
+                }
+                const std::string path = quad_file_path( om_addr );
+                if( io->missing.count( path ) != 0 || io->prefetched.count( path ) != 0 ) {
+                    continue;
+                }
+                if( const quad_file *written = io->find_write( path ) ) {
+                    // Saved recently, no need to go to the disk.
+                    io->prefetched[path] = *written;
+                } else {
+                    io->reads.push_back( quad_file{ om_addr, path, std::string() } );
+                }
+            }
+        }
+    }
+    if( !io->reads.empty() ) {
+        io->start_reads();
+    }
+}
+
+void mapbuffer::load_prefetched( int max_quads )
+{
+    io->finish_reads( false );
+    for( auto iter = io->prefetched.begin(); iter != io->prefetched.end() && max_quads > 0; ) {
+        const tripoint sm_addr = omt_to_sm_copy( iter->second.om_addr );
+        if( submaps.find( sm_addr ) == nullptr ) {
+            try {
+                std::istringstream fin( iter->second.contents );
+                deserialize( fin );
+            } catch( const std::exception &err ) {
+                debugmsg( "Failed to load submap (%d,%d,%d): %s", sm_addr.x, sm_addr.y, sm_addr.z,
+                          err.what() );
+            }
+            max_quads--;
+        }
+        iter = io->prefetched.erase( iter );
+    }
 }
 
 void mapbuffer::save( bool delete_after_save )
 {
+    // The previous save must be on disk before its files are written again.
+    io->finish_writes();
+    const bool async = get_option<bool>( "ASYNC_MAP_IO" );
+
     std::stringstream map_directory;
     map_directory << g->get_world_base_save_path() << "/maps";
     assure_dir_exist( map_directory.str() );
@@ -118,7 +304,8 @@ void mapbuffer::save( bool delete_after_save )
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
     int next_report = 0;
-    for( auto &elem : submaps ) {
+    // The index is unordered, sort so the quads of a segment are written together.
+    for( const tripoint &sm_addr : submaps.sorted_keys() ) {
         if( num_total_submaps > 100 && num_saved_submaps >= next_report ) {
             popup_nowait( _( "Please wait as the map saves [%d/%d]" ),
                           num_saved_submaps, num_total_submaps );
@@ -129,7 +316,7 @@ void mapbuffer::save( bool delete_after_save )
         // we're saving a 2x2 quad of submaps at a time.
         // Submaps are generated in quads, so we know if we have one member of a quad,
         // we have the rest of it, if that assumption is broken we have REAL problems.
-        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        const tripoint om_addr = sm_to_omt_copy( sm_addr );
         if( saved_submaps.count( om_addr ) != 0 ) {
             // Already handled this one.
             continue;
@@ -155,17 +342,24 @@ void mapbuffer::save( bool delete_after_save )
                    delete_after_save || zlev_del ||
                    om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
                    om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+                   om_addr.y > map_origin.y + HALF_MAPSIZE, async );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+
+    // Quads that had no savefile may have one now. Prefetched quads are not in the
+    // buffer, so they were not written and stay valid.
+    io->missing.clear();
+    if( !io->writes.empty() ) {
+        io->start_writes();
+    }
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           bool delete_after_save, bool async )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -180,7 +374,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
+        submap *sm = submaps.find( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
@@ -190,7 +384,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                if( submaps.find( submap_addr ) != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -199,74 +393,116 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr];
-
-            if( sm == nullptr ) {
-                continue;
+    std::vector<std::pair<tripoint, const submap *>> quad;
+    for( auto &submap_addr : submap_addrs ) {
+        const submap *sm = submaps.find( submap_addr );
+        if( sm != nullptr ) {
+            quad.emplace_back( submap_addr, sm );
+            if( delete_after_save ) {
+                submaps_to_delete.push_back( submap_addr );
             }
+        }
+    }
 
-            jsout.start_object();
-
-            jsout.member( "version", savegame_version );
-            jsout.member( "coordinates" );
+    // Don't create the directory if it would be empty
+    assure_dir_exist( dirname );
+    const bool binary = get_option<bool>( "BINARY_MAP_SAVES" );
+    const auto write_quad = [&]( std::ostream & fout ) {
+        serialize( fout, quad, binary );
+    };
+    if( async ) {
+        std::ostringstream fout;
+        write_quad( fout );
+        io->writes.push_back( quad_file{ om_addr, filename, fout.str() } );
+    } else {
+        write_to_file( filename, write_quad );
+    }
+}
 
-            jsout.start_array();
-            jsout.write( submap_addr.x );
-            jsout.write( submap_addr.y );
-            jsout.write( submap_addr.z );
-            jsout.end_array();
+void mapbuffer::serialize( std::ostream &fout,
+                           const std::vector<std::pair<tripoint, const submap *>> &quad, bool binary )
+{
+    if( binary ) {
+        submap_binary::write( fout, quad );
+        return;
+    }
+    JsonOut jsout( fout );
+    jsout.start_array();
+    for( const auto &elem : quad ) {
+        jsout.start_object();
 
-            sm->store( jsout );
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
 
-            jsout.end_object();
+        jsout.start_array();
+        jsout.write( elem.first.x );
+        jsout.write( elem.first.y );
+        jsout.write( elem.first.z );
+        jsout.end_array();
 
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
-            }
-        }
+        elem.second->store( jsout );
 
-        jsout.end_array();
-    } );
+        jsout.end_object();
+    }
+    jsout.end_array();
 }
 
-// We're reading in way too many entities here to mess around with creating sub-objects and
-// seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
-    const tripoint segment_addr = omt_to_seg_copy( om_addr );
-    std::stringstream quad_path;
-    quad_path << g->get_world_base_save_path() << "/maps/" <<
-              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
-              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    const std::string quad_path = quad_file_path( om_addr );
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path.str(),
-                                       std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
-        // If it doesn't exist, trigger generating it.
+    if( io->is_read( quad_path ) ) {
+        io->finish_reads( true );
+    }
+    const auto prefetched = io->prefetched.find( quad_path );
+    if( prefetched != io->prefetched.end() ) {
+        const quad_file file = std::move( prefetched->second );
+        io->prefetched.erase( prefetched );
+        std::istringstream fin( file.contents );
+        deserialize( fin );
+    } else if( io->missing.count( quad_path ) != 0 ) {
+        // Not saved yet, trigger generating it.
         return nullptr;
+    } else if( const quad_file *written = io->find_write( quad_path ) ) {
+        // Still being written, use what is written instead of waiting for the disk.
+        std::istringstream fin( written->contents );
+        deserialize( fin );
+    } else {
+        if( !read_from_file_optional( quad_path, [this]( std::istream & fin ) {
+        deserialize( fin );
+        } ) ) {
+            // If it doesn't exist, trigger generating it.
+            return nullptr;
+        }
     }
-    if( submaps.count( p ) == 0 ) {
+    submap *const sm = submaps.find( p );
+    if( sm == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
-                  quad_path.str(), p.x, p.y, p.z );
-        return nullptr;
+                  quad_path, p.x, p.y, p.z );
     }
-    return submaps[ p ];
+    return sm;
 }
 
-void mapbuffer::deserialize( JsonIn &jsin )
+void mapbuffer::deserialize( std::istream &fin )
 {
+    deserialize( fin, [this]( const tripoint & p, std::unique_ptr<submap> &sm ) {
+        if( !add_submap( p, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", p.x, p.y, p.z );
+        }
+    } );
+}
+
+// We're reading in way too many entities here to mess around with creating sub-objects and
+// seeking around in them, so we're using the json streaming API.
+void mapbuffer::deserialize( std::istream &fin, const submap_binary::add_submap_callback &add )
+{
+    if( submap_binary::is_binary( fin ) ) {
+        submap_binary::read( fin, add );
+        return;
+    }
+    JsonIn jsin( fin );
     jsin.start_array();
     while( !jsin.end_array() ) {
         std::unique_ptr<submap> sm = std::make_unique<submap>();
@@ -291,9 +527,40 @@ void mapbuffer::deserialize( JsonIn &jsin )
             }
         }
 
-        if( !add_submap( submap_coordinates, sm ) ) {
-            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
-                      submap_coordinates.z );
+        add( submap_coordinates, sm );
+    }
+}
+
+int mapbuffer::convert_saves( const bool binary )
+{
+    flush();
+    io->prefetched.clear();
+
+    const std::string map_directory = g->get_world_base_save_path() + "/maps";
+    int converted = 0;
+    for( const std::string &path : get_files_from_path( ".map", map_directory, true, true ) ) {
+        std::vector<std::pair<tripoint, std::unique_ptr<submap>>> loaded;
+        bool is_binary = false;
+        const bool read = read_from_file( path, [&]( std::istream & fin ) {
+            is_binary = submap_binary::is_binary( fin );
+            if( is_binary != binary ) {
+                deserialize( fin, [&loaded]( const tripoint & p, std::unique_ptr<submap> &sm ) {
+                    loaded.emplace_back( p, std::move( sm ) );
+                } );
+            }
+        } );
+        if( !read || is_binary == binary ) {
+            continue;
+        }
+        std::vector<std::pair<tripoint, const submap *>> quad;
+        for( const auto &elem : loaded ) {
+            quad.emplace_back( elem.first, elem.second.get() );
+        }
+        if( write_to_file( path, [&]( std::ostream & fout ) {
+        serialize( fout, quad, binary );
+        }, _( "map file" ) ) ) {
+            converted++;
         }
     }
+    return converted;
 }
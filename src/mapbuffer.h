@@ -2,15 +2,19 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
+#include <iosfwd>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "point.h"
+#include "submap_binary.h"
+#include "submap_index.h"
 
 class submap;
-class JsonIn;
+struct mapbuffer_io;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -24,6 +28,8 @@ class mapbuffer
         /** Store all submaps in this instance into savefiles.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * If the ASYNC_MAP_IO option is enabled, the submaps are serialized here, but the
+         * files are written on a background thread, see @ref flush.
          **/
         void save( bool delete_after_save = false );
 
@@ -57,14 +63,36 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
-    private:
-        using submap_map_t = std::map<tripoint, submap *>;
+        /**
+         * Start reading the savefiles of the submaps in the given range (absolute submap
+         * coordinates, inclusive) on a background thread, so @ref lookup_submap does not
+         * have to wait for the disk when it needs them.
+         * Does nothing if the previous prefetch is still running or if the ASYNC_MAP_IO
+         * option is disabled.
+         */
+        void prefetch( const tripoint &sm_min, const tripoint &sm_max );
+        /**
+         * Deserialize up to max_quads of the prefetched quads into the buffer. Call this
+         * regularly, so the work is spread over several turns instead of happening all at
+         * once when the map is shifted.
+         */
+        void load_prefetched( int max_quads );
+        /** Wait for all background reads and writes to finish. */
+        void flush();
 
-    public:
-        inline submap_map_t::iterator begin() {
+        /**
+         * Rewrites all map files of the current world in the binary (see submap_binary.h)
+         * or the JSON format. Both formats can always be loaded, this is for migrating
+         * existing worlds after changing the BINARY_MAP_SAVES option.
+         * @return The number of converted files.
+         */
+        int convert_saves( bool binary );
+
+        /** Iteration over all buffered submaps, in no particular order. */
+        inline submap_index::const_iterator begin() const {
             return submaps.begin();
         }
-        inline submap_map_t::iterator end() {
+        inline submap_index::const_iterator end() const {
             return submaps.end();
         }
 
@@ -73,11 +101,16 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
-        void deserialize( JsonIn &jsin );
+        /** Reads a map file in either format and adds its submaps to the buffer. */
+        void deserialize( std::istream &fin );
+        static void deserialize( std::istream &fin, const submap_binary::add_submap_callback &add );
+        static void serialize( std::ostream &fout,
+                               const std::vector<std::pair<tripoint, const submap *>> &quad, bool binary );
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
-        submap_map_t submaps;
+                        bool delete_after_save, bool async );
+        submap_index submaps;
+        std::unique_ptr<mapbuffer_io> io;
 };
 
 extern mapbuffer MAPBUFFER;
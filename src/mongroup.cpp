@@ -79,6 +79,118 @@ float mongroup::avg_speed() const
     return avg_speed;
 }
 
+tripoint mongroup_map::cell_of( const tripoint &p )
+{
+    // Rounds towards negative infinity, groups can be outside of the overmap.
+    const auto cell = []( const int v ) {
+        return v >= 0 ? v / cell_size : ( v - cell_size + 1 ) / cell_size;
+    };
+    return tripoint( cell( p.x ), cell( p.y ), p.z );
+}
+
+void mongroup_map::clear()
+{
+    groups.clear();
+    cells.clear();
+}
+
+void mongroup_map::insert( mongroup group )
+{
+    cells[cell_of( group.pos )].push_back( groups.size() );
+    groups.push_back( std::move( group ) );
+}
+
+void mongroup_map::move( mongroup &group, const tripoint &pos )
+{
+    const tripoint old_cell = cell_of( group.pos );
+    const tripoint new_cell = cell_of( pos );
+    group.pos = pos;
+    if( old_cell == new_cell ) {
+        return;
+    }
+    const size_t index = &group - groups.data();
+    std::vector<size_t> &old_indices = cells[old_cell];
+    old_indices.erase( std::find( old_indices.begin(), old_indices.end(), index ) );
+    if( old_indices.empty() ) {
+        cells.erase( old_cell );
+    }
+    cells[new_cell].push_back( index );
+}
+
+void mongroup_map::erase( const size_t index )
+{
+    const tripoint cell = cell_of( groups[index].pos );
+    std::vector<size_t> &indices = cells[cell];
+    indices.erase( std::find( indices.begin(), indices.end(), index ) );
+    if( indices.empty() ) {
+        cells.erase( cell );
+    }
+    const size_t last = groups.size() - 1;
+    if( index != last ) {
+        groups[index] = std::move( groups[last] );
+        std::vector<size_t> &moved_indices = cells[cell_of( groups[index].pos )];
+        *std::find( moved_indices.begin(), moved_indices.end(), last ) = index;
+    }
+    groups.pop_back();
+}
+
+void mongroup_map::remove_if( const std::function<bool( const mongroup & )> &pred )
+{
+    for( size_t i = 0; i < groups.size(); ) {
+        if( pred( groups[i] ) ) {
+            // The last group is moved to i, check that one next.
+            erase( i );
+        } else {
+            ++i;
+        }
+    }
+}
+
+std::vector<mongroup> mongroup_map::extract_if( const std::function<bool( const mongroup & )>
+        &pred )
+{
+    std::vector<mongroup> extracted;
+    for( size_t i = 0; i < groups.size(); ) {
+        if( pred( groups[i] ) ) {
+            // The moved-from group keeps its position, which erase needs.
+            mongroup group = std::move( groups[i] );
+            erase( i );
+            extracted.push_back( std::move( group ) );
+        } else {
+            ++i;
+        }
+    }
+    return extracted;
+}
+
+std::vector<mongroup *> mongroup_map::at( const tripoint &p )
+{
+    std::vector<mongroup *> result;
+    const auto iter = cells.find( cell_of( p ) );
+    if( iter != cells.end() ) {
+        for( const size_t index : iter->second ) {
+            if( groups[index].pos == p ) {
+                result.push_back( &groups[index] );
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<const mongroup *> mongroup_map::at( const tripoint &p ) const
+{
+    std::vector<const mongroup *> result;
+    const auto iter = cells.find( cell_of( p ) );
+    if( iter != cells.end() ) {
+        for( const size_t index : iter->second ) {
+            if( groups[index].pos == p ) {
+                result.push_back( &groups[index] );
+            }
+        }
+    }
+    return result;
+}
+
 const MonsterGroup &MonsterGroupManager::GetUpgradedMonsterGroup( const mongroup_id &group )
 {
     const MonsterGroup *groupptr = &group.obj();
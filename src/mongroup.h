@@ -2,8 +2,11 @@
 #ifndef MONGROUP_H
 #define MONGROUP_H
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -154,6 +157,64 @@ struct mongroup {
     void serialize( JsonOut &jsout ) const;
 };
 
+/**
+ * The monster groups of an overmap, stored contiguously and indexed by a coarse grid of
+ * their positions (submap coordinates relative to the overmap, groups may be outside of it).
+ * Finding the groups at a position only looks at the groups of one grid cell, and moving a
+ * group only updates the index when it enters another cell.
+ *
+ * Removing a group moves the last group into its place, so adding or removing groups
+ * invalidates pointers to groups and does not keep their order.
+ */
+class mongroup_map
+{
+    public:
+        using iterator = std::vector<mongroup>::iterator;
+        using const_iterator = std::vector<mongroup>::const_iterator;
+
+        iterator begin() {
+            return groups.begin();
+        }
+        iterator end() {
+            return groups.end();
+        }
+        const_iterator begin() const {
+            return groups.begin();
+        }
+        const_iterator end() const {
+            return groups.end();
+        }
+        size_t size() const {
+            return groups.size();
+        }
+        bool empty() const {
+            return groups.empty();
+        }
+
+        void clear();
+        void insert( mongroup group );
+        /** Changes the position of a group in this map, mongroup::pos must not be set directly. */
+        void move( mongroup &group, const tripoint &pos );
+        /** Removes the groups for which pred returns true, pred must not change this map. */
+        void remove_if( const std::function<bool( const mongroup & )> &pred );
+        /** Like @ref remove_if, but returns the removed groups. */
+        std::vector<mongroup> extract_if( const std::function<bool( const mongroup & )> &pred );
+
+        /** The groups at the position. */
+        std::vector<mongroup *> at( const tripoint &p );
+        std::vector<const mongroup *> at( const tripoint &p ) const;
+
+    private:
+        // Size of the grid cells in submaps.
+        static constexpr int cell_size = 4;
+        static tripoint cell_of( const tripoint &p );
+        void erase( size_t index );
+
+        std::vector<mongroup> groups;
+        // Indices into groups of the groups in each cell.
+        std::unordered_map<tripoint, std::vector<size_t>> cells;
+};
+
 class MonsterGroupManager
 {
     public:
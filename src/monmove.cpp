@@ -11,6 +11,7 @@
 
 #include "avatar.h"
 #include "bionics.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "field.h"
 #include "game.h"
@@ -217,7 +218,60 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return INT_MAX;
 }
 
-void monster::plan( const mfactions &factions )
+// Friendly monsters are all on the player's team.
+static mfaction_id planning_faction( const monster &mon )
+{
+    static const mfaction_str_id playerfaction( "player" );
+    return mon.friendly == 0 ? mon.faction : mfaction_id( playerfaction );
+}
+
+void monster::add_planning_sight_lines( std::vector<std::pair<tripoint, tripoint>> &lines ) const
+{
+    // Same range and candidates as in plan, lines to the player don't use map::sees.
+    const int max_sight = std::max( 1, max_sight_range() );
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const auto add_line = [&]( const Creature & critter ) {
+        const int distance = rl_dist( pos(), critter.pos() );
+        if( distance > 1 && distance <= max_sight && ( fov_3d || posz() == critter.posz() ) ) {
+            lines.emplace_back( pos(), critter.pos() );
+        }
+    };
+    const auto add_lines = [&]( const Creature_tracker::monster_filter &predicate ) {
+        for( const monster *const mon : tracker.find_in_radius( pos(), max_sight, predicate ) ) {
+            add_line( *mon );
+        }
+    };
+
+    if( friendly != 0 ) {
+        if( has_effect( effect_docile ) ) {
+            return;
+        }
+        add_lines( []( const monster & tmp ) {
+            return tmp.friendly == 0;
+        } );
+    }
+    for( const npc &who : g->all_npcs() ) {
+        const auto faction_att = faction.obj().attitude( who.get_monster_faction() );
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY ) {
+            add_line( who );
+        }
+    }
+    if( friendly == 0 ) {
+        add_lines( [this]( const monster & mon ) {
+            const auto faction_att = faction.obj().attitude( planning_faction( mon ) );
+            return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+        } );
+    }
+    // plan only looks at allies if it ends up without a target, which isn't known yet.
+    if( ( has_flag( MF_GROUP_MORALE ) && morale < type->morale ) || has_flag( MF_SWARMS ) ) {
+        const mfaction_id actual_faction = planning_faction( *this );
+        add_lines( [&]( const monster & mon ) {
+            return planning_faction( mon ) == actual_faction;
+        } );
+    }
+}
+
+void monster::plan()
 {
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
@@ -237,6 +291,12 @@ void monster::plan( const mfactions &factions )
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
+    // Only monsters within sight range can be rated as targets, so there is no need to
+    // look at the rest of them. sees() accepts adjacent creatures whatever the range, and
+    // never anything beyond max_sight_range, however bright the light.
+    const int max_sight = std::max( 1, max_sight_range() );
+    const Creature_tracker &tracker = *g->critter_tracker;
+
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
     if( friendly == 0 && sees( g->u ) && !has_flag( MF_PET_WONT_FOLLOW ) ) {
         dist = rate_target( g->u, dist, smart_planning );
@@ -263,26 +323,29 @@ void monster::plan( const mfactions &factions )
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
-                    // baby nearby; is the player too close?
-                    dist = tmp.rate_target( g->u, dist, smart_planning );
-                    if( dist <= 3 ) {
-                        //proximity to baby; monster gets furious and less likely to flee
-                        anger += angers_cub_threatened;
-                        morale += angers_cub_threatened / 2;
-                    }
+            const auto is_baby = [this]( const monster & tmp ) {
+                return type->baby_monster == tmp.type->id;
+            };
+            // Babies further away can not see the player.
+            for( monster *const tmp : tracker.find_in_radius( g->u.pos(), MAX_VIEW_DISTANCE, is_baby ) ) {
+                // baby nearby; is the player too close?
+                dist = tmp->rate_target( g->u, dist, smart_planning );
+                if( dist <= 3 ) {
+                    //proximity to baby; monster gets furious and less likely to flee
+                    anger += angers_cub_threatened;
+                    morale += angers_cub_threatened / 2;
                 }
             }
         }
     } else if( friendly != 0 && !docile ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &tmp;
-                    dist = rating;
-                }
+        const auto is_hostile = []( const monster & tmp ) {
+            return tmp.friendly == 0;
+        };
+        for( monster *const tmp : tracker.find_in_radius( pos(), max_sight, is_hostile ) ) {
+            float rating = rate_target( *tmp, dist, smart_planning );
+            if( rating < dist ) {
+                target = tmp;
+                dist = rating;
             }
         }
     }
@@ -335,41 +398,33 @@ void monster::plan( const mfactions &factions )
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
+        const auto is_enemy = [&]( const monster & mon ) {
+            const auto faction_att = faction.obj().attitude( planning_faction( mon ) );
+            return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+        };
+        for( monster *const mon_ptr : tracker.find_in_radius( pos(), max_sight, is_enemy ) ) {
+            monster &mon = *mon_ptr;
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
             }
-
-            for( monster *const mon_ptr : fac.second ) {
-                monster &mon = *mon_ptr;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
-                }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
             }
         }
     }
 
     // Friendly monsters here
     // Avoid for hordes of same-faction stuff or it could get expensive
-    const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
-    const auto &myfaction_iter = factions.find( actual_faction );
-    if( myfaction_iter == factions.end() ) {
-        DebugLog( D_ERROR, D_GAME ) << disp_name() << " tried to find faction "
-                                    << actual_faction.id().str()
-                                    << " which wasn't loaded in game::monmove";
-        swarms = false;
-        group_morale = false;
-    }
+    const mfaction_id actual_faction = planning_faction( *this );
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( monster *const mon_ptr : myfaction_iter->second ) {
+        const auto is_ally = [&]( const monster & mon ) {
+            return planning_faction( mon ) == actual_faction;
+        };
+        for( monster *const mon_ptr : tracker.find_in_radius( pos(), max_sight, is_ally ) ) {
             monster &mon = *mon_ptr;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
@@ -41,7 +41,6 @@ enum class mon_trigger;
 
 class monster;
 
-using mfactions = std::map< mfaction_id, std::set< monster * > >;
 
 class mon_special_attack
 {
@@ -194,7 +193,12 @@ class monster : public Creature
         float rate_target( Creature &c, float best, bool smart = false ) const;
         // Pass all factions to mon, so that hordes of same-faction mons
         // do not iterate over each other
-        void plan( const mfactions &factions );
+        void plan();
+        /**
+         * Adds the lines of sight (from this monster to others) that @ref plan might check
+         * to lines, so they can be precomputed with @ref map::precompute_sees.
+         */
+        void add_planning_sight_lines( std::vector<std::pair<tripoint, tripoint>> &lines ) const;
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
         void shove_vehicle( const tripoint &remote_destination,
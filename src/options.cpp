@@ -48,6 +48,7 @@ int message_ttl;
 int message_cooldown;
 bool fov_3d;
 bool tile_iso;
+bool row_shadowcasting;
 
 std::map<std::string, std::string> TILESETS; // All found tilesets: <name, tileset_dir>
 std::map<std::string, std::string> SOUNDPACKS; // All found soundpacks: <name, soundpack_dir>
@@ -1848,6 +1849,46 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "ROW_SHADOWCASTING", "debug", translate_marker( "Row based shadowcasting" ),
+         translate_marker( "If true, field of vision and light are calculated one row at a time instead of recursively.  The result is the same, only the speed differs." ),
+         false
+       );
+
+    add( "TURN_PROFILE_CSV", "debug", translate_marker( "Log turn timings" ),
+         translate_marker( "If true, the time spent in each subsystem during a turn is appended to turn_profile.csv in the config directory.  Only available if the game was compiled with the turn profiler." ),
+         false
+       );
+
+    add( "ASYNC_MAP_IO", "debug", translate_marker( "Background map I/O" ),
+         translate_marker( "If true, map files are written on a background thread and the map ahead of the player is read before it is needed." ),
+         false
+       );
+
+    add( "PARALLEL_MAP_CACHE", "debug", translate_marker( "Build map caches in parallel" ),
+         translate_marker( "If true and the world is in z-level mode, the per z-level map caches are built on several threads.  The result is the same as building them one after another." ),
+         false
+       );
+
+    add( "PARALLEL_MONSTER_PLANNING", "debug", translate_marker( "Precompute monster sight in parallel" ),
+         translate_marker( "If true, the lines of sight monsters check when planning their moves are walked on several threads at the start of each turn.  Monsters still plan and move one after another, with the same results." ),
+         false
+       );
+
+    add( "DATA_SNAPSHOT", "debug", translate_marker( "Skip checks of unchanged data" ),
+         translate_marker( "If true, a hash of the game version and the json files that passed all consistency checks is kept in the config directory.  As long as the hash matches, the consistency checks of items, monsters, terrain, furniture and requirements are skipped on start.  The data is still loaded as usual." ),
+         false
+       );
+
+    add( "DATA_SNAPSHOT_VERIFY", "debug", translate_marker( "Verify unchanged data" ),
+         translate_marker( "If true, all consistency checks run even if the hash of the game data matches, and items, monsters, terrain, furniture, recipes and requirements whose basic properties (such as weight, stats, flags or components) differ from the last checked data are reported.  Other differences are not detected." ),
+         false
+       );
+
+    add( "OVERMAP_PREGENERATION", "debug", translate_marker( "Overmap pregeneration distance" ),
+         translate_marker( "If greater than 0, new overmaps are generated on a background thread once the player is within this many overmap tiles of them.  They are the same as overmaps generated when they are needed.  0 disables it." ),
+         0, OMAPX / 2, 0
+       );
+
     add( "ENCODING_CONV", "debug", translate_marker( "Experimental path name encoding conversion" ),
          translate_marker( "If true, file path names are going to be transcoded from system encoding to UTF-8 when reading and will be transcoded back when writing.  Mainly for CJK Windows users." ),
          true
@@ -2006,6 +2047,11 @@ void options_manager::add_options_world_default()
          true
        );
 
+    add( "BINARY_MAP_SAVES", "world_default", translate_marker( "Binary map saves" ),
+         translate_marker( "If true, map files are saved in a compact binary format instead of JSON, which is smaller and faster to load.  Both formats can always be loaded, use the debug menu to convert existing map files." ),
+         false
+       );
+
     mOptionsSort["world_default"]++;
 
     add( "ALIGN_STAIRS", "world_default", translate_marker( "Align up and down stairs" ),
@@ -2786,6 +2832,7 @@ bool options_manager::save()
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
+    row_shadowcasting = ::get_option<bool>( "ROW_SHADOWCASTING" );
 
     update_music_volume();
 
@@ -2816,6 +2863,7 @@ void options_manager::load()
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
+    row_shadowcasting = ::get_option<bool>( "ROW_SHADOWCASTING" );
     calendar::set_eternal_season( ::get_option<bool>( "ETERNAL_SEASON" ) );
     calendar::set_season_length( ::get_option<int>( "SEASON_LENGTH" ) );
 #if defined(SDL_SOUND)
@@ -1082,6 +1082,12 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = get_enabled_specials();
+    populate( enabled_specials );
+}
+
+overmap_special_batch overmap::get_enabled_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
 
@@ -1125,7 +1131,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -1154,9 +1160,47 @@ void overmap::init_layers()
             }
         }
     }
+    build_ter_index();
 }
 
-oter_id &overmap::ter( const int x, const int y, const int z )
+void overmap::build_ter_index()
+{
+    static_assert( OMAPX % ter_index_block == 0 && OMAPY % ter_index_block == 0,
+                   "the terrain index blocks must cover the overmap exactly" );
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        std::unordered_map<oter_id, ter_block_counts> &index = ter_index[k];
+        index.clear();
+        // Neighbouring tiles mostly have the same terrain, this saves most of the lookups.
+        oter_id last = layer[k].terrain[0][0];
+        ter_block_counts *counts = &index[last];
+        for( int i = 0; i < OMAPX; ++i ) {
+            for( int j = 0; j < OMAPY; ++j ) {
+                const oter_id &cur = layer[k].terrain[i][j];
+                if( cur != last ) {
+                    last = cur;
+                    counts = &index[cur];
+                }
+                ++( *counts )[ter_index_block_of( point( i, j ) )];
+            }
+        }
+    }
+}
+
+void overmap::add_special_placement( const tripoint &p, const overmap_special_id &id )
+{
+    const auto iter = overmap_special_placements.find( p );
+    if( iter != overmap_special_placements.end() ) {
+        if( iter->second == id ) {
+            return;
+        }
+        std::vector<tripoint> &positions = overmap_special_positions[iter->second];
+        positions.erase( std::remove( positions.begin(), positions.end(), p ), positions.end() );
+    }
+    overmap_special_placements[p] = id;
+    overmap_special_positions[id].push_back( p );
+}
+
+const oter_id &overmap::ter( const int x, const int y, const int z ) const
 {
     if( !inbounds( tripoint( x, y, z ) ) ) {
         return ot_null;
@@ -1165,11 +1209,32 @@ oter_id &overmap::ter( const int x, const int y, const int z )
     return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
 
-oter_id &overmap::ter( const tripoint &p )
+const oter_id &overmap::ter( const tripoint &p ) const
 {
     return ter( p.x, p.y, p.z );
 }
 
+void overmap::ter_set( const int x, const int y, const int z, const oter_id &id )
+{
+    ter_set( tripoint( x, y, z ), id );
+}
+
+void overmap::ter_set( const tripoint &p, const oter_id &id )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    oter_id &current = layer[p.z + OVERMAP_DEPTH].terrain[p.x][p.y];
+    if( current == id ) {
+        return;
+    }
+    std::unordered_map<oter_id, ter_block_counts> &index = ter_index[p.z + OVERMAP_DEPTH];
+    const int block = ter_index_block_of( p.xy() );
+    --index[current][block];
+    ++index[id][block];
+    current = id;
+}
+
 const oter_id overmap::get_ter( const int x, const int y, const int z ) const
 {
     if( !inbounds( tripoint( x, y, z ) ) ) {
@@ -1220,19 +1285,19 @@ bool overmap::is_explored( const int x, const int y, const int z ) const
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
 {
-    const auto matching_range = zg.equal_range( candidate.pos );
-    return std::find_if( matching_range.first, matching_range.second,
-    [candidate]( const std::pair<tripoint, mongroup> &match ) {
+    const std::vector<const mongroup *> matching = zg.at( candidate.pos );
+    return std::find_if( matching.begin(), matching.end(),
+    [candidate]( const mongroup * match ) {
         // This is extra strict since we're using it to test serialization.
-        return candidate.type == match.second.type && candidate.pos == match.second.pos &&
-               candidate.radius == match.second.radius &&
-               candidate.population == match.second.population &&
-               candidate.target == match.second.target &&
-               candidate.interest == match.second.interest &&
-               candidate.dying == match.second.dying &&
-               candidate.horde == match.second.horde &&
-               candidate.diffuse == match.second.diffuse;
-    } ) != matching_range.second;
+        return candidate.type == match->type && candidate.pos == match->pos &&
+               candidate.radius == match->radius &&
+               candidate.population == match->population &&
+               candidate.target == match->target &&
+               candidate.interest == match->interest &&
+               candidate.dying == match->dying &&
+               candidate.horde == match->horde &&
+               candidate.diffuse == match->diffuse;
+    } ) != matching.end();
 }
 
 bool overmap::monster_check( const std::pair<tripoint, monster> &candidate ) const
@@ -1444,11 +1509,54 @@ void overmap::set_scent( const tripoint &loc, const scent_trace &new_scent )
     scents[loc] = new_scent;
 }
 
-void overmap::generate( const overmap *north, const overmap *east,
-                        const overmap *south, const overmap *west,
+// Seed of the random engine an overmap is generated with.
+static unsigned int generation_seed( const unsigned int world_seed, const point &pos )
+{
+    uint64_t seed = world_seed;
+    const auto mix = [&seed]( const int v ) {
+        seed = ( seed ^ static_cast<uint32_t>( v ) ) * 1099511628211ULL;
+        seed ^= seed >> 29;
+    };
+    mix( pos.x );
+    mix( pos.y );
+    return static_cast<unsigned int>( seed ^ ( seed >> 32 ) );
+}
+
+overmap_border::overmap_border( const overmap &om ) : roads_out( om.roads_out )
+{
+    for( int x = 0; x < OMAPX; x++ ) {
+        north_edge[x] = om.get_ter( x, 0, 0 );
+        south_edge[x] = om.get_ter( x, OMAPY - 1, 0 );
+    }
+    for( int y = 0; y < OMAPY; y++ ) {
+        west_edge[y] = om.get_ter( 0, y, 0 );
+        east_edge[y] = om.get_ter( OMAPX - 1, y, 0 );
+    }
+}
+
+const oter_id &overmap_border::get_ter( const int x, const int y ) const
+{
+    if( y == 0 ) {
+        return north_edge[x];
+    } else if( y == OMAPY - 1 ) {
+        return south_edge[x];
+    } else if( x == 0 ) {
+        return west_edge[y];
+    }
+    assert( x == OMAPX - 1 );
+    return east_edge[y];
+}
+
+void overmap::generate( const overmap_border *north, const overmap_border *east,
+                        const overmap_border *south, const overmap_border *west,
                         overmap_special_batch &enabled_specials )
 {
-    dbg( D_INFO ) << "overmap::generate start...";
+    // The debug log is not thread safe.
+    if( !generating_off_thread ) {
+        dbg( D_INFO ) << "overmap::generate start...";
+    }
+    // The overmap is the same no matter when or where it is generated, see generate_off_thread.
+    scoped_rng_engine rng_engine( generation_seed( g->get_seed(), loc ) );
 
     place_rivers( north, east, south, west );
     place_lakes();
@@ -1458,6 +1566,9 @@ void overmap::generate( const overmap *north, const overmap *east,
     place_forest_trails();
     place_roads( north, east, south, west );
     place_specials( enabled_specials );
+    if( needs_game_thread ) {
+        return;
+    }
     place_forest_trailheads();
 
     polish_river();
@@ -1475,7 +1586,28 @@ void overmap::generate( const overmap *north, const overmap *east,
     // Place the monsters, now that the terrain is laid out
     place_mongroups();
     place_radios();
-    dbg( D_INFO ) << "overmap::generate done";
+    if( !generating_off_thread ) {
+        dbg( D_INFO ) << "overmap::generate done";
+    }
+}
+
+void overmap::generation_error( const std::string &message )
+{
+    if( generating_off_thread ) {
+        deferred_errors.push_back( message );
+    } else {
+        debugmsg( "%s", message );
+    }
+}
+
+bool overmap::generate_off_thread( const overmap_border *north, const overmap_border *east,
+                                   const overmap_border *south, const overmap_border *west,
+                                   overmap_special_batch &enabled_specials )
+{
+    generating_off_thread = true;
+    generate( north, east, south, west, enabled_specials );
+    generating_off_thread = false;
+    return !needs_game_thread;
 }
 
 bool overmap::generate_sub( const int z )
@@ -1519,27 +1651,27 @@ bool overmap::generate_sub( const int z )
             }
 
             if( is_ot_match( "sub_station", oter_ground, ot_match_type::type ) && z == -1 ) {
-                ter( i, j, z ) = oter_id( "sewer_sub_station" );
+                ter_set( i, j, z, oter_id( "sewer_sub_station" ) );
                 requires_sub = true;
             } else if( is_ot_match( "sub_station", oter_ground, ot_match_type::type ) && z == -2 ) {
-                ter( i, j, z ) = oter_id( "subway_isolated" );
+                ter_set( i, j, z, oter_id( "subway_isolated" ) );
                 subway_points.emplace_back( i, j - 1 );
                 subway_points.emplace_back( i, j );
                 subway_points.emplace_back( i, j + 1 );
             } else if( oter_above == "road_nesw_manhole" ) {
-                ter( i, j, z ) = oter_id( "sewer_isolated" );
+                ter_set( i, j, z, oter_id( "sewer_isolated" ) );
                 sewer_points.emplace_back( i, j );
             } else if( oter_above == "sewage_treatment" ) {
                 sewer_points.emplace_back( i, j );
             } else if( oter_above == "cave" && z == -1 ) {
                 if( one_in( 3 ) ) {
-                    ter( i, j, z ) = oter_id( "cave_rat" );
+                    ter_set( i, j, z, oter_id( "cave_rat" ) );
                     requires_sub = true; // rat caves are two level
                 } else {
-                    ter( i, j, z ) = oter_id( "cave" );
+                    ter_set( i, j, z, oter_id( "cave" ) );
                 }
             } else if( oter_above == "cave_rat" && z == -2 ) {
-                ter( i, j, z ) = oter_id( "cave_rat" );
+                ter_set( i, j, z, oter_id( "cave_rat" ) );
             } else if( oter_above == "anthill" || oter_above == "acid_anthill" ) {
                 mongroup_id ant_group( oter_above == "anthill" ? "GROUP_ANT" : "GROUP_ANT_ACID" );
                 int size = rng( MIN_ANT_SIZE, MAX_ANT_SIZE );
@@ -1550,44 +1682,44 @@ bool overmap::generate_sub( const int z )
                 int size = rng( MIN_GOO_SIZE, MAX_GOO_SIZE );
                 goo_points.push_back( city( i, j, size ) );
             } else if( oter_above == "forest_water" ) {
-                ter( i, j, z ) = oter_id( "cavern" );
+                ter_set( i, j, z, oter_id( "cavern" ) );
                 chip_rock( i, j, z );
             } else if( oter_above == "lab_core" ||
                        ( z == -1 && oter_above == "lab_stairs" ) ) {
                 lab_points.push_back( city( i, j, rng( 1, 5 + z ) ) );
             } else if( oter_above == "lab_stairs" ) {
-                ter( i, j, z ) = oter_id( "lab" );
+                ter_set( i, j, z, oter_id( "lab" ) );
             } else if( oter_above == "ice_lab_core" ||
                        ( z == -1 && oter_above == "ice_lab_stairs" ) ) {
                 ice_lab_points.push_back( city( i, j, rng( 1, 5 + z ) ) );
             } else if( oter_above == "ice_lab_stairs" ) {
-                ter( i, j, z ) = oter_id( "ice_lab" );
+                ter_set( i, j, z, oter_id( "ice_lab" ) );
             } else if( oter_above == "central_lab_core" ) {
                 central_lab_points.push_back( city( i, j, rng( std::max( 1, 7 + z ), 9 + z ) ) );
             } else if( oter_above == "central_lab_stairs" ) {
-                ter( i, j, z ) = oter_id( "central_lab" );
+                ter_set( i, j, z, oter_id( "central_lab" ) );
             } else if( is_ot_match( "hidden_lab_stairs", oter_above, ot_match_type::contains ) ) {
                 lab_points.push_back( city( i, j, rng( 1, 5 + z ) ) );
             } else if( oter_above == "mine_entrance" ) {
                 shaft_points.push_back( point( i, j ) );
             } else if( oter_above == "mine_shaft" ||
                        oter_above == "mine_down" ) {
-                ter( i, j, z ) = oter_id( "mine" );
+                ter_set( i, j, z, oter_id( "mine" ) );
                 mine_points.push_back( city( i, j, rng( 6 + z, 10 + z ) ) );
                 // technically not all finales need a sub level,
                 // but at this point we don't know
                 requires_sub = true;
             } else if( oter_above == "mine_finale" ) {
                 for( auto &p : g->m.points_in_radius( tripoint( i, j, z ), 1, 0 ) ) {
-                    ter( p.x, p.y, p.z ) = oter_id( "spiral" );
+                    ter_set( p.x, p.y, p.z, oter_id( "spiral" ) );
                 }
-                ter( i, j, z ) = oter_id( "spiral_hub" );
+                ter_set( i, j, z, oter_id( "spiral_hub" ) );
                 add_mon_group( mongroup( mongroup_id( "GROUP_SPIRAL" ), i * 2, j * 2, z, 2, 200 ) );
             } else if( oter_above == "silo" ) {
                 if( rng( 2, 7 ) < abs( z ) || rng( 2, 7 ) < abs( z ) ) {
-                    ter( i, j, z ) = oter_id( "silo_finale" );
+                    ter_set( i, j, z, oter_id( "silo_finale" ) );
                 } else {
-                    ter( i, j, z ) = oter_id( "silo" );
+                    ter_set( i, j, z, oter_id( "silo" ) );
                     requires_sub = true;
                 }
             }
@@ -1618,14 +1750,14 @@ bool overmap::generate_sub( const int z )
         bool lab = build_lab( i.pos.x, i.pos.y, z, i.size, &lab_train_points, "", lab_train_odds );
         requires_sub |= lab;
         if( !lab && ter( i.pos.x, i.pos.y, z ) == "lab_core" ) {
-            ter( i.pos.x, i.pos.y, z ) = oter_id( "lab" );
+            ter_set( i.pos.x, i.pos.y, z, oter_id( "lab" ) );
         }
     }
     for( auto &i : ice_lab_points ) {
         bool ice_lab = build_lab( i.pos.x, i.pos.y, z, i.size, &lab_train_points, "ice_", lab_train_odds );
         requires_sub |= ice_lab;
         if( !ice_lab && ter( i.pos.x, i.pos.y, z ) == "ice_lab_core" ) {
-            ter( i.pos.x, i.pos.y, z ) = oter_id( "ice_lab" );
+            ter_set( i.pos.x, i.pos.y, z, oter_id( "ice_lab" ) );
         }
     }
     for( auto &i : central_lab_points ) {
@@ -1633,7 +1765,7 @@ bool overmap::generate_sub( const int z )
                                       lab_train_odds );
         requires_sub |= central_lab;
         if( !central_lab && ter( i.pos.x, i.pos.y, z ) == "central_lab_core" ) {
-            ter( i.pos.x, i.pos.y, z ) = oter_id( "central_lab" );
+            ter_set( i.pos.x, i.pos.y, z, oter_id( "central_lab" ) );
         }
     }
 
@@ -1647,18 +1779,18 @@ bool overmap::generate_sub( const int z )
                 point( i.x + 1, i.y ),
                 point( i.x - 1, i.y ) };
             if( is_first_in_pair ) {
-                ter( i.x, i.y, z ) = oter_id( "open_air" ); // mark tile to prevent subway gen
+                ter_set( i.x, i.y, z, oter_id( "open_air" ) ); // mark tile to prevent subway gen
 
                 for( auto &nearby_loc : nearby_locations ) {
                     if( is_ot_match( "empty_rock", ter( nearby_loc.x, nearby_loc.y, z ), ot_match_type::contains ) ) {
                         // mark tile to prevent subway gen
-                        ter( nearby_loc.x, nearby_loc.y, z ) = oter_id( "open_air" );
+                        ter_set( nearby_loc.x, nearby_loc.y, z, oter_id( "open_air" ) );
                     }
                 }
             } else {
                 // change train connection point back to rock to allow gen
                 if( is_ot_match( "open_air", ter( i.x, i.y, z ), ot_match_type::contains ) ) {
-                    ter( i.x, i.y, z ) = oter_id( "empty_rock" );
+                    ter_set( i.x, i.y, z, oter_id( "empty_rock" ) );
                 }
                 real_train_points.push_back( i );
             }
@@ -1683,7 +1815,7 @@ bool overmap::generate_sub( const int z )
 
     for( auto &i : subway_points ) {
         if( is_ot_match( "sub_station", ter( i.x, i.y, z + 2 ), ot_match_type::type ) ) {
-            ter( i.x, i.y, z ) = oter_id( "underground_sub_station" );
+            ter_set( i.x, i.y, z, oter_id( "underground_sub_station" ) );
         }
     }
 
@@ -1696,7 +1828,7 @@ bool overmap::generate_sub( const int z )
             if( is_first_in_pair ) {
                 const std::vector<point> subway_possible_loc { point( i.x, i.y - 1 ), point( i.x, i.y + 1 ), point( i.x + 1, i.y ), point( i.x - 1, i.y ) };
                 extra_route.clear();
-                ter( i.x, i.y, z ) = oter_id( "empty_rock" ); // this clears marked tiles
+                ter_set( i.x, i.y, z, oter_id( "empty_rock" ) ); // this clears marked tiles
                 bool is_depot_generated = false;
                 for( auto &subway_loc : subway_possible_loc ) {
                     if( !is_depot_generated &&
@@ -1705,12 +1837,12 @@ bool overmap::generate_sub( const int z )
                         extra_route.push_back( subway_loc );
                         connect_closest_points( extra_route, z, *subway_tunnel );
 
-                        ter( i.x, i.y, z ) = train_type;
+                        ter_set( i.x, i.y, z, train_type );
                         is_depot_generated = true; // only one connection to depot
                     } else if( is_ot_match( "open_air", ter( subway_loc.x, subway_loc.y, z ),
                                             ot_match_type::contains ) ) {
                         // clear marked
-                        ter( subway_loc.x, subway_loc.y, z ) = oter_id( "empty_rock" );
+                        ter_set( subway_loc.x, subway_loc.y, z, oter_id( "empty_rock" ) );
                     }
                 }
             }
@@ -1738,7 +1870,7 @@ bool overmap::generate_sub( const int z )
     }
 
     for( auto &i : shaft_points ) {
-        ter( i.x, i.y, z ) = oter_id( "mine_shaft" );
+        ter_set( i.x, i.y, z, oter_id( "mine_shaft" ) );
         requires_sub = true;
     }
     return requires_sub;
@@ -1776,6 +1908,87 @@ const city &overmap::get_nearest_city( const tripoint &p ) const
     return invalid_city;
 }
 
+std::vector<tripoint> overmap::find_ter( const std::function<bool( const oter_id & )> &matches,
+        const tripoint &origin, const int min_dist, const int max_dist,
+        const cata::optional<overmap_special_id> &om_special ) const
+{
+    std::vector<tripoint> found;
+    if( origin.z < -OVERMAP_DEPTH || origin.z > OVERMAP_HEIGHT || min_dist > max_dist ) {
+        return found;
+    }
+    const auto in_range = [&]( const int x, const int y ) {
+        const int dist = std::max( std::abs( x - origin.x ), std::abs( y - origin.y ) );
+        return dist >= min_dist && dist <= max_dist;
+    };
+
+    if( om_special ) {
+        // Specials are small, their placements are quicker to check than the terrain.
+        const auto iter = overmap_special_positions.find( *om_special );
+        if( iter != overmap_special_positions.end() ) {
+            for( const tripoint &p : iter->second ) {
+                if( p.z == origin.z && in_range( p.x, p.y ) && matches( ter( p ) ) ) {
+                    found.push_back( p );
+                }
+            }
+        }
+        return found;
+    }
+
+    const int z = origin.z + OVERMAP_DEPTH;
+    std::vector<oter_id> matching;
+    std::vector<const ter_block_counts *> matching_counts;
+    for( const auto &entry : ter_index[z] ) {
+        if( matches( entry.first ) ) {
+            matching.push_back( entry.first );
+            matching_counts.push_back( &entry.second );
+        }
+    }
+    if( matching.empty() ) {
+        return found;
+    }
+    std::sort( matching.begin(), matching.end() );
+
+    const int min_x = std::max( 0, origin.x - max_dist );
+    const int max_x = std::min( OMAPX - 1, origin.x + max_dist );
+    const int min_y = std::max( 0, origin.y - max_dist );
+    const int max_y = std::min( OMAPY - 1, origin.y + max_dist );
+    if( min_x > max_x || min_y > max_y ) {
+        return found;
+    }
+    for( int bx = min_x / ter_index_block; bx <= max_x / ter_index_block; ++bx ) {
+        for( int by = min_y / ter_index_block; by <= max_y / ter_index_block; ++by ) {
+            const int block = bx * ter_index_blocks_y + by;
+            const bool has_match = std::any_of( matching_counts.begin(), matching_counts.end(),
+            [block]( const ter_block_counts * counts ) {
+                return ( *counts )[block] > 0;
+            } );
+            if( !has_match ) {
+                continue;
+            }
+            const int x0 = std::max( min_x, bx * ter_index_block );
+            const int x1 = std::min( max_x, ( bx + 1 ) * ter_index_block - 1 );
+            const int y0 = std::max( min_y, by * ter_index_block );
+            const int y1 = std::min( max_y, ( by + 1 ) * ter_index_block - 1 );
+            // Skip blocks that are entirely closer than min_dist.
+            const int block_dist = std::max( { std::abs( x0 - origin.x ), std::abs( x1 - origin.x ),
+                                               std::abs( y0 - origin.y ), std::abs( y1 - origin.y )
+                                             } );
+            if( block_dist < min_dist ) {
+                continue;
+            }
+            for( int x = x0; x <= x1; ++x ) {
+                for( int y = y0; y <= y1; ++y ) {
+                    const oter_id &cur = layer[z].terrain[x][y];
+                    if( in_range( x, y ) && std::binary_search( matching.begin(), matching.end(), cur ) ) {
+                        found.emplace_back( x, y, origin.z );
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
 tripoint overmap::find_random_omt( const std::string &omt_base_type ) const
 {
     std::vector<tripoint> valid;
@@ -1793,18 +2006,15 @@ tripoint overmap::find_random_omt( const std::string &omt_base_type ) const
 
 void overmap::process_mongroups()
 {
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    for( mongroup &mg : zg ) {
         if( mg.dying ) {
             mg.population = ( mg.population * 4 ) / 5;
             mg.radius = ( mg.radius * 9 ) / 10;
         }
-        if( mg.empty() ) {
-            zg.erase( it++ );
-        } else {
-            ++it;
-        }
     }
+    zg.remove_if( []( const mongroup & mg ) {
+        return mg.empty();
+    } );
 }
 
 void overmap::clear_mon_groups()
@@ -1843,15 +2053,12 @@ void mongroup::wander( const overmap &om )
     }
 }
 
-void overmap::move_hordes()
+std::vector<mongroup> overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    // The groups are moved in place, each one is visited once.
+    for( mongroup &mg : zg ) {
         if( !mg.horde ) {
-            ++it;
             continue;
         }
 
@@ -1867,7 +2074,7 @@ void overmap::move_hordes()
         }
 
         // Decrease movement chance according to the terrain we're currently on.
-        const oter_id &walked_into = ter( mg.pos.x, mg.pos.y, mg.pos.z );
+        const oter_id &walked_into = ter( sm_to_omt_copy( mg.pos ) );
         int movement_chance = 1;
         if( walked_into == ot_forest || walked_into == ot_forest_water ) {
             movement_chance = 3;
@@ -1886,29 +2093,26 @@ void overmap::move_hordes()
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
         if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
-            // TODO: Handle moving to adjacent overmaps.
-            if( mg.pos.x > mg.target.x ) {
-                mg.pos.x--;
+            tripoint next = mg.pos;
+            if( next.x > mg.target.x ) {
+                next.x--;
             }
-            if( mg.pos.x < mg.target.x ) {
-                mg.pos.x++;
+            if( next.x < mg.target.x ) {
+                next.x++;
             }
-            if( mg.pos.y > mg.target.y ) {
-                mg.pos.y--;
+            if( next.y > mg.target.y ) {
+                next.y--;
             }
-            if( mg.pos.y < mg.target.y ) {
-                mg.pos.y++;
+            if( next.y < mg.target.y ) {
+                next.y++;
             }
-
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
+            zg.move( mg, next );
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    // Hordes that walked off this overmap are moved to the adjacent one by the overmap buffer.
+    std::vector<mongroup> left = zg.extract_if( []( const mongroup & mg ) {
+        return mg.horde && !inbounds( sm_to_omt_copy( mg.pos ) );
+    } );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
         static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
@@ -1943,19 +2147,15 @@ void overmap::move_hordes()
 
             // Scan for compatible hordes in this area, selecting the largest.
             mongroup *add_to_group = nullptr;
-            auto group_bucket = zg.equal_range( p );
             std::vector<monster>::size_type add_to_horde_size = 0;
-            std::for_each( group_bucket.first, group_bucket.second,
-            [&]( std::pair<const tripoint, mongroup> &horde_entry ) {
-                mongroup &horde = horde_entry.second;
-
+            for( mongroup *horde : zg.at( p ) ) {
                 // We only absorb zombies into GROUP_ZOMBIE hordes
-                if( horde.horde && !horde.monsters.empty() && horde.type == GROUP_ZOMBIE &&
-                    horde.monsters.size() > add_to_horde_size ) {
-                    add_to_group = &horde;
-                    add_to_horde_size = horde.monsters.size();
+                if( horde->horde && !horde->monsters.empty() && horde->type == GROUP_ZOMBIE &&
+                    horde->monsters.size() > add_to_horde_size ) {
+                    add_to_group = horde;
+                    add_to_horde_size = horde->monsters.size();
                 }
-            } );
+            }
 
             // Check again if the zombie will join the largest horde, now that we know the accurate size.
             if( this_monster.will_join_horde( add_to_horde_size ) ) {
@@ -1979,6 +2179,7 @@ void overmap::move_hordes()
             monster_map_it = monster_map.erase( monster_map_it );
         }
     }
+    return left;
 }
 
 /**
@@ -1987,8 +2188,7 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const tripoint &p, const int sig_power )
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    for( mongroup &mg : zg ) {
         if( !mg.horde ) {
             continue;
         }
@@ -2184,11 +2384,11 @@ void overmap::place_forest_trailheads()
 
     const auto try_place_trailhead = [&]( const tripoint & trailhead, const tripoint & road,
     const std::string & suffix ) {
-        oter_id &oter_potential_trailhead = ter( trailhead );
-        oter_id &oter_potential_road = ter( road );
+        const oter_id &oter_potential_trailhead = ter( trailhead );
+        const oter_id &oter_potential_road = ter( road );
         if( oter_potential_trailhead == "field" && oter_potential_road == "field" &&
             one_in( settings.forest_trail.trailhead_chance ) && trailhead_close_to_road( trailhead ) ) {
-            oter_potential_trailhead = oter_id( "trailhead" + suffix );
+            ter_set( trailhead, oter_id( "trailhead" + suffix ) );
             road_points.emplace_back( road.x, road.y );
         }
     };
@@ -2228,7 +2428,7 @@ void overmap::place_forests()
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
-            oter_id &oter = ter( x, y, 0 );
+            const oter_id &oter = ter( x, y, 0 );
 
             // At this point in the process, we only want to consider converting the terrain into
             // a forest if it's currently the default terrain type (e.g. a field).
@@ -2241,9 +2441,9 @@ void overmap::place_forests()
 
             // If the noise here meets our threshold, turn it into a forest.
             if( n > settings.overmap_forest.noise_threshold_forest_thick ) {
-                oter = forest_thick;
+                ter_set( x, y, 0, forest_thick );
             } else if( n > settings.overmap_forest.noise_threshold_forest ) {
-                oter = forest;
+                ter_set( x, y, 0, forest );
             }
         }
     }
@@ -2326,7 +2526,7 @@ void overmap::place_lakes()
                     }
                 }
 
-                ter( p.x, p.y, 0 ) = shore ? lake_shore : lake_surface;
+                ter_set( p.x, p.y, 0, shore ? lake_shore : lake_surface );
             }
 
             // We're going to attempt to connect some points on this lake to the nearest river.
@@ -2373,8 +2573,8 @@ void overmap::place_lakes()
     }
 }
 
-void overmap::place_rivers( const overmap *north, const overmap *east, const overmap *south,
-                            const overmap *west )
+void overmap::place_rivers( const overmap_border *north, const overmap_border *east,
+                            const overmap_border *south, const overmap_border *west )
 {
     if( settings.river_scale == 0.0 ) {
         return;
@@ -2392,12 +2592,12 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
 
     if( north != nullptr ) {
         for( int i = 2; i < OMAPX - 2; i++ ) {
-            if( is_river( north->get_ter( i, OMAPY - 1, 0 ) ) ) {
-                ter( i, 0, 0 ) = river_center;
+            if( is_river( north->get_ter( i, OMAPY - 1 ) ) ) {
+                ter_set( i, 0, 0, river_center );
             }
-            if( is_river( north->get_ter( i, OMAPY - 1, 0 ) ) &&
-                is_river( north->get_ter( i - 1, OMAPY - 1, 0 ) ) &&
-                is_river( north->get_ter( i + 1, OMAPY - 1, 0 ) ) ) {
+            if( is_river( north->get_ter( i, OMAPY - 1 ) ) &&
+                is_river( north->get_ter( i - 1, OMAPY - 1 ) ) &&
+                is_river( north->get_ter( i + 1, OMAPY - 1 ) ) ) {
                 if( one_in( river_chance ) && ( river_start.empty() ||
                                                 river_start[river_start.size() - 1].x < ( i - 6 ) * river_scale ) ) {
                     river_start.push_back( point( i, 0 ) );
@@ -2408,12 +2608,12 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     size_t rivers_from_north = river_start.size();
     if( west != nullptr ) {
         for( int i = 2; i < OMAPY - 2; i++ ) {
-            if( is_river( west->get_ter( OMAPX - 1, i, 0 ) ) ) {
-                ter( 0, i, 0 ) = river_center;
+            if( is_river( west->get_ter( OMAPX - 1, i ) ) ) {
+                ter_set( 0, i, 0, river_center );
             }
-            if( is_river( west->get_ter( OMAPX - 1, i, 0 ) ) &&
-                is_river( west->get_ter( OMAPX - 1, i - 1, 0 ) ) &&
-                is_river( west->get_ter( OMAPX - 1, i + 1, 0 ) ) ) {
+            if( is_river( west->get_ter( OMAPX - 1, i ) ) &&
+                is_river( west->get_ter( OMAPX - 1, i - 1 ) ) &&
+                is_river( west->get_ter( OMAPX - 1, i + 1 ) ) ) {
                 if( one_in( river_chance ) && ( river_start.size() == rivers_from_north ||
                                                 river_start[river_start.size() - 1].y < ( i - 6 ) * river_scale ) ) {
                     river_start.push_back( point( 0, i ) );
@@ -2423,12 +2623,12 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     }
     if( south != nullptr ) {
         for( int i = 2; i < OMAPX - 2; i++ ) {
-            if( is_river( south->get_ter( i, 0, 0 ) ) ) {
-                ter( i, OMAPY - 1, 0 ) = river_center;
+            if( is_river( south->get_ter( i, 0 ) ) ) {
+                ter_set( i, OMAPY - 1, 0, river_center );
             }
-            if( is_river( south->get_ter( i, 0, 0 ) ) &&
-                is_river( south->get_ter( i - 1, 0, 0 ) ) &&
-                is_river( south->get_ter( i + 1, 0, 0 ) ) ) {
+            if( is_river( south->get_ter( i, 0 ) ) &&
+                is_river( south->get_ter( i - 1, 0 ) ) &&
+                is_river( south->get_ter( i + 1, 0 ) ) ) {
                 if( river_end.empty() ||
                     river_end[river_end.size() - 1].x < i - 6 ) {
                     river_end.push_back( point( i, OMAPY - 1 ) );
@@ -2439,12 +2639,12 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     size_t rivers_to_south = river_end.size();
     if( east != nullptr ) {
         for( int i = 2; i < OMAPY - 2; i++ ) {
-            if( is_river( east->get_ter( 0, i, 0 ) ) ) {
-                ter( OMAPX - 1, i, 0 ) = river_center;
+            if( is_river( east->get_ter( 0, i ) ) ) {
+                ter_set( OMAPX - 1, i, 0, river_center );
             }
-            if( is_river( east->get_ter( 0, i, 0 ) ) &&
-                is_river( east->get_ter( 0, i - 1, 0 ) ) &&
-                is_river( east->get_ter( 0, i + 1, 0 ) ) ) {
+            if( is_river( east->get_ter( 0, i ) ) &&
+                is_river( east->get_ter( 0, i - 1 ) ) &&
+                is_river( east->get_ter( 0, i + 1 ) ) ) {
                 if( river_end.size() == rivers_to_south ||
                     river_end[river_end.size() - 1].y < i - 6 ) {
                     river_end.push_back( point( OMAPX - 1, i ) );
@@ -2560,14 +2760,14 @@ void overmap::place_swamps()
             const bool should_isolated_swamp = f.noise_at( { x, y } ) >
                                                settings.overmap_forest.noise_threshold_swamp_isolated;
             if( should_flood || should_isolated_swamp )  {
-                ter( x, y, 0 ) = forest_water;
+                ter_set( x, y, 0, forest_water );
             }
         }
     }
 }
 
-void overmap::place_roads( const overmap *north, const overmap *east, const overmap *south,
-                           const overmap *west )
+void overmap::place_roads( const overmap_border *north, const overmap_border *east,
+                           const overmap_border *south, const overmap_border *west )
 {
     if( north != nullptr ) {
         for( auto &i : north->roads_out ) {
@@ -2679,7 +2879,7 @@ void overmap::place_river( point pa, point pb )
             for( int j = -1 * river_scale; j <= 1 * river_scale; j++ ) {
                 if( y + i >= 0 && y + i < OMAPY && x + j >= 0 && x + j < OMAPX ) {
                     if( !ter( x + j, y + i, 0 )->is_lake() && one_in( river_chance ) ) {
-                        ter( x + j, y + i, 0 ) = river_center;
+                        ter_set( x + j, y + i, 0, river_center );
                     }
                 }
             }
@@ -2726,7 +2926,7 @@ void overmap::place_river( point pa, point pb )
                     ( abs( pb.y - ( y + i ) ) < 4 && abs( pb.x - ( x + j ) ) < 4 ) ) {
 
                     if( !ter( x + j, y + i, 0 )->is_lake() && one_in( river_chance ) ) {
-                        ter( x + j, y + i, 0 ) = river_center;
+                        ter_set( x + j, y + i, 0, river_center );
                     }
                 }
             }
@@ -2796,7 +2996,7 @@ void overmap::place_cities()
         int cx = rng( size - 1, OMAPX - size );
         int cy = rng( size - 1, OMAPY - size );
         if( ter( cx, cy, 0 ) == settings.default_oter ) {
-            ter( cx, cy, 0 ) = oter_id( "road_nesw" ); // every city starts with an intersection
+            ter_set( cx, cy, 0, oter_id( "road_nesw" ) ); // every city starts with an intersection
             city tmp;
             tmp.pos = { cx, cy };
             tmp.size = size;
@@ -2862,7 +3062,7 @@ void overmap::build_city_street( const overmap_connection &connection, const poi
     int croad = cs;
 
     if( dir == om_direction::type::invalid ) {
-        debugmsg( "Invalid road direction." );
+        generation_error( "Invalid road direction." );
         return;
     }
 
@@ -2902,10 +3102,10 @@ void overmap::build_city_street( const overmap_connection &connection, const poi
             build_city_street( connection, iter->pos(), right, om_direction::turn_right( dir ),
                                town, new_width );
 
-            auto &oter = ter( iter->x, iter->y, 0 );
+            const oter_id &oter = ter( iter->x, iter->y, 0 );
             // TODO: Get rid of the hardcoded terrain ids.
             if( one_in( 2 ) && oter->get_line() == 15 && oter->type_is( oter_type_id( "road" ) ) ) {
-                oter = oter_id( "road_nesw_manhole" );
+                ter_set( iter->x, iter->y, 0, oter_id( "road_nesw_manhole" ) );
             }
         }
         const tripoint rp( iter->x, iter->y, 0 );
@@ -2944,7 +3144,7 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
     const oter_id labt_ants( "ants_lab" );
     const oter_id labt_ants_stairs( "ants_lab_stairs" );
 
-    ter( x, y, z ) = labt;
+    ter_set( x, y, z, labt );
     generated_lab.push_back( point( x, y ) );
 
     // maintain a list of potential new lab maps
@@ -2962,10 +3162,10 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
                 // make an ants lab if it's a basic lab and ants were there before.
                 if( prefix.empty() && check_ot( "ants", ot_match_type::type, cx, cy, z ) ) {
                     if( ter( cx, cy, z ) != "ants_queen" ) { // skip over a queen's chamber.
-                        ter( cx, cy, z ) = labt_ants;
+                        ter_set( cx, cy, z, labt_ants );
                     }
                 } else {
-                    ter( cx, cy, z ) = labt;
+                    ter_set( cx, cy, z, labt );
                 }
                 generated_lab.push_back( *cand );
                 // add new candidates, don't backtrack
@@ -3004,10 +3204,10 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
                 break;
             }
         }
-        ter( p.x, p.y, z + 1 ) = labt_stairs;
+        ter_set( p.x, p.y, z + 1, labt_stairs );
     }
 
-    ter( x, y, z ) = labt_core;
+    ter_set( x, y, z, labt_core );
     int numstairs = 0;
     if( s > 0 ) { // Build stairs going down
         while( !one_in( 6 ) ) {
@@ -3022,9 +3222,9 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
                      tries < 15 );
             if( tries < 15 ) {
                 if( ter( stairx, stairy, z ) == labt_ants ) {
-                    ter( stairx, stairy, z ) = labt_ants_stairs;
+                    ter_set( stairx, stairy, z, labt_ants_stairs );
                 } else {
-                    ter( stairx, stairy, z ) = labt_stairs;
+                    ter_set( stairx, stairy, z, labt_stairs );
                 }
                 numstairs++;
             }
@@ -3042,7 +3242,7 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
             tries++;
         } while( tries < 15 && ter( finalex, finaley, z ) != labt
                  && ter( finalex, finaley, z ) != labt_core );
-        ter( finalex, finaley, z ) = labt_finale;
+        ter_set( finalex, finaley, z, labt_finale );
     }
 
     if( train_odds > 0 && one_in( train_odds ) ) {
@@ -3105,8 +3305,8 @@ bool overmap::build_lab( int x, int y, int z, int s, std::vector<point> *lab_tra
                      ter( cellx, celly + 1, z ) != labt ||
                      adjacent_labs != 1 ) );
         if( tries < 50 ) {
-            ter( cellx, celly, z ) = oter_id( "lab_escape_cells" );
-            ter( cellx, celly + 1, z ) = oter_id( "lab_escape_entrance" );
+            ter_set( cellx, celly, z, oter_id( "lab_escape_cells" ) );
+            ter_set( cellx, celly + 1, z, oter_id( "lab_escape_entrance" ) );
         }
     }
 
@@ -3128,21 +3328,21 @@ void overmap::build_anthill( int x, int y, int z, int s )
         }
     }
     const point target = random_entry( queenpoints );
-    ter( target.x, target.y, z ) = oter_id( "ants_queen" );
+    ter_set( target.x, target.y, z, oter_id( "ants_queen" ) );
 
     const oter_id root_id( "ants_isolated" );
 
     for( int i = x - s; i <= x + s; i++ ) {
         for( int j = y - s; j <= y + s; j++ ) {
             if( root_id == get_ter( i, j, z )->id ) {
-                auto &oter = ter( i, j, z );
+                const oter_id &oter = ter( i, j, z );
                 for( auto dir : om_direction::all ) {
                     const point p = point( i, j ) + om_direction::displace( dir );
                     if( check_ot( "ants", ot_match_type::type, p.x, p.y, z ) ) {
                         size_t line = oter->get_line();
                         line = om_lines::set_segment( line, dir );
                         if( line != oter->get_line() ) {
-                            oter = oter->get_type_id()->get_linear( line );
+                            ter_set( i, j, z, oter->get_type_id()->get_linear( line ) );
                         }
                     }
                 }
@@ -3162,7 +3362,7 @@ void overmap::build_tunnel( int x, int y, int z, int s, om_direction::type dir )
         return;
     }
 
-    ter( x, y, z ) = oter_id( root_id );
+    ter_set( x, y, z, oter_id( root_id ) );
 
     std::vector<om_direction::type> valid;
     valid.reserve( om_direction::size );
@@ -3184,9 +3384,9 @@ void overmap::build_tunnel( int x, int y, int z, int s, om_direction::type dir )
             if( one_in( s * 2 ) ) {
                 // Spawn a special chamber
                 if( one_in( 2 ) ) {
-                    ter( p.x, p.y, z ) = ants_food;
+                    ter_set( p.x, p.y, z, ants_food );
                 } else {
-                    ter( p.x, p.y, z ) = ants_larvae;
+                    ter_set( p.x, p.y, z, ants_larvae );
                 }
             } else if( one_in( 5 ) ) {
                 // Branch off a side tunnel
@@ -3209,10 +3409,10 @@ bool overmap::build_slimepit( int x, int y, int z, int s )
         if( one_in( 2 * dist ) ) {
             chip_rock( p.x, p.y, p.z );
             if( one_in( 8 ) && z > -OVERMAP_DEPTH ) {
-                ter( p.x, p.y, p.z ) = slimepit_down;
+                ter_set( p.x, p.y, p.z, slimepit_down );
                 requires_sub = true;
             } else {
-                ter( p.x, p.y, p.z ) = slimepit;
+                ter_set( p.x, p.y, p.z, slimepit );
             }
         }
     }
@@ -3232,7 +3432,7 @@ void overmap::build_mine( int x, int y, int z, int s )
         s = 2;
     }
     while( built < s ) {
-        ter( x, y, z ) = mine;
+        ter_set( x, y, z, mine );
         std::vector<point> next;
         for( int i = -1; i <= 1; i += 2 ) {
             if( ter( x, y + i, z ) == empty_rock ) {
@@ -3243,7 +3443,7 @@ void overmap::build_mine( int x, int y, int z, int s )
             }
         }
         if( next.empty() ) { // Dead end!  Go down!
-            ter( x, y, z ) = mine_finale_or_down;
+            ter_set( x, y, z, mine_finale_or_down );
             return;
         }
         const point p = random_entry( next );
@@ -3251,7 +3451,7 @@ void overmap::build_mine( int x, int y, int z, int s )
         y = p.y;
         built++;
     }
-    ter( x, y, z ) = mine_finale_or_down;
+    ter_set( x, y, z, mine_finale_or_down );
 }
 
 pf::path overmap::lay_out_connection( const overmap_connection &connection, const point &source,
@@ -3376,14 +3576,15 @@ void overmap::build_connection( const overmap_connection &connection, const pf::
 
     for( const auto &node : path.nodes ) {
         const tripoint pos( node.x, node.y, z );
-        auto &ter_id( ter( pos ) );
+        const oter_id &ter_id( ter( pos ) );
         // TODO: Make 'node' support 'om_direction'.
         const om_direction::type new_dir( static_cast<om_direction::type>( node.dir ) );
         const overmap_connection::subtype *subtype = connection.pick_subtype_for( ter_id );
 
         if( !subtype ) {
-            debugmsg( "No suitable subtype of connection \"%s\" found for \"%s\".", connection.id.c_str(),
-                      ter_id.id().c_str() );
+            generation_error( string_format(
+                                  "No suitable subtype of connection \"%s\" found for \"%s\".",
+                                  connection.id.c_str(), ter_id.id().c_str() ) );
             return;
         }
 
@@ -3402,7 +3603,7 @@ void overmap::build_connection( const overmap_connection &connection, const pf::
                 const tripoint np( pos + om_direction::displace( dir ) );
 
                 if( inbounds( np ) ) {
-                    auto &near_id( ter( np ) );
+                    const oter_id &near_id( ter( np ) );
 
                     if( connection.has( near_id ) ) {
                         if( near_id->is_linear() ) {
@@ -3411,7 +3612,7 @@ void overmap::build_connection( const overmap_connection &connection, const pf::
                             if( om_lines::is_straight( near_line ) || om_lines::has_segment( near_line, new_dir ) ) {
                                 // Mutual connection.
                                 const size_t new_near_line = om_lines::set_segment( near_line, om_direction::opposite( dir ) );
-                                near_id = near_id->get_type_id()->get_linear( new_near_line );
+                                ter_set( np, near_id->get_type_id()->get_linear( new_near_line ) );
                                 new_line = om_lines::set_segment( new_line, dir );
                             }
                         } else if( near_id->is_rotatable() && om_direction::are_parallel( dir, near_id->get_dir() ) ) {
@@ -3425,13 +3626,14 @@ void overmap::build_connection( const overmap_connection &connection, const pf::
             }
 
             if( new_line == om_lines::invalid ) {
-                debugmsg( "Invalid path for connection \"%s\".", connection.id.c_str() );
+                generation_error( string_format( "Invalid path for connection \"%s\".",
+                                                 connection.id.c_str() ) );
                 return;
             }
 
-            ter_id = subtype->terrain->get_linear( new_line );
+            ter_set( pos, subtype->terrain->get_linear( new_line ) );
         } else if( new_dir != om_direction::type::invalid ) {
-            ter_id = subtype->terrain->get_rotated( new_dir );
+            ter_set( pos, subtype->terrain->get_rotated( new_dir ) );
         }
 
         prev_dir = new_dir;
@@ -3484,19 +3686,19 @@ void overmap::chip_rock( int x, int y, int z )
     const oter_id empty_rock( "empty_rock" );
 
     if( ter( x - 1, y, z ) == empty_rock ) {
-        ter( x - 1, y, z ) = rock;
+        ter_set( x - 1, y, z, rock );
     }
 
     if( ter( x + 1, y, z ) == empty_rock ) {
-        ter( x + 1, y, z ) = rock;
+        ter_set( x + 1, y, z, rock );
     }
 
     if( ter( x, y - 1, z ) == empty_rock ) {
-        ter( x, y - 1, z ) = rock;
+        ter_set( x, y - 1, z, rock );
     }
 
     if( ter( x, y + 1, z ) == empty_rock ) {
-        ter( x, y + 1, z ) = rock;
+        ter_set( x, y + 1, z, rock );
     }
 }
 
@@ -3529,21 +3731,21 @@ void overmap::good_river( int x, int y, int z )
     }
     if( ( x == 0 ) || ( x == OMAPX - 1 ) ) {
         if( !is_river_or_lake( ter( x, y - 1, z ) ) ) {
-            ter( x, y, z ) = oter_id( "river_north" );
+            ter_set( x, y, z, oter_id( "river_north" ) );
         } else if( !is_river_or_lake( ter( x, y + 1, z ) ) ) {
-            ter( x, y, z ) = oter_id( "river_south" );
+            ter_set( x, y, z, oter_id( "river_south" ) );
         } else {
-            ter( x, y, z ) = oter_id( "river_center" );
+            ter_set( x, y, z, oter_id( "river_center" ) );
         }
         return;
     }
     if( ( y == 0 ) || ( y == OMAPY - 1 ) ) {
         if( !is_river_or_lake( ter( x - 1, y, z ) ) ) {
-            ter( x, y, z ) = oter_id( "river_west" );
+            ter_set( x, y, z, oter_id( "river_west" ) );
         } else if( !is_river_or_lake( ter( x + 1, y, z ) ) ) {
-            ter( x, y, z ) = oter_id( "river_east" );
+            ter_set( x, y, z, oter_id( "river_east" ) );
         } else {
-            ter( x, y, z ) = oter_id( "river_center" );
+            ter_set( x, y, z, oter_id( "river_center" ) );
         }
         return;
     }
@@ -3554,36 +3756,36 @@ void overmap::good_river( int x, int y, int z )
                     // River on N, S, E, W;
                     // but we might need to take a "bite" out of the corner
                     if( !is_river_or_lake( ter( x - 1, y - 1, z ) ) ) {
-                        ter( x, y, z ) = oter_id( "river_c_not_nw" );
+                        ter_set( x, y, z, oter_id( "river_c_not_nw" ) );
                     } else if( !is_river_or_lake( ter( x + 1, y - 1, z ) ) ) {
-                        ter( x, y, z ) = oter_id( "river_c_not_ne" );
+                        ter_set( x, y, z, oter_id( "river_c_not_ne" ) );
                     } else if( !is_river_or_lake( ter( x - 1, y + 1, z ) ) ) {
-                        ter( x, y, z ) = oter_id( "river_c_not_sw" );
+                        ter_set( x, y, z, oter_id( "river_c_not_sw" ) );
                     } else if( !is_river_or_lake( ter( x + 1, y + 1, z ) ) ) {
-                        ter( x, y, z ) = oter_id( "river_c_not_se" );
+                        ter_set( x, y, z, oter_id( "river_c_not_se" ) );
                     } else {
-                        ter( x, y, z ) = oter_id( "river_center" );
+                        ter_set( x, y, z, oter_id( "river_center" ) );
                     }
                 } else {
-                    ter( x, y, z ) = oter_id( "river_east" );
+                    ter_set( x, y, z, oter_id( "river_east" ) );
                 }
             } else {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) {
-                    ter( x, y, z ) = oter_id( "river_south" );
+                    ter_set( x, y, z, oter_id( "river_south" ) );
                 } else {
-                    ter( x, y, z ) = oter_id( "river_se" );
+                    ter_set( x, y, z, oter_id( "river_se" ) );
                 }
             }
         } else {
             if( is_river_or_lake( ter( x, y + 1, z ) ) ) {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) {
-                    ter( x, y, z ) = oter_id( "river_north" );
+                    ter_set( x, y, z, oter_id( "river_north" ) );
                 } else {
-                    ter( x, y, z ) = oter_id( "river_ne" );
+                    ter_set( x, y, z, oter_id( "river_ne" ) );
                 }
             } else {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) { // Means it's swampy
-                    ter( x, y, z ) = oter_id( "forest_water" );
+                    ter_set( x, y, z, oter_id( "forest_water" ) );
                 }
             }
         }
@@ -3591,26 +3793,26 @@ void overmap::good_river( int x, int y, int z )
         if( is_river_or_lake( ter( x, y - 1, z ) ) ) {
             if( is_river_or_lake( ter( x, y + 1, z ) ) ) {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) {
-                    ter( x, y, z ) = oter_id( "river_west" );
+                    ter_set( x, y, z, oter_id( "river_west" ) );
                 } else { // Should never happen
-                    ter( x, y, z ) = oter_id( "forest_water" );
+                    ter_set( x, y, z, oter_id( "forest_water" ) );
                 }
             } else {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) {
-                    ter( x, y, z ) = oter_id( "river_sw" );
+                    ter_set( x, y, z, oter_id( "river_sw" ) );
                 } else { // Should never happen
-                    ter( x, y, z ) = oter_id( "forest_water" );
+                    ter_set( x, y, z, oter_id( "forest_water" ) );
                 }
             }
         } else {
             if( is_river_or_lake( ter( x, y + 1, z ) ) ) {
                 if( is_river_or_lake( ter( x + 1, y, z ) ) ) {
-                    ter( x, y, z ) = oter_id( "river_nw" );
+                    ter_set( x, y, z, oter_id( "river_nw" ) );
                 } else { // Should never happen
-                    ter( x, y, z ) = oter_id( "forest_water" );
+                    ter_set( x, y, z, oter_id( "forest_water" ) );
                 }
             } else { // Should never happen
-                ter( x, y, z ) = oter_id( "forest_water" );
+                ter_set( x, y, z, oter_id( "forest_water" ) );
             }
         }
     }
@@ -3832,15 +4034,15 @@ void overmap::place_special( const overmap_special &special, const tripoint &p,
         const tripoint location = p + om_direction::rotate( elem.p, dir );
         const oter_id tid = elem.terrain->get_rotated( dir );
 
-        overmap_special_placements[location] = special.id;
-        ter( location.x, location.y, location.z ) = tid;
+        add_special_placement( location, special.id );
+        ter_set( location, tid );
 
         if( blob ) {
             for( int x = -2; x <= 2; x++ ) {
                 for( int y = -2; y <= 2; y++ ) {
-                    auto &cur_ter = ter( location.x + x, location.y + y, location.z );
-                    if( one_in( 1 + abs( x ) + abs( y ) ) && elem.can_be_placed_on( cur_ter ) ) {
-                        cur_ter = tid;
+                    const tripoint blob_location = location + point( x, y );
+                    if( one_in( 1 + abs( x ) + abs( y ) ) && elem.can_be_placed_on( ter( blob_location ) ) ) {
+                        ter_set( blob_location, tid );
                     }
                 }
             }
@@ -4010,6 +4212,11 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
     return placement.instances_placed <
            placement.special_details->occurrences.min;
 } ) ) {
+        if( generating_off_thread ) {
+            // That needs the overmapbuffer, the overmap is generated on the game thread instead.
+            needs_game_thread = true;
+            return;
+        }
         // Randomly select from among the nearest uninitialized overmap positions.
         int previous_distance = 0;
         std::vector<point> nearest_candidates;
@@ -4195,18 +4402,21 @@ void overmap::open( overmap_special_batch &enabled_specials )
         const std::string plrfilename = overmapbuffer::player_filename( loc );
         read_from_file_optional( plrfilename, std::bind( &overmap::unserialize_view, this, _1 ) );
     } else { // No map exists!  Prepare neighbors, and generate one.
-        std::vector<const overmap *> pointers;
+        std::vector<std::unique_ptr<overmap_border>> borders;
         // Fetch south and north
         for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( 0, i ) ) );
+            const overmap *neighbour = overmap_buffer.get_existing( loc + point( 0, i ) );
+            borders.push_back( neighbour ? std::make_unique<overmap_border>( *neighbour ) : nullptr );
         }
         // Fetch east and west
         for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( i, 0 ) ) );
+            const overmap *neighbour = overmap_buffer.get_existing( loc + point( i, 0 ) );
+            borders.push_back( neighbour ? std::make_unique<overmap_border>( *neighbour ) : nullptr );
         }
 
-        // pointers looks like (north, south, west, east)
-        generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
+        // borders looks like (north, south, west, east)
+        generate( borders[0].get(), borders[3].get(), borders[1].get(), borders[2].get(),
+                  enabled_specials );
     }
 }
 
@@ -4229,7 +4439,7 @@ void overmap::add_mon_group( const mongroup &group )
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert( std::pair<tripoint, mongroup>( group.pos, group ) );
+        zg.insert( group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
@@ -2,6 +2,7 @@
 #ifndef OVERMAP_H
 #define OVERMAP_H
 
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include <array>
@@ -156,6 +157,25 @@ class overmap_special_batch
         point origin_overmap;
 };
 
+class overmap;
+
+/**
+ * The parts of an overmap that generating its neighbours reads: the ground level terrain
+ * along its edges and the roads that leave it. Much cheaper to copy than the whole overmap.
+ */
+struct overmap_border {
+    explicit overmap_border( const overmap &om );
+
+    // Terrain at the given ground level point, which must be on one of the edges.
+    const oter_id &get_ter( int x, int y ) const;
+
+    std::array<oter_id, OMAPX> north_edge;
+    std::array<oter_id, OMAPY> east_edge;
+    std::array<oter_id, OMAPX> south_edge;
+    std::array<oter_id, OMAPY> west_edge;
+    std::vector<city> roads_out;
+};
+
 class overmap
 {
     public:
@@ -192,9 +212,25 @@ class overmap
          * coordinates), or empty vector if no matching terrain is found.
          */
         std::vector<point> find_terrain( const std::string &term, int zlevel );
-
-        oter_id &ter( const int x, const int y, const int z );
-        oter_id &ter( const tripoint &p );
+        /**
+         * Return the (local) overmap terrain coordinates of every terrain on z-level
+         * origin.z for which matches returns true and whose distance to origin (in x or y,
+         * origin is in local coordinates and may be outside of this overmap) is between
+         * min_dist and max_dist.
+         * If om_special is set, only terrain placed as part of that special is returned.
+         * This uses the terrain index and only looks at the parts of the overmap that
+         * contain matching terrain, matches is called once per distinct terrain.
+         */
+        std::vector<tripoint> find_ter( const std::function<bool( const oter_id & )> &matches,
+                                        const tripoint &origin, int min_dist, int max_dist,
+                                        const cata::optional<overmap_special_id> &om_special =
+                                            cata::nullopt ) const;
+
+        const oter_id &ter( const int x, const int y, const int z ) const;
+        const oter_id &ter( const tripoint &p ) const;
+        /** Changes the terrain and keeps the terrain index (see @ref find_ter) current. */
+        void ter_set( const int x, const int y, const int z, const oter_id &id );
+        void ter_set( const tripoint &p, const oter_id &id );
         const oter_id get_ter( const int x, const int y, const int z ) const;
         const oter_id get_ter( const tripoint &p ) const;
         bool &seen( int x, int y, int z );
@@ -302,11 +338,15 @@ class overmap
 
         void clear_mon_groups();
     private:
-        std::multimap<tripoint, mongroup> zg;
+        mongroup_map zg;
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
         bool monster_check( const std::pair<tripoint, monster> &candidate ) const;
+        /** Unit test enabler to place a monster group exactly as given. */
+        void insert_mongroup( const mongroup &group ) {
+            zg.insert( group );
+        }
 
         // TODO: make private
         std::vector<radio_tower> radios;
@@ -349,6 +389,22 @@ class overmap
         // can be used after placement to lookup whether a given location was created
         // as part of a special.
         std::unordered_map<tripoint, overmap_special_id> overmap_special_placements;
+        // The same placements by special, for find_ter.
+        std::unordered_map<overmap_special_id, std::vector<tripoint>> overmap_special_positions;
+
+        // Terrain index for find_ter: how many tiles of each terrain are in each block of
+        // ter_index_block x ter_index_block tiles, per z-level. Kept current by ter_set.
+        static constexpr int ter_index_block = 12;
+        static constexpr int ter_index_blocks_x = OMAPX / ter_index_block;
+        static constexpr int ter_index_blocks_y = OMAPY / ter_index_block;
+        using ter_block_counts = std::array<uint8_t, ter_index_blocks_x * ter_index_blocks_y>;
+        std::array<std::unordered_map<oter_id, ter_block_counts>, OVERMAP_LAYERS> ter_index;
+
+        static int ter_index_block_of( const point &p ) {
+            return p.x / ter_index_block * ter_index_blocks_y + p.y / ter_index_block;
+        }
+        void build_ter_index();
+        void add_special_placement( const tripoint &p, const overmap_special_id &id );
 
         regional_settings settings;
 
@@ -356,8 +412,19 @@ class overmap
 
         // Initialize
         void init_layers();
+        // The default specials, filtered by the feature flags of the region settings
+        overmap_special_batch get_enabled_specials() const;
         // open existing overmap, or generate a new one
         void open( overmap_special_batch &enabled_specials );
+
+        // Set while the overmap is generated by generate_off_thread.
+        bool generating_off_thread = false;
+        // Set if generate_off_thread stopped because generation needs the overmapbuffer.
+        bool needs_game_thread = false;
+        // Errors found by generate_off_thread, debugmsg may only be called on the game thread.
+        std::vector<std::string> deferred_errors;
+        // Reports an error during generation, or defers it if generating off the game thread.
+        void generation_error( const std::string &message );
     public:
 
         /**
@@ -377,16 +444,32 @@ class overmap
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fin ) const;
     private:
-        void generate( const overmap *north, const overmap *east,
-                       const overmap *south, const overmap *west,
+        void generate( const overmap_border *north, const overmap_border *east,
+                       const overmap_border *south, const overmap_border *west,
                        overmap_special_batch &enabled_specials );
+        /**
+         * Same as @ref generate, but safe to call on another thread. Generation only reads the
+         * borders of the neighbours and the game data, and it draws from its own random
+         * engine (seeded by the world seed and the position), so the result is the same as
+         * that of generating the overmap on the game thread. Errors
+         * are kept in @ref deferred_errors for the game thread to report.
+         * @return False if generation stopped because it would have to create other overmaps
+         * (which only the game thread may do), the overmap must be discarded then.
+         */
+        bool generate_off_thread( const overmap_border *north, const overmap_border *east,
+                                  const overmap_border *south, const overmap_border *west,
+                                  overmap_special_batch &enabled_specials );
         bool generate_sub( const int z );
 
         const city &get_nearest_city( const tripoint &p ) const;
 
         void signal_hordes( const tripoint &p, int sig_power );
         void process_mongroups();
-        void move_hordes();
+        /**
+         * Moves the hordes of this overmap. Returns the hordes that are outside of the
+         * overmap afterwards, with positions still relative to this overmap.
+         */
+        std::vector<mongroup> move_hordes();
 
         static bool obsolete_terrain( const std::string &ter );
         void convert_terrain( const std::unordered_map<tripoint, std::string> &needs_conversion );
@@ -395,14 +478,14 @@ class overmap
         void place_river( point pa, point pb );
         void place_forests();
         void place_lakes();
-        void place_rivers( const overmap *north, const overmap *east, const overmap *south,
-                           const overmap *west );
+        void place_rivers( const overmap_border *north, const overmap_border *east,
+                           const overmap_border *south, const overmap_border *west );
         void place_swamps();
         void place_forest_trails();
         void place_forest_trailheads();
 
-        void place_roads( const overmap *north, const overmap *east, const overmap *south,
-                          const overmap *west );
+        void place_roads( const overmap_border *north, const overmap_border *east,
+                          const overmap_border *south, const overmap_border *west );
 
         // City Building
         overmap_special_id pick_random_building_to_place( int town_dist ) const;
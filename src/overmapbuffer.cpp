@@ -4,12 +4,14 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <exception>
 #include <sstream>
 #include <iterator>
 #include <list>
 #include <map>
 
 #include "avatar.h"
+#include "background_job.h"
 #include "basecamp.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
@@ -41,11 +43,41 @@ class map_extra;
 
 overmapbuffer overmap_buffer;
 
+// Positions of the neighbours relative to an overmap, in the order overmap::generate takes them.
+static const std::array<point, 4> neighbour_offsets = {{
+        point( 0, -1 ), point( 1, 0 ), point( 0, 1 ), point( -1, 0 )
+    }
+};
+
+/**
+ * An overmap generated on a background thread, see overmapbuffer::pregenerate_near.
+ * The game thread must not touch the overmap until the worker has finished.
+ */
+struct overmap_generation_job {
+    point pos;
+    std::unique_ptr<overmap> om;
+    overmap_special_batch specials;
+    /**
+     * Copies of the borders of the neighbours (in the order of @ref neighbour_offsets) that
+     * existed when the job started, the game thread may change the originals meanwhile.
+     */
+    std::array<std::unique_ptr<overmap_border>, 4> neighbours;
+    bool generated = false;
+    // Last, so the thread is joined before anything it uses is destroyed.
+    background_job worker;
+
+    overmap_generation_job( std::unique_ptr<overmap> new_om, overmap_special_batch &&enabled ) :
+        pos( new_om->pos() ), om( std::move( new_om ) ), specials( std::move( enabled ) ) {
+    }
+};
+
 overmapbuffer::overmapbuffer()
     : last_requested_overmap( nullptr )
 {
 }
 
+overmapbuffer::~overmapbuffer() = default;
+
 const city_reference city_reference::invalid{ nullptr, tripoint(), -1 };
 
 int city_reference::get_distance_from_bounds() const
@@ -85,7 +117,12 @@ overmap &overmapbuffer::get( const point &p )
         return *last_requested_overmap;
     }
 
-    const auto it = overmaps.find( p );
+    auto it = overmaps.find( p );
+    if( it == overmaps.end() && generation_job && generation_job->pos == p ) {
+        // Waiting for it is quicker than starting over.
+        finish_generation( true );
+        it = overmaps.find( p );
+    }
     if( it != overmaps.end() ) {
         return *( last_requested_overmap = it->second.get() );
     }
@@ -114,20 +151,109 @@ void overmapbuffer::create_custom_overmap( const point &p, overmap_special_batch
     new_om.populate( specials );
 }
 
+void overmapbuffer::pregenerate_near( const tripoint &p, const int distance )
+{
+    finish_generation( false );
+    if( distance <= 0 || generation_job ) {
+        return;
+    }
+    point local = p.xy();
+    const point om_pos = omt_to_om_remain( local );
+    std::vector<std::pair<int, point>> candidates;
+    for( int dx = -1; dx <= 1; dx++ ) {
+        for( int dy = -1; dy <= 1; dy++ ) {
+            // Distance to the closest tile of the neighbour.
+            const int dist_x = dx < 0 ? local.x + 1 : dx > 0 ? OMAPX - local.x : 0;
+            const int dist_y = dy < 0 ? local.y + 1 : dy > 0 ? OMAPY - local.y : 0;
+            if( ( dx != 0 || dy != 0 ) && std::max( dist_x, dist_y ) <= distance ) {
+                candidates.emplace_back( std::max( dist_x, dist_y ), om_pos + point( dx, dy ) );
+            }
+        }
+    }
+    std::sort( candidates.begin(), candidates.end() );
+
+    for( const auto &candidate : candidates ) {
+        const point &pos = candidate.second;
+        if( overmaps.count( pos ) > 0 || pregeneration_failed.count( pos ) > 0 ) {
+            continue;
+        }
+        if( known_non_existing.count( pos ) == 0 ) {
+            if( file_exist( terrain_filename( pos ) ) ) {
+                // It is loaded when needed, not generated.
+                continue;
+            }
+            known_non_existing.insert( pos );
+        }
+
+        // Same as overmap::open, that may load the neighbours from disk.
+        std::array<std::unique_ptr<overmap_border>, 4> neighbours;
+        for( size_t i = 0; i < neighbour_offsets.size(); i++ ) {
+            if( const overmap *neighbour = get_existing( pos + neighbour_offsets[i] ) ) {
+                neighbours[i] = std::make_unique<overmap_border>( *neighbour );
+            }
+        }
+        std::unique_ptr<overmap> new_om = std::make_unique<overmap>( pos );
+        overmap_special_batch specials = new_om->get_enabled_specials();
+        generation_job = std::make_unique<overmap_generation_job>( std::move( new_om ),
+                         std::move( specials ) );
+        generation_job->neighbours = std::move( neighbours );
+        overmap_generation_job &job = *generation_job;
+        job.worker.start( [&job]() {
+            try {
+                job.generated = job.om->generate_off_thread( job.neighbours[0].get(),
+                                job.neighbours[1].get(), job.neighbours[2].get(), job.neighbours[3].get(),
+                                job.specials );
+            } catch( const std::exception & ) {
+                // It is generated again on the game thread, which reports the error.
+                job.generated = false;
+            }
+        } );
+        return;
+    }
+}
+
+void overmapbuffer::finish_generation( const bool wait )
+{
+    if( !generation_job || ( !wait && !generation_job->worker.finished() ) ) {
+        return;
+    }
+    std::unique_ptr<overmap_generation_job> job = std::move( generation_job );
+    job->worker.wait();
+    if( !job->generated ) {
+        pregeneration_failed.insert( job->pos );
+        return;
+    }
+    if( overmaps.count( job->pos ) > 0 ) {
+        return;
+    }
+    for( size_t i = 0; i < neighbour_offsets.size(); i++ ) {
+        const bool exists = overmaps.count( job->pos + neighbour_offsets[i] ) > 0;
+        if( exists != ( job->neighbours[i] != nullptr ) ) {
+            return;
+        }
+    }
+    overmap &new_om = *( overmaps[job->pos] = std::move( job->om ) );
+    known_non_existing.erase( job->pos );
+    num_pregenerated++;
+    for( const std::string &message : new_om.deferred_errors ) {
+        debugmsg( "%s", message );
+    }
+    new_om.deferred_errors.clear();
+    fix_mongroups( new_om );
+    fix_npcs( new_om );
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
-    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        auto &mg = it->second;
+    new_overmap.zg.remove_if( [&]( const mongroup & mg ) {
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
-            continue;
+            return true;
         }
         // Inside the bounds of the overmap?
         if( mg.pos.x >= 0 && mg.pos.y >= 0 && mg.pos.x < OMAPX * 2 && mg.pos.y < OMAPY * 2 ) {
-            ++it;
-            continue;
+            return false;
         }
         point smabs( mg.pos.x + new_overmap.pos().x * OMAPX * 2,
                      mg.pos.y + new_overmap.pos().y * OMAPY * 2 );
@@ -135,15 +261,15 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         if( !has( omp ) ) {
             // Don't generate new overmaps, as this can be called from the
             // overmap-generating code.
-            ++it;
-            continue;
+            return false;
         }
         overmap &om = get( omp );
-        mg.pos.x = smabs.x;
-        mg.pos.y = smabs.y;
-        om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
-    }
+        mongroup moved = mg;
+        moved.pos.x = smabs.x;
+        moved.pos.y = smabs.y;
+        om.add_mon_group( moved );
+        return true;
+    } );
 }
 
 void overmapbuffer::fix_npcs( overmap &new_overmap )
@@ -206,6 +332,8 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    generation_job.reset();
+    pregeneration_failed.clear();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
@@ -488,8 +616,29 @@ void overmapbuffer::move_hordes()
     // arbitrary radius to include nearby overmaps (aside from the current one)
     const auto radius = MAPSIZE * 2;
     const auto center = g->u.global_sm_location();
+    // Hordes that walked off their overmap, with absolute submap positions. They are handed
+    // over after all overmaps have moved their hordes, so none of them is moved twice.
+    std::vector<std::pair<overmap *, mongroup>> left_overmap;
     for( auto &om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+        const point om_sm = om_to_sm_copy( om->pos() );
+        for( mongroup &mg : om->move_hordes() ) {
+            mg.pos += om_sm;
+            mg.target += om_sm;
+            left_overmap.emplace_back( om, std::move( mg ) );
+        }
+    }
+    for( auto &elem : left_overmap ) {
+        mongroup &mg = elem.second;
+        point local_sm = mg.pos.xy();
+        const point omp = sm_to_om_remain( local_sm );
+        // Hordes don't create overmaps, they stay just outside of their old one until the
+        // adjacent overmap is loaded (see fix_mongroups).
+        overmap &dest = has( omp ) ? get( omp ) : *elem.first;
+        const point dest_sm = om_to_sm_copy( dest.pos() );
+        mg.pos -= dest_sm;
+        mg.target -= dest_sm;
+        // Not add_mon_group, that would spread hordes with a larger radius out again.
+        dest.zg.insert( std::move( mg ) );
     }
 }
 
@@ -515,13 +664,10 @@ std::vector<mongroup *> overmapbuffer::groups_at( const tripoint &p )
         return result;
     }
     overmap &om = get( omp );
-    auto groups_range = om.zg.equal_range( tripoint( sm_within_om, p.z ) );
-    for( auto it = groups_range.first; it != groups_range.second; ++it ) {
-        mongroup &mg = it->second;
-        if( mg.empty() ) {
-            continue;
+    for( mongroup *mg : om.zg.at( tripoint( sm_within_om, p.z ) ) ) {
+        if( !mg->empty() ) {
+            result.push_back( mg );
         }
-        result.push_back( &mg );
     }
     return result;
 }
@@ -628,12 +774,18 @@ void overmapbuffer::set_seen( const tripoint &p, bool seen )
     om_loc.om->seen( om_loc.local ) = seen;
 }
 
-oter_id &overmapbuffer::ter( const tripoint &p )
+const oter_id &overmapbuffer::ter( const tripoint &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
     return om_loc.om->ter( om_loc.local );
 }
 
+void overmapbuffer::ter_set( const tripoint &p, const oter_id &id )
+{
+    const overmap_with_local_coords om_loc = get_om_global( p );
+    om_loc.om->ter_set( om_loc.local, id );
+}
+
 bool overmapbuffer::reveal( const point &center, int radius, int z )
 {
     return reveal( tripoint( center, z ), radius );
@@ -878,6 +1030,28 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string
                                    existing_overmaps_only, om_special );
     return find_closest( origin, params );
 }
+// Position of a location (relative to the origin) in the order in which find_closest scans
+// the expanding box: by distance, then along the edges, then by z-level and finally by edge
+// (north, south, west, east). Returns false for locations the scan skips.
+static bool closest_scan_order( const point &offset, const int z, const int min_distance,
+                                std::array<int, 4> &order )
+{
+    const int dist = std::max( std::abs( offset.x ), std::abs( offset.y ) );
+    const int m2 = min_distance * 2;
+    if( offset.y == -dist && offset.x >= -dist + m2 && offset.x <= dist - 1 ) {
+        order = {{ dist, offset.x + dist, z, 0 }};
+    } else if( offset.y == dist && offset.x <= dist - m2 && offset.x >= -dist + 1 ) {
+        order = {{ dist, dist - offset.x, z, 1 }};
+    } else if( offset.x == -dist && offset.y <= dist - m2 && offset.y >= -dist + 1 ) {
+        order = {{ dist, dist - offset.y, z, 2 }};
+    } else if( offset.x == dist && offset.y >= -dist + m2 && offset.y <= dist - 1 ) {
+        order = {{ dist, offset.y + dist, z, 3 }};
+    } else {
+        return false;
+    }
+    return true;
+}
+
 tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_params &params )
 {
     // Check the origin before searching adjacent tiles!
@@ -902,37 +1076,26 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_par
     // and each additional one expends the search to the next concentric circle of overmaps.
     int max = params.search_range ? params.search_range : OMAPX * 5;
     const int min_distance = std::max( 0, params.min_distance );
-    // expanding box
-    for( int dist = min_distance; dist <= max; dist++ ) {
-        // each edge length is 2*dist-2, because corners belong to one edge
-        // south is +y, north is -y
-        for( int i = min_distance * 2; i < dist * 2; i++ ) {
-            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-                //start at northwest, scan north edge
-                const tripoint n_loc( origin.x - dist + i, origin.y - dist, z );
-                if( is_findable_location( n_loc, params ) ) {
-                    return n_loc;
-                }
-
-                //start at southeast, scan south
-                const tripoint s_loc( origin.x + dist - i, origin.y + dist, z );
-                if( is_findable_location( s_loc, params ) ) {
-                    return s_loc;
-                }
-
-                //start at southwest, scan west
-                const tripoint w_loc( origin.x - dist, origin.y + dist - i, z );
-                if( is_findable_location( w_loc, params ) ) {
-                    return w_loc;
-                }
-
-                //start at northeast, scan east
-                const tripoint e_loc( origin.x + dist, origin.y - dist + i, z );
-                if( is_findable_location( e_loc, params ) ) {
-                    return e_loc;
-                }
+    // The expanding box (on all z-levels) is searched in bands of distances, each band is
+    // looked up in the terrain indices at once and the location that scanning the box tile
+    // by tile would reach first wins.
+    static constexpr int band_width = OMAPX / 4;
+    for( int band_min = min_distance; band_min <= max; band_min += band_width ) {
+        const int band_max = std::min( max, band_min + band_width - 1 );
+        tripoint closest = overmap::invalid_tripoint;
+        std::array<int, 4> closest_order = {{ INT_MAX, INT_MAX, INT_MAX, INT_MAX }};
+        for( const tripoint &p : find_all_in_range( origin, params, band_min, band_max,
+                -OVERMAP_DEPTH, OVERMAP_HEIGHT ) ) {
+            std::array<int, 4> order;
+            if( closest_scan_order( ( p - origin ).xy(), p.z, min_distance, order ) &&
+                order < closest_order ) {
+                closest = p;
+                closest_order = order;
             }
         }
+        if( closest != overmap::invalid_tripoint ) {
+            return closest;
+        }
     }
     return overmap::invalid_tripoint;
 }
@@ -940,23 +1103,71 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_par
 std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin,
         const omt_find_params &params )
 {
-    std::vector<tripoint> result;
     // dist == 0 means search a whole overmap diameter.
     const int dist = params.search_range ? params.search_range : OMAPX;
     const int min_distance = std::max( 0, params.min_distance );
-    for( int x = -dist; x <= dist; x++ ) {
-        for( int y = -dist; y <= dist; y++ ) {
-            if( abs( x ) < min_distance && abs( y ) < min_distance ) {
+    std::vector<tripoint> result = find_all_in_range( origin, params, min_distance, dist, origin.z,
+                                   origin.z );
+    // In the order of scanning the area row by row.
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+std::vector<tripoint> overmapbuffer::find_all_in_range( const tripoint &origin,
+        const omt_find_params &params, const int min_dist, const int max_dist, const int min_z,
+        const int max_z )
+{
+    std::vector<tripoint> result;
+    if( min_dist > max_dist ) {
+        return result;
+    }
+    // The same terrain is in many overmaps and on many z-levels, match each one only once.
+    std::unordered_map<oter_id, bool> matching;
+    const std::function<bool( const oter_id & )> matches = [&]( const oter_id & oter ) {
+        const auto iter = matching.find( oter );
+        if( iter != matching.end() ) {
+            return iter->second;
+        }
+        const bool match = is_ot_match( params.type, oter, params.match_type );
+        matching.emplace( oter, match );
+        return match;
+    };
+
+    const point om_min = omt_to_om_copy( origin.xy() - point( max_dist, max_dist ) );
+    const point om_max = omt_to_om_copy( origin.xy() + point( max_dist, max_dist ) );
+    for( int omx = om_min.x; omx <= om_max.x; omx++ ) {
+        for( int omy = om_min.y; omy <= om_max.y; omy++ ) {
+            const point om_pos( omx, omy );
+            const point base( omx * OMAPX, omy * OMAPY );
+            const point local_origin = origin.xy() - base;
+            // Overmaps that are entirely closer than min_dist are not searched (or created).
+            const int farthest = std::max( {
+                std::abs( local_origin.x ), std::abs( local_origin.x - OMAPX + 1 ),
+                std::abs( local_origin.y ), std::abs( local_origin.y - OMAPY + 1 )
+            } );
+            if( farthest < min_dist ) {
                 continue;
             }
-            const tripoint search_loc( origin.x + x, origin.y + y, origin.z );
-            if( is_findable_location( search_loc, params ) ) {
-                result.push_back( search_loc );
+            overmap *om = params.existing_only ? get_existing( om_pos ) : &get( om_pos );
+            if( om == nullptr ) {
+                continue;
+            }
+            for( int z = min_z; z <= max_z; z++ ) {
+                const tripoint local_z( local_origin, z );
+                for( const tripoint &p : om->find_ter( matches, local_z, min_dist, max_dist,
+                                                       params.om_special ) ) {
+                    const bool is_seen = om->seen( p );
+                    if( ( params.must_see && !is_seen ) || ( params.cant_see && is_seen ) ) {
+                        continue;
+                    }
+                    result.push_back( p + base );
+                }
             }
         }
     }
     return result;
 }
+
 std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin, const std::string &type,
         int dist, bool must_be_seen, ot_match_type match_type,
         bool existing_overmaps_only,
@@ -25,6 +25,7 @@ class npc;
 struct om_vehicle;
 class overmap_special_batch;
 class overmap;
+struct overmap_generation_job;
 struct radio_tower;
 struct regional_settings;
 class vehicle;
@@ -117,6 +118,7 @@ class overmapbuffer
 {
     public:
         overmapbuffer();
+        ~overmapbuffer();
 
         static std::string terrain_filename( const point & );
         static std::string player_filename( const point & );
@@ -129,12 +131,31 @@ class overmapbuffer
         void save();
         void clear();
         void create_custom_overmap( const point &, overmap_special_batch &specials );
+        /**
+         * Starts generating a new overmap next to the one containing the position (global
+         * overmap terrain coordinates) on a background thread, if the position is within
+         * distance (in overmap terrain tiles) of it. The overmaps closest to the position are
+         * generated first, one at a time.
+         * A generated overmap is added once it is finished, unless an overmap next to it has
+         * been created meanwhile (it would have been generated differently then). Getting the
+         * overmap before that waits for the generation.
+         */
+        void pregenerate_near( const tripoint &p, int distance );
+        /** Number of overmaps added by @ref pregenerate_near so far. */
+        int pregenerated_count() const {
+            return num_pregenerated;
+        }
+        /** Whether generating the overmap on a background thread failed, @ref get does it then. */
+        bool pregeneration_failed_at( const point &p ) const {
+            return pregeneration_failed.count( p ) > 0;
+        }
 
         /**
          * Uses global overmap terrain coordinates, creates the
          * overmap if needed.
          */
-        oter_id &ter( const tripoint &p );
+        const oter_id &ter( const tripoint &p );
+        void ter_set( const tripoint &p, const oter_id &id );
         /**
          * Uses global overmap terrain coordinates.
          */
@@ -462,6 +483,14 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint &location, const omt_find_params &params );
+        /**
+         * Returns the findable locations (see is_findable_location) on the z-levels min_z to
+         * max_z whose distance (in x or y) to origin is between min_dist and max_dist.
+         * This looks the terrain up in the terrain index of the overmaps in range
+         * (see overmap::find_ter) instead of checking every location.
+         */
+        std::vector<tripoint> find_all_in_range( const tripoint &origin,
+                const omt_find_params &params, int min_dist, int max_dist, int min_z, int max_z );
 
         std::unordered_map< point, std::unique_ptr< overmap > > overmaps;
         /**
@@ -472,6 +501,14 @@ class overmapbuffer
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
 
+        // Overmap that is being generated by pregenerate_near.
+        std::unique_ptr<overmap_generation_job> generation_job;
+        // Overmaps that could not be generated on the background thread, they are not tried again.
+        std::set<point> pregeneration_failed;
+        int num_pregenerated = 0;
+        /** Adds the overmap of @ref generation_job if it has finished (or after waiting for it). */
+        void finish_generation( bool wait );
+
         /**
          * Get a list of notes in the (loaded) overmaps.
          * @param z only this specific z-level is search for notes.
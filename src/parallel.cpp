@@ -0,0 +1,71 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+// Set while a thread is working on a parallel_for, nested calls run serially.
+static thread_local bool in_parallel_for = false;
+// See set_parallel_thread_count, 0 if not overridden.
+static std::atomic<int> thread_count_override( 0 );
+
+int parallel_thread_count()
+{
+    static const int count = std::max( 1u, std::thread::hardware_concurrency() );
+    const int override_count = thread_count_override;
+    return override_count > 0 ? override_count : count;
+}
+
+void set_parallel_thread_count( const int count )
+{
+    thread_count_override = std::max( 0, count );
+}
+
+void parallel_for( const int begin, const int end, const std::function<void( int )> &f )
+{
+    const int num_threads = std::min( parallel_thread_count(), end - begin );
+    if( num_threads <= 1 || in_parallel_for ) {
+        for( int i = begin; i < end; ++i ) {
+            f( i );
+        }
+        return;
+    }
+
+    std::atomic<int> next( begin );
+    std::vector<std::exception_ptr> errors( num_threads );
+    const auto work = [&]( const int thread_index ) {
+        in_parallel_for = true;
+        try {
+            for( int i = next++; i < end; i = next++ ) {
+                f( i );
+            }
+        } catch( ... ) {
+            errors[thread_index] = std::current_exception();
+            // Let the other threads run out of work.
+            next = end;
+        }
+        in_parallel_for = false;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( num_threads - 1 );
+    for( int t = 1; t < num_threads; ++t ) {
+        threads.emplace_back( work, t );
+    }
+    work( 0 );
+    for( std::thread &t : threads ) {
+        t.join();
+    }
+
+    for( const std::exception_ptr &e : errors ) {
+        if( e ) {
+            std::rethrow_exception( e );
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+/**
+ * Number of threads @ref parallel_for will use at most, including the calling thread.
+ * Always at least 1.
+ */
+int parallel_thread_count();
+
+/**
+ * Makes @ref parallel_for use the given number of threads instead of one per hardware
+ * thread, so the threaded code paths can be tested on single core machines.
+ * 0 restores the default.
+ */
+void set_parallel_thread_count( int count );
+
+/**
+ * Calls `f( i )` for each `i` in [begin, end), spreading the calls over several threads.
+ * The calling thread takes part in the work and the function returns only after all
+ * calls are done. The order of the calls is unspecified, so `f` must only write to
+ * state that belongs to its own index; combining the results (in index order) is up to
+ * the caller, which keeps the outcome identical to a serial loop.
+ * Nested calls (from inside `f`) run serially on the current thread.
+ * If `f` throws, the first exception is rethrown in the calling thread once all
+ * threads have finished.
+ */
+void parallel_for( int begin, int end, const std::function<void( int )> &f );
+
+#endif
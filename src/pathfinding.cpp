@@ -1,5 +1,6 @@
 #include "pathfinding.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include <queue>
@@ -24,7 +25,7 @@
 #include "type_id.h"
 #include "point.h"
 
-enum astar_state {
+enum astar_state : uint8_t {
     ASL_NONE,
     ASL_OPEN,
     ASL_CLOSED
@@ -36,37 +37,98 @@ constexpr int flat_index( const int x, const int y )
     return ( x * MAPSIZE_Y ) + y;
 }
 
+// Parents are stored as a single int: the flat index and the z-level of the parent tile.
+// Parents are mostly adjacent, but stairs can jump anywhere within the overmap tile.
+constexpr int encode_parent( const tripoint &p )
+{
+    return flat_index( p.x, p.y ) * OVERMAP_LAYERS + p.z + OVERMAP_DEPTH;
+}
+
+constexpr tripoint decode_parent( const int parent )
+{
+    return tripoint( parent / OVERMAP_LAYERS / MAPSIZE_Y, parent / OVERMAP_LAYERS % MAPSIZE_Y,
+                     parent % OVERMAP_LAYERS - OVERMAP_DEPTH );
+}
+
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// The data of a tile is only valid if its stamp matches the generation of the
+// current search, otherwise the tile counts as unvisited. This way the layer can
+// be reused by the next search without being cleared.
 struct path_data_layer {
+    uint32_t generation = 0;
+    std::array< uint32_t, MAPSIZE_X *MAPSIZE_Y > stamp;
     // State is accessed way more often than all other values here
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
-    std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
-
-    void init( const int minx, const int miny, const int maxx, const int maxy ) {
-        for( int x = minx; x <= maxx; x++ ) {
-            for( int y = miny; y <= maxy; y++ ) {
-                const int ind = flat_index( x, y );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    std::array< int, MAPSIZE_X *MAPSIZE_Y > parent;
+
+    // Resets the tile to unvisited if it was last touched by an older search.
+    void touch( const int index ) {
+        if( stamp[index] != generation ) {
+            stamp[index] = generation;
+            state[index] = ASL_NONE;
+            score[index] = 0;
+            gscore[index] = 0;
+            parent[index] = encode_parent( tripoint_zero );
         }
     }
-};
 
-struct pathfinder {
-    int minx;
-    int miny;
-    int maxx;
-    int maxy;
-    pathfinder( int _minx, int _miny, int _maxx, int _maxy ) :
-        minx( _minx ), miny( _miny ), maxx( _maxx ), maxy( _maxy ) {
+    astar_state &state_at( const int index ) {
+        touch( index );
+        return state[index];
+    }
+    int &score_at( const int index ) {
+        touch( index );
+        return score[index];
     }
+    int &gscore_at( const int index ) {
+        touch( index );
+        return gscore[index];
+    }
+    tripoint parent_at( const int index ) {
+        touch( index );
+        return decode_parent( parent[index] );
+    }
+};
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+// Reused between searches (one per thread), so the layers and the open list
+// are only allocated once instead of for every route.
+struct pathfinder {
+    int minx = 0;
+    int miny = 0;
+    int maxx = 0;
+    int maxy = 0;
+    uint32_t generation = 0;
+
+    // Binary heap ordered by score, smallest first
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
 
+    // Prepares the pathfinder for a new search, invalidating all data of the last one.
+    void reset( const int _minx, const int _miny, const int _maxx, const int _maxy ) {
+        minx = _minx;
+        miny = _miny;
+        maxx = _maxx;
+        maxy = _maxy;
+        open.clear();
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around, stamps of ancient searches could match again
+            for( auto &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->stamp.fill( 0 );
+                }
+            }
+            generation = 1;
+        }
+        for( auto &ptr : path_data ) {
+            if( ptr != nullptr ) {
+                ptr->generation = generation;
+            }
+        }
+    }
+
     path_data_layer &get_layer( const int z ) {
         auto &ptr = path_data[z + OVERMAP_DEPTH];
         if( ptr != nullptr ) {
@@ -74,7 +136,7 @@ struct pathfinder {
         }
 
         ptr = std::make_unique<path_data_layer>();
-        ptr->init( minx, miny, maxx, maxy );
+        ptr->generation = generation;
         return *ptr;
     }
 
@@ -83,36 +145,39 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to.x, to.y );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.state_at( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) ||
+            state == ASL_CLOSED ) {
             return;
         }
 
         layer.state [index] = ASL_OPEN;
         layer.gscore[index] = gscore;
-        layer.parent[index] = from;
+        layer.parent[index] = encode_parent( from );
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_CLOSED;
+        layer.state_at( index ) = ASL_CLOSED;
     }
 
     void unclose_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_NONE;
+        layer.state_at( index ) = ASL_NONE;
     }
 };
 
@@ -179,6 +244,437 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// Tiles that are not plain flat ground
+static constexpr pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP;
+
+// Routes at least this long are planned on the pathfinding_graph first
+static constexpr int hierarchical_route_min_dist = SEEX * 4;
+
+// Border sides of a submap, as used by pathfinding_graph::entrance::side
+static constexpr std::array<point, 4> side_offsets = {{
+        point( 0, -1 ), point( 1, 0 ), point( 0, 1 ), point( -1, 0 )
+    }
+};
+
+// Kinds of settings with a pathfinding_graph of their own, they change which tiles can be
+// entered and what that costs.
+enum graph_class_flag : int {
+    GRAPH_BASH = 1,
+    GRAPH_DOORS = 2,
+    GRAPH_CLIMB = 4,
+    GRAPH_AVOID_TRAPS = 8,
+    GRAPH_AVOID_ROUGH = 16,
+};
+
+static int graph_class( const pathfinding_settings &settings )
+{
+    if( settings.avoid_rough_terrain ) {
+        // Closes every tile that isn't plain flat ground, nothing else matters then
+        return GRAPH_AVOID_ROUGH;
+    }
+    return ( settings.bash_strength > 0 ? GRAPH_BASH : 0 ) |
+           ( settings.allow_open_doors ? GRAPH_DOORS : 0 ) |
+           ( settings.climb_cost > 0 ? GRAPH_CLIMB : 0 ) |
+           ( settings.avoid_traps ? GRAPH_AVOID_TRAPS : 0 );
+}
+
+// Costs route() assigns depending on the exact settings. The graph uses the cheapest case,
+// the legs of a planned route are searched with the real settings.
+// Bashing at full strength: 20 / 10 turns of bashing, 2 to move there and a penalty of 10
+static constexpr int graph_bash_cost = 14;
+// Climbing, as most climbing monsters do
+static constexpr int graph_climb_cost = 3;
+
+// Cost route() assigns to entering the tile with settings of the given class, -1 if they
+// can't enter it. Tiles that only some of these settings can enter count as passable.
+static int graph_tile_cost( const map &m, const tripoint &p, const pf_special special,
+                            const int graph_class )
+{
+    if( !( special & non_normal ) ) {
+        return 2;
+    }
+    if( graph_class & GRAPH_AVOID_ROUGH ) {
+        return -1;
+    }
+    const int trap_cost = ( graph_class & GRAPH_AVOID_TRAPS ) && ( special & PF_TRAP ) ? 500 : 0;
+    if( !( special & PF_WALL ) ) {
+        return m.move_cost( p ) + trap_cost;
+    }
+    if( ( graph_class & GRAPH_CLIMB ) && ( special & PF_CLIMBABLE ) ) {
+        return graph_climb_cost + trap_cost;
+    }
+    const ter_t &terrain = m.ter( p ).obj();
+    if( ( graph_class & GRAPH_DOORS ) && terrain.open ) {
+        return 4 + trap_cost;
+    }
+    if( special & PF_VEHICLE ) {
+        const cata::optional<vpart_reference> obstacle = m.veh_at( p ).obstacle_at_part();
+        if( !obstacle ) {
+            return -1;
+        } else if( ( graph_class & GRAPH_DOORS ) && obstacle->has_feature( VPFLAG_OPENABLE ) ) {
+            return 10 + trap_cost;
+        } else if( graph_class & GRAPH_BASH ) {
+            return graph_bash_cost + trap_cost;
+        }
+        return -1;
+    }
+    const furn_t &furniture = m.furn( p ).obj();
+    const bool bashable = ( furniture.id && furniture.bash.str_max != -1 ) ||
+                          ( terrain.bash.str_max != -1 && !terrain.bash.bash_below );
+    if( ( graph_class & GRAPH_BASH ) && bashable ) {
+        return graph_bash_cost + trap_cost;
+    }
+    return -1;
+}
+
+static int tile_cost_at( const pathfinding_graph &graph, const point &p )
+{
+    return graph.submaps[( p.x / SEEX ) * MAPSIZE + p.y / SEEY].tile_costs[( p.x % SEEX ) * SEEY +
+            p.y % SEEY];
+}
+
+// Tiles route() might enter with the settings of the graph. Vehicle tiles always count,
+// route() looks at their parts, so areas never split what it could connect.
+static bool area_passable( const pathfinding_graph &graph, const pathfinding_cache &cache,
+                           const point &p )
+{
+    return tile_cost_at( graph, p ) >= 0 || ( cache.special[p.x][p.y] & PF_VEHICLE );
+}
+
+// Labels the 8-connected areas of passable tiles of the first `size` x `size` tiles.
+static void label_areas( pathfinding_graph &graph, const pathfinding_cache &cache, const int size )
+{
+    graph.areas.fill( 0 );
+    uint16_t next_area = 0;
+    std::vector<point> todo;
+    for( int x = 0; x < size; x++ ) {
+        for( int y = 0; y < size; y++ ) {
+            const point start( x, y );
+            if( graph.areas[flat_index( x, y )] != 0 || !area_passable( graph, cache, start ) ) {
+                continue;
+            }
+            next_area++;
+            graph.areas[flat_index( x, y )] = next_area;
+            todo.push_back( start );
+            while( !todo.empty() ) {
+                const point cur = todo.back();
+                todo.pop_back();
+                for( int dx = -1; dx <= 1; dx++ ) {
+                    for( int dy = -1; dy <= 1; dy++ ) {
+                        const point p = cur + point( dx, dy );
+                        if( p.x < 0 || p.x >= size || p.y < 0 || p.y >= size ) {
+                            continue;
+                        }
+                        uint16_t &area = graph.areas[flat_index( p.x, p.y )];
+                        if( area != 0 || !area_passable( graph, cache, p ) ) {
+                            continue;
+                        }
+                        area = next_area;
+                        todo.push_back( p );
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Cost of walking from `from` to every tile of a submap without leaving it. Both use
+// submap square coordinates, indexed like pathfinding_graph::submap_node::tile_costs,
+// -1 if unreachable.
+static void submap_costs( const std::array<int16_t, SEEX *SEEY> &tile_costs, const point &from,
+                          std::array<int, SEEX *SEEY> &costs )
+{
+    costs.fill( -1 );
+    std::priority_queue< std::pair<int, point>, std::vector< std::pair<int, point> >, pair_greater_cmp_first >
+    open;
+    costs[from.x * SEEY + from.y] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const std::pair<int, point> cur = open.top();
+        open.pop();
+        if( cur.first > costs[cur.second.x * SEEY + cur.second.y] ) {
+            continue;
+        }
+        for( int dx = -1; dx <= 1; dx++ ) {
+            for( int dy = -1; dy <= 1; dy++ ) {
+                const point p = cur.second + point( dx, dy );
+                if( ( dx == 0 && dy == 0 ) || p.x < 0 || p.x >= SEEX || p.y < 0 || p.y >= SEEY ) {
+                    continue;
+                }
+                const int tile_cost = tile_costs[p.x * SEEY + p.y];
+                if( tile_cost < 0 ) {
+                    continue;
+                }
+                const int cost = cur.first + tile_cost + ( dx != 0 && dy != 0 ? 1 : 0 );
+                int &old_cost = costs[p.x * SEEY + p.y];
+                if( old_cost < 0 || cost < old_cost ) {
+                    old_cost = cost;
+                    open.emplace( cost, p );
+                }
+            }
+        }
+    }
+}
+
+const pathfinding_graph &map::update_pathfinding_graph( const int zlev,
+        const int graph_class ) const
+{
+    pathfinding_cache &cache = get_pathfinding_cache( zlev );
+    if( cache.dirty ) {
+        update_pathfinding_cache( zlev );
+    }
+    std::unique_ptr<pathfinding_graph> &graph_ptr = cache.graphs[graph_class];
+    if( graph_ptr == nullptr ) {
+        graph_ptr = std::make_unique<pathfinding_graph>();
+    }
+    pathfinding_graph &graph = *graph_ptr;
+    if( !graph.dirty ) {
+        return graph;
+    }
+
+    // Find the submaps whose tile costs changed, their entrances and the entrances
+    // of their neighbors need to be recalculated.
+    std::array<bool, MAPSIZE *MAPSIZE> changed {};
+    bool any_changed = false;
+    for( int smx = 0; smx < my_MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < my_MAPSIZE; smy++ ) {
+            pathfinding_graph::submap_node &node = graph.submaps[smx * MAPSIZE + smy];
+            std::array<int16_t, SEEX *SEEY> tile_costs;
+            for( int sx = 0; sx < SEEX; sx++ ) {
+                for( int sy = 0; sy < SEEY; sy++ ) {
+                    const tripoint p( smx * SEEX + sx, smy * SEEY + sy, zlev );
+                    tile_costs[sx * SEEY + sy] = static_cast<int16_t>( graph_tile_cost( *this, p,
+                                                 cache.special[p.x][p.y], graph_class ) );
+                }
+            }
+            if( !node.valid || tile_costs != node.tile_costs ) {
+                node.tile_costs = tile_costs;
+                changed[smx * MAPSIZE + smy] = true;
+                any_changed = true;
+            }
+        }
+    }
+
+    std::array<int, SEEX *SEEY> costs;
+    for( int smx = 0; smx < my_MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < my_MAPSIZE; smy++ ) {
+            bool recalc = changed[smx * MAPSIZE + smy];
+            for( const point &offset : side_offsets ) {
+                const point nb( smx + offset.x, smy + offset.y );
+                if( nb.x >= 0 && nb.x < my_MAPSIZE && nb.y >= 0 && nb.y < my_MAPSIZE ) {
+                    recalc = recalc || changed[nb.x * MAPSIZE + nb.y];
+                }
+            }
+            if( !recalc ) {
+                continue;
+            }
+
+            pathfinding_graph::submap_node &node = graph.submaps[smx * MAPSIZE + smy];
+            node.entrances.clear();
+            const point origin( smx * SEEX, smy * SEEY );
+            for( int side = 0; side < 4; side++ ) {
+                const point &offset = side_offsets[side];
+                const point nb( smx + offset.x, smy + offset.y );
+                if( nb.x < 0 || nb.x >= my_MAPSIZE || nb.y < 0 || nb.y >= my_MAPSIZE ) {
+                    continue;
+                }
+                // Tiles along the border, from the top left corner of that side
+                const point first = origin + point( side == 1 ? SEEX - 1 : 0, side == 2 ? SEEY - 1 : 0 );
+                const point step = offset.x == 0 ? point( 1, 0 ) : point( 0, 1 );
+                const int border_length = offset.x == 0 ? SEEX : SEEY;
+                int run_start = -1;
+                for( int i = 0; i <= border_length; i++ ) {
+                    const point inner = first + point( step.x * i, step.y * i );
+                    const point outer = inner + offset;
+                    const bool open = i < border_length && tile_cost_at( graph, inner ) >= 0 &&
+                                      tile_cost_at( graph, outer ) >= 0;
+                    if( open && run_start < 0 ) {
+                        run_start = i;
+                    } else if( !open && run_start >= 0 ) {
+                        const int mid = ( run_start + i - 1 ) / 2;
+                        node.entrances.push_back( { first + point( step.x * mid, step.y * mid ), side } );
+                        run_start = -1;
+                    }
+                }
+            }
+
+            const size_t num = node.entrances.size();
+            node.costs.assign( num * num, -1 );
+            for( size_t i = 0; i < num; i++ ) {
+                submap_costs( node.tile_costs, node.entrances[i].pos - origin, costs );
+                for( size_t j = 0; j < num; j++ ) {
+                    const point to = node.entrances[j].pos - origin;
+                    node.costs[i * num + j] = costs[to.x * SEEY + to.y];
+                }
+            }
+            node.valid = true;
+        }
+    }
+    if( any_changed ) {
+        label_areas( graph, cache, my_MAPSIZE * SEEX );
+    }
+    graph.dirty = false;
+    return graph;
+}
+
+cata::optional<std::vector<tripoint>> map::route_hierarchical( const tripoint &f,
+                                     const tripoint &t, const pathfinding_settings &settings,
+                                     const std::set<tripoint> &pre_closed ) const
+{
+    const pathfinding_graph &graph = update_pathfinding_graph( f.z, graph_class( settings ) );
+
+    // The route never enters its start, so that one may be impassable.
+    const uint16_t t_area = graph.areas[flat_index( t.x, t.y )];
+    const uint16_t f_area = graph.areas[flat_index( f.x, f.y )];
+    if( t_area == 0 || ( f_area != 0 && f_area != t_area ) ) {
+        return std::vector<tripoint>();
+    }
+
+    const point f_sm( f.x / SEEX, f.y / SEEY );
+    const point t_sm( t.x / SEEX, t.y / SEEY );
+    const point f_origin( f_sm.x * SEEX, f_sm.y * SEEY );
+    const point t_origin( t_sm.x * SEEX, t_sm.y * SEEY );
+    const int f_sm_index = f_sm.x * MAPSIZE + f_sm.y;
+    const int t_sm_index = t_sm.x * MAPSIZE + t_sm.y;
+
+    // Node ids: entrances of all submaps, in order, followed by the start and the goal
+    std::array<int, MAPSIZE *MAPSIZE + 1> first_node {};
+    for( int i = 0; i < MAPSIZE * MAPSIZE; i++ ) {
+        first_node[i + 1] = first_node[i] + graph.submaps[i].entrances.size();
+    }
+    const int start_node = first_node.back();
+    const int goal_node = start_node + 1;
+    const auto node_pos = [&]( const int id ) {
+        if( id >= start_node ) {
+            return id == start_node ? f.xy() : t.xy();
+        }
+        const int sm = std::upper_bound( first_node.begin(), first_node.end(), id ) - first_node.begin() - 1;
+        return graph.submaps[sm].entrances[id - first_node[sm]].pos;
+    };
+
+    // Connect start and goal to the entrances of their submaps
+    std::array<int, SEEX *SEEY> from_start;
+    std::array<int, SEEX *SEEY> to_goal;
+    submap_costs( graph.submaps[f_sm_index].tile_costs, f.xy() - f_origin, from_start );
+    submap_costs( graph.submaps[t_sm_index].tile_costs, t.xy() - t_origin, to_goal );
+
+    std::vector<int> gscore( goal_node + 1, -1 );
+    std::vector<int> parent( goal_node + 1, -1 );
+    std::vector<bool> closed( goal_node + 1, false );
+    std::priority_queue< std::pair<int, int>, std::vector< std::pair<int, int> >, pair_greater_cmp_first >
+    open;
+    const auto add_node = [&]( const int id, const int from, const int cost ) {
+        if( closed[id] || ( gscore[id] >= 0 && gscore[id] <= cost ) ) {
+            return;
+        }
+        gscore[id] = cost;
+        parent[id] = from;
+        const point p = node_pos( id );
+        open.emplace( cost + 2 * rl_dist( tripoint( p, f.z ), t ), id );
+    };
+    const auto local_cost = []( const std::array<int, SEEX *SEEY> &costs, const point &origin,
+    const point & p ) {
+        return costs[( p.x - origin.x ) * SEEY + p.y - origin.y];
+    };
+
+    gscore[start_node] = 0;
+    open.emplace( 2 * rl_dist( f, t ), start_node );
+    while( !open.empty() ) {
+        const int cur = open.top().second;
+        open.pop();
+        if( closed[cur] ) {
+            continue;
+        }
+        closed[cur] = true;
+        if( cur == goal_node ) {
+            break;
+        }
+        if( gscore[cur] > settings.max_length ) {
+            // The graph only approximates the costs, let the regular search decide
+            return cata::nullopt;
+        }
+
+        if( cur == start_node ) {
+            const auto &entrances = graph.submaps[f_sm_index].entrances;
+            for( size_t i = 0; i < entrances.size(); i++ ) {
+                const int cost = local_cost( from_start, f_origin, entrances[i].pos );
+                if( cost >= 0 ) {
+                    add_node( first_node[f_sm_index] + i, cur, cost );
+                }
+            }
+            continue;
+        }
+
+        const int sm = std::upper_bound( first_node.begin(), first_node.end(), cur ) - first_node.begin() - 1;
+        const pathfinding_graph::submap_node &node = graph.submaps[sm];
+        const size_t num = node.entrances.size();
+        const size_t index = cur - first_node[sm];
+        const pathfinding_graph::entrance &ent = node.entrances[index];
+
+        if( sm == t_sm_index ) {
+            const int cost = local_cost( to_goal, t_origin, ent.pos );
+            if( cost >= 0 ) {
+                add_node( goal_node, cur, gscore[cur] + cost );
+            }
+        }
+        for( size_t j = 0; j < num; j++ ) {
+            const int cost = node.costs[index * num + j];
+            if( j != index && cost >= 0 ) {
+                add_node( first_node[sm] + j, cur, gscore[cur] + cost );
+            }
+        }
+        // Step over the border onto the matching entrance of the neighbor
+        const point &offset = side_offsets[ent.side];
+        const int nb_sm = sm + offset.x * MAPSIZE + offset.y;
+        const point outer = ent.pos + offset;
+        const auto &nb_entrances = graph.submaps[nb_sm].entrances;
+        for( size_t j = 0; j < nb_entrances.size(); j++ ) {
+            if( nb_entrances[j].pos == outer && nb_entrances[j].side == ( ent.side + 2 ) % 4 ) {
+                add_node( first_node[nb_sm] + j, cur, gscore[cur] + tile_cost_at( graph, outer ) );
+                break;
+            }
+        }
+    }
+    if( !closed[goal_node] ) {
+        // The graph misses diagonal steps between submaps, so this is no proof
+        return cata::nullopt;
+    }
+
+    // Waypoints are the entrances through which the route enters a submap
+    std::vector<tripoint> waypoints;
+    waypoints.push_back( t );
+    for( int cur = parent[goal_node]; cur != start_node; cur = parent[cur] ) {
+        const int prev = parent[cur];
+        if( prev == start_node || rl_dist( node_pos( prev ), node_pos( cur ) ) == 1 ) {
+            waypoints.push_back( tripoint( node_pos( cur ), f.z ) );
+        }
+    }
+    std::reverse( waypoints.begin(), waypoints.end() );
+
+    // The legs are searched with the real settings, they decide about bashing, doors and
+    // traps. Each leg may only use what the previous ones left of the maximum length.
+    pathfinding_settings leg_settings = settings;
+    std::vector<tripoint> ret;
+    tripoint from = f;
+    for( const tripoint &to : waypoints ) {
+        if( from == to ) {
+            continue;
+        }
+        int cost = 0;
+        const std::vector<tripoint> leg = route_astar( from, to, leg_settings, pre_closed, cost );
+        if( leg.empty() ) {
+            return cata::nullopt;
+        }
+        leg_settings.max_length -= cost;
+        if( leg_settings.max_length < 0 ) {
+            return cata::nullopt;
+        }
+        ret.insert( ret.end(), leg.begin(), leg.end() );
+        from = to;
+    }
+    return ret;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -199,7 +695,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP;
     if( f.z == t.z ) {
         const auto line_path = line_to( f, t );
         const auto &pf_cache = get_pathfinding_cache_ref( f.z );
@@ -220,6 +715,25 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    // Long routes are planned on the submap graph first, the search below is only used
+    // for the short pieces between submap entrances then.
+    if( f.z == t.z && rl_dist( f, t ) > hierarchical_route_min_dist ) {
+        const cata::optional<std::vector<tripoint>> planned = route_hierarchical( f, t, settings,
+                pre_closed );
+        if( planned ) {
+            return *planned;
+        }
+    }
+
+    int cost = 0;
+    return route_astar( f, t, settings, pre_closed, cost );
+}
+
+std::vector<tripoint> map::route_astar( const tripoint &f, const tripoint &t,
+                                        const pathfinding_settings &settings,
+                                        const std::set<tripoint> &pre_closed, int &cost ) const
+{
+    std::vector<tripoint> ret;
     int max_length = settings.max_length;
     int bash = settings.bash_strength;
     int climb_cost = settings.climb_cost;
@@ -237,7 +751,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( minx, miny, maxx, maxy );
+    static thread_local pathfinder pf;
+    pf.reset( minx, miny, maxx, maxy );
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -258,7 +773,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.x, cur.y );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
+        auto &cur_state = layer.state_at( parent_index );
         if( cur_state == ASL_CLOSED ) {
             continue;
         }
@@ -292,7 +807,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.state_at( index ) == ASL_CLOSED ) {
                 continue;
             }
 
@@ -399,8 +914,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                     // Otherwise this would have been a huge fall
                                     auto &layer = pf.get_layer( p.z - 1 );
                                     // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                    pf.add_point( layer.gscore_at( parent_index ) + 10,
+                                                  layer.score_at( parent_index ) + 10 + 2 * rl_dist( below, t ),
                                                   cur, below );
                                 }
 
@@ -434,8 +949,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.x, cur.y, cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 2,
+                              layer.score_at( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -443,8 +958,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.x, cur.y, cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 2,
+                              layer.score_at( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -453,21 +968,22 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 4,
+                              layer.score_at( parent_index ) + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
     } while( !done && !pf.empty() );
 
     if( done ) {
+        cost = pf.get_layer( t.z ).gscore_at( flat_index( t.x, t.y ) );
         ret.reserve( rl_dist( f, t ) * 2 );
         tripoint cur = t;
         // Just to limit max distance, in case something weird happens
         for( int fdist = max_length; fdist != 0; fdist-- ) {
             const int cur_index = flat_index( cur.x, cur.y );
-            const auto &layer = pf.get_layer( cur.z );
-            const tripoint &par = layer.parent[cur_index];
+            auto &layer = pf.get_layer( cur.z );
+            const tripoint par = layer.parent_at( cur_index );
             if( cur == f ) {
                 break;
             }
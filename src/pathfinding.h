@@ -2,7 +2,13 @@
 #ifndef PATHFINDING_H
 #define PATHFINDING_H
 
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : char {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -37,6 +43,45 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
+/**
+ * Abstraction of a @ref pathfinding_cache at submap granularity, used to plan long routes.
+ * There is one for each class of @ref pathfinding_settings that differ in which tiles can
+ * be entered: bashing, opening doors, climbing, avoiding traps and avoiding rough terrain.
+ * The border between two submaps is split into runs of tiles that are passable on both
+ * sides, each run gets one entrance on either side (in the middle of the run). The costs of
+ * walking between the entrances of a submap are cached and only recalculated for submaps
+ * (and their neighbors) whose tile costs changed.
+ */
+struct pathfinding_graph {
+    // Settings are sorted into this many classes, see graph_class in pathfinding.cpp
+    static constexpr int num_classes = 32;
+
+    struct entrance {
+        // Map square coordinates
+        point pos;
+        // Border of the submap the entrance is on: 0 north, 1 east, 2 south, 3 west
+        int side;
+    };
+
+    struct submap_node {
+        std::vector<entrance> entrances;
+        // costs[i * entrances.size() + j] is the cost from entrance i to entrance j
+        // without leaving the submap, -1 if it's unreachable.
+        std::vector<int> costs;
+        // Cost of entering each tile, indexed by [x * SEEY + y] (submap square coordinates),
+        // -1 if it can't be entered. The above was calculated from these.
+        std::array<int16_t, SEEX *SEEY> tile_costs;
+        bool valid = false;
+    };
+
+    std::array<submap_node, MAPSIZE *MAPSIZE> submaps;
+    // Connected areas of passable tiles, indexed by [x * MAPSIZE_Y + y], 0 for walls.
+    // Tiles in different areas can't reach each other on this z-level.
+    std::array<uint16_t, MAPSIZE_X *MAPSIZE_Y> areas;
+    // Set when the pathfinding cache was rebuilt, the changed submaps still need to be found
+    bool dirty = true;
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
     ~pathfinding_cache();
@@ -44,6 +89,9 @@ struct pathfinding_cache {
     bool dirty;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    // By class of settings, created when first needed
+    std::array<std::unique_ptr<pathfinding_graph>, pathfinding_graph::num_classes> graphs;
 };
 
 struct pathfinding_settings {
@@ -10,13 +10,13 @@
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
     return rng_uint_dist( rng_get_engine() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -25,22 +25,24 @@ int rng( int lo, int hi )
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
     return rng_real_dist( rng_get_engine(), std::uniform_real_distribution<>::param_type( lo, hi ) );
 }
 
+// Keeps the second value of the last pair it generated, see scoped_rng_engine.
+static thread_local std::normal_distribution<double> rng_normal_dist;
+
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
     return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
     return rng_exponential_dist( rng_get_engine(),
                                  std::exponential_distribution<>::param_type( lambda ) );
 }
@@ -121,8 +123,28 @@ double rng_normal( double lo, double hi )
     return clamp( val, lo, hi );
 }
 
+// Engine of the innermost scoped_rng_engine of this thread.
+static thread_local cata_default_random_engine *scoped_engine = nullptr;
+
+scoped_rng_engine::scoped_rng_engine( const unsigned int seed ) : engine( seed ),
+    previous( scoped_engine )
+{
+    scoped_engine = &engine;
+    // A value generated from the previous engine must not leak into this sequence.
+    rng_normal_dist.reset();
+}
+
+scoped_rng_engine::~scoped_rng_engine()
+{
+    scoped_engine = previous;
+    rng_normal_dist.reset();
+}
+
 cata_default_random_engine &rng_get_engine()
 {
+    if( scoped_engine != nullptr ) {
+        return *scoped_engine;
+    }
     static cata_default_random_engine eng(
         std::chrono::high_resolution_clock::now().time_since_epoch().count() );
     return eng;
@@ -23,6 +23,26 @@ using cata_default_random_engine = std::minstd_rand0;
 cata_default_random_engine &rng_get_engine();
 unsigned int rng_bits();
 
+/**
+ * While an instance exists, the PRNG functions called on the thread that created it draw
+ * from the instance's own engine instead of the global one. Instances can be nested, the
+ * innermost one is used.
+ * This gives code that must produce the same results no matter when (or on which thread)
+ * it runs its own random sequence.
+ */
+class scoped_rng_engine
+{
+    public:
+        explicit scoped_rng_engine( unsigned int seed );
+        ~scoped_rng_engine();
+        scoped_rng_engine( const scoped_rng_engine & ) = delete;
+        scoped_rng_engine &operator=( const scoped_rng_engine & ) = delete;
+
+    private:
+        cata_default_random_engine engine;
+        cata_default_random_engine *previous;
+};
+
 int rng( int lo, int hi );
 double rng_float( double val1, double val2 );
 bool one_in( int chance );
@@ -260,6 +260,7 @@ void scent_map::deserialize( const std::string &data )
             val = stmp;
         }
     }
+    recalculate_bounds( rectangle( point_zero, point( MAPSIZE_X, MAPSIZE_Y ) ) );
 }
 
 ///// weather
@@ -380,7 +381,7 @@ void overmap::convert_terrain( const std::unordered_map<tripoint, std::string> &
     for( const auto &convert : needs_conversion ) {
         const tripoint pos = convert.first;
         const std::string old = convert.second;
-        oter_id &new_id = ter( pos.x, pos.y, pos.z );
+        oter_id new_id = ter( pos.x, pos.y, pos.z );
 
         struct convert_nearby {
             int xoffset;
@@ -773,6 +774,7 @@ void overmap::convert_terrain( const std::unordered_map<tripoint, std::string> &
                 break;
             }
         }
+        ter_set( pos, new_id );
     }
 }
 
@@ -850,6 +852,7 @@ void overmap::unserialize( std::istream &fin )
                 jsin.end_array();
             }
             jsin.end_array();
+            build_ter_index();
             convert_terrain( needs_conversion );
         } else if( name == "region_id" ) {
             std::string new_region_id;
@@ -1017,7 +1020,7 @@ void overmap::unserialize( std::istream &fin )
                                             std::string name = jsin.get_member_name();
                                             if( name == "p" ) {
                                                 jsin.read( p );
-                                                overmap_special_placements[p] = s;
+                                                add_special_placement( p, s );
                                             }
                                         }
                                     }
@@ -1239,11 +1242,11 @@ void overmap::save_monster_groups( JsonOut &jout ) const
     // Bin groups by their fields, except positions and monsters
     std::unordered_map<mongroup, std::list<tripoint>, mongroup_hash, mongroup_bin_eq> binned_groups;
     binned_groups.reserve( zg.size() );
-    for( const auto &pos_group : zg ) {
+    for( const mongroup &group : zg ) {
         // Each group in bin adds only position
         // so that 100 identical groups are 1 group data and 100 tripoints
-        std::list<tripoint> &positions = binned_groups[pos_group.second];
-        positions.emplace_back( pos_group.first );
+        std::list<tripoint> &positions = binned_groups[group];
+        positions.emplace_back( group.pos );
     }
 
     for( auto &group_bin : binned_groups ) {
@@ -1604,8 +1607,7 @@ void faction_manager::deserialize( JsonIn &jsin )
 
 void Creature_tracker::deserialize( JsonIn &jsin )
 {
-    monsters_list.clear();
-    monsters_by_location.clear();
+    clear();
     jsin.start_array();
     while( !jsin.end_array() ) {
         monster montmp;
@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "calendar.h"
+#include "cata_utility.h"
 #include "color.h"
 #include "game.h"
 #include "map.h"
@@ -50,15 +51,33 @@ void scent_map::reset()
             val = 0;
         }
     }
+    bounds = rectangle();
 }
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
+    for( int x = bounds.p_min.x; x < bounds.p_max.x; ++x ) {
+        for( int y = bounds.p_min.y; y < bounds.p_max.y; ++y ) {
+            grscent[x][y] = std::max( 0, grscent[x][y] - 1 );
+        }
+    }
+}
+
+void scent_map::recalculate_bounds( const rectangle &area )
+{
+    point new_min( MAPSIZE_X, MAPSIZE_Y );
+    point new_max( 0, 0 );
+    for( int x = std::max( area.p_min.x, 0 ); x < std::min( area.p_max.x, MAPSIZE_X ); ++x ) {
+        for( int y = std::max( area.p_min.y, 0 ); y < std::min( area.p_max.y, MAPSIZE_Y ); ++y ) {
+            if( grscent[x][y] != 0 ) {
+                new_min.x = std::min( new_min.x, x );
+                new_min.y = std::min( new_min.y, y );
+                new_max.x = std::max( new_max.x, x + 1 );
+                new_max.y = std::max( new_max.y, y + 1 );
+            }
         }
     }
+    bounds = new_max.x > new_min.x ? rectangle( new_min, new_max ) : rectangle();
 }
 
 void scent_map::draw( const catacurses::window &win, const int div, const tripoint &center ) const
@@ -84,6 +103,11 @@ void scent_map::shift( const int sm_shift_x, const int sm_shift_y )
         }
     }
     grscent = new_scent;
+    const point shift( sm_shift_x, sm_shift_y );
+    const point new_min = bounds.p_min - shift;
+    const point new_max = bounds.p_max - shift;
+    bounds = rectangle( point( clamp( new_min.x, 0, MAPSIZE_X ), clamp( new_min.y, 0, MAPSIZE_Y ) ),
+                        point( clamp( new_max.x, 0, MAPSIZE_X ), clamp( new_max.y, 0, MAPSIZE_Y ) ) );
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -104,6 +128,16 @@ void scent_map::set( const tripoint &p, int value )
 void scent_map::set_unsafe( const tripoint &p, int value )
 {
     grscent[p.x][p.y] = value;
+    if( value != 0 ) {
+        if( bounds.p_min.x >= bounds.p_max.x ) {
+            bounds = rectangle( p.xy(), p.xy() + point( 1, 1 ) );
+        } else {
+            bounds.p_min.x = std::min( bounds.p_min.x, p.x );
+            bounds.p_min.y = std::min( bounds.p_min.y, p.y );
+            bounds.p_max.x = std::max( bounds.p_max.x, p.x + 1 );
+            bounds.p_max.y = std::max( bounds.p_max.y, p.y + 1 );
+        }
+    }
 }
 int scent_map::get_unsafe( const tripoint &p ) const
 {
@@ -142,91 +176,98 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
+    if( bounds.p_min.x >= bounds.p_max.x ) {
+        // No scent anywhere.
+        return;
+    }
+    // Only squares with scent or next to squares with scent can change.
+    const rectangle area(
+        point( std::max( center.x - SCENT_RADIUS, bounds.p_min.x - 1 ),
+               std::max( center.y - SCENT_RADIUS, bounds.p_min.y - 1 ) ),
+        point( std::min( center.x + SCENT_RADIUS, bounds.p_max.x ),
+               std::min( center.y + SCENT_RADIUS, bounds.p_max.y ) ) );
+    if( area.p_min.x > area.p_max.x || area.p_min.y > area.p_max.y ) {
+        return;
+    }
 
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only TFLAG_WALL blocks scent
     scent_array<bool> reduces_scent;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    // The new scent flag searching function. Should be wayyy faster than the old one.
+    m.scent_blockers( blocks_scent, reduces_scent, area.p_min.x - 1, area.p_min.y - 1,
+                      area.p_max.x + 1, area.p_max.y + 1 );
+    diffuse( grscent, blocks_scent, reduces_scent, area );
 
+    recalculate_bounds( rectangle( bounds.p_min - point( 1, 1 ), bounds.p_max + point( 1, 1 ) ) );
+}
+
+void scent_map::diffuse( scent_array<int> &scent, const scent_array<bool> &blocks_scent,
+                         const scent_array<bool> &reduces_scent, const rectangle &area )
+{
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
-    const int diffusivity = 100;
+    static constexpr int diffusivity = 100;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, scentmap_minx - 1, scentmap_miny - 1,
-                      scentmap_maxx + 1, scentmap_maxy + 1 );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // MAPSIZE_X, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+    // How much each square contributes when diffusing in: walls nothing, only 20% of scent
+    // can diffuse on REDUCE_SCENT squares (2 instead of 10).
+    scent_array<int> weight;
+    // The sums of the 3 neighbors in the y direction (and their weights), so each square gets
+    // read 3 times instead of 9 times.
+    scent_array<int> sum_3_scent_y;
+    scent_array<int> squares_used_y;
+
+    // All loops run over y, along the rows of the arrays, and the inner ones have no
+    // branches and only use int arithmetic (the flags are turned into weights first), so
+    // the compiler can vectorize them. The bounds are copied so the compiler knows they
+    // don't change when the arrays are written.
+    const int min_x = area.p_min.x;
+    const int max_x = area.p_max.x;
+    const int min_y = area.p_min.y;
+    const int max_y = area.p_max.y;
+    for( int x = min_x - 1; x <= max_x + 1; ++x ) {
+        int *const w = weight[x].data();
+        const int *const s = scent[x].data();
+        const bool *const blocks = blocks_scent[x].data();
+        const bool *const reduces = reduces_scent[x].data();
+        for( int y = min_y - 1; y <= max_y + 1; ++y ) {
+            const int blocked = blocks[y];
+            const int reduced = reduces[y];
+            w[y] = ( 1 - blocked ) * ( 10 - 8 * reduced );
+        }
+        int *const sum = sum_3_scent_y[x].data();
+        int *const used = squares_used_y[x].data();
+        for( int y = min_y; y <= max_y; ++y ) {
+            sum[y] = w[y - 1] * s[y - 1] + w[y] * s[y] + w[y + 1] * s[y + 1];
+            used[y] = w[y - 1] + w[y] + w[y + 1];
         }
     }
 
-    // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            auto &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring walls and reduce_scent squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent
-                scent_here = 0;
-            }
+    for( int x = min_x; x <= max_x; ++x ) {
+        int *const s = scent[x].data();
+        const int *const w = weight[x].data();
+        const int *const sum_l = sum_3_scent_y[x - 1].data();
+        const int *const sum_c = sum_3_scent_y[x].data();
+        const int *const sum_r = sum_3_scent_y[x + 1].data();
+        const int *const used_l = squares_used_y[x - 1].data();
+        const int *const used_c = squares_used_y[x].data();
+        const int *const used_r = squares_used_y[x + 1].data();
+        for( int y = min_y; y <= max_y; ++y ) {
+            const int scent_here = s[y];
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = used_l[y] + used_c[y] + used_r[y];
+            // less air movement for REDUCE_SCENT square (diffusivity / 5)
+            const int this_diffusivity = w[y] * ( diffusivity / 10 );
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring walls and reduce_scent squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // add what diffuses in from the neighbors
+            const int diffused = ( temp_scent + this_diffusivity * ( sum_l[y] + sum_c[y] + sum_r[y] ) ) /
+                                 ( 1000 * 10 );
+            // squares blocking scent don't keep any
+            s[y] = w[y] != 0 ? diffused : 0;
         }
     }
 }
@@ -23,11 +23,18 @@ class window;
 
 class scent_map
 {
-    protected:
+    public:
         template<typename T>
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
+    protected:
         scent_array<int> grscent;
+        /**
+         * Half-open rectangle containing all non-zero values of @ref grscent (it may be
+         * larger than needed). Squares outside of it and its neighbors don't need to be
+         * updated, their scent remains zero.
+         */
+        rectangle bounds = rectangle( point_zero, point( MAPSIZE_X, MAPSIZE_Y ) );
         cata::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
@@ -62,6 +69,18 @@ class scent_map
         bool inbounds( const point &p ) const {
             return inbounds( tripoint( p, 0 ) );
         }
+
+        /**
+         * One step of scent diffusion for the squares in area (inclusive). The squares
+         * next to it are read, but not changed. Walls (blocks_scent) don't take any scent,
+         * REDUCE_SCENT squares take less.
+         */
+        static void diffuse( scent_array<int> &scent, const scent_array<bool> &blocks_scent,
+                             const scent_array<bool> &reduces_scent, const rectangle &area );
+
+    private:
+        /** Shrinks @ref bounds to the non-zero values within the given half-open rectangle. */
+        void recalculate_bounds( const rectangle &area );
 };
 
 #endif
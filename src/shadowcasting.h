@@ -100,6 +100,11 @@ inline float accumulate_transparency( const float &cumulative_transparency,
     return ( ( distance - 1 ) * cumulative_transparency + current_transparency ) / distance;
 }
 
+// If true, castLightAll (and the light sources) use the row based shadowcasting
+// implementation instead of the recursive one. Both give the same result.
+// Cached from the ROW_SHADOWCASTING option.
+extern bool row_shadowcasting;
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
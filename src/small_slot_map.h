@@ -0,0 +1,296 @@
+#pragma once
+#ifndef CATA_SMALL_SLOT_MAP_H
+#define CATA_SMALL_SLOT_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cata
+{
+
+/**
+ * @brief An associative container for very few elements, most of them stored inline.
+ *
+ * The first N (at most 8) elements live in slots inside the container itself, further
+ * elements go into blocks of four slots allocated as needed (up to 255 of them). Lookup
+ * is a linear search, which beats any tree or hash for the handful of elements this is
+ * meant for.
+ *
+ * Elements are never moved: inserting or erasing an element does not invalidate
+ * references, pointers or iterators to any other element. This allows inserting
+ * and erasing while iterating over the container, same as with std::map (newly
+ * inserted elements may or may not be visited by an ongoing iteration).
+ *
+ * Unlike std::map, iteration happens in slot order, not in key order.
+ */
+template<typename Key, typename T, size_t N>
+class small_slot_map
+{
+        static_assert( N >= 1 && N <= 8, "the inline slots are tracked in an 8 bit mask" );
+
+    private:
+        using value_storage = std::pair<const Key, T>;
+        using storage = typename std::aligned_storage<sizeof( value_storage ), alignof( value_storage )>::type;
+
+        // Slots beyond the inline ones, in a chain of blocks so they never move when more
+        // are added.
+        static constexpr size_t block_size = 4;
+        struct overflow_block {
+            std::array<storage, block_size> slots;
+            uint8_t used = 0;
+            std::unique_ptr<overflow_block> next;
+        };
+
+        // A slot and the bit that marks it as used.
+        struct slot_ref {
+            storage *data;
+            uint8_t *used;
+            uint8_t bit;
+
+            bool is_used() const {
+                return ( *used & bit ) != 0;
+            }
+            value_storage &get() const {
+                return *reinterpret_cast<value_storage *>( data );
+            }
+        };
+
+        template<bool Const>
+        class iterator_base
+        {
+            public:
+                using container_type = typename std::conditional<Const, const small_slot_map, small_slot_map>::type;
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = value_storage;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename std::conditional<Const, const value_type *, value_type *>::type;
+                using reference = typename std::conditional<Const, const value_type &, value_type &>::type;
+
+                iterator_base() = default;
+                iterator_base( container_type *container, const size_t index ) :
+                    container( container ), index( index ) {
+                    skip_unused();
+                }
+                // Allows conversion from iterator to const_iterator.
+                template<bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+                iterator_base( const iterator_base<OtherConst> &other ) :
+                    container( other.container ), index( other.index ) {}
+
+                reference operator*() const {
+                    return container->slot_at( index ).get();
+                }
+                pointer operator->() const {
+                    return &**this;
+                }
+                iterator_base &operator++() {
+                    ++index;
+                    skip_unused();
+                    return *this;
+                }
+                iterator_base operator++( int ) {
+                    iterator_base result = *this;
+                    ++*this;
+                    return result;
+                }
+                bool operator==( const iterator_base &rhs ) const {
+                    return index == rhs.index;
+                }
+                bool operator!=( const iterator_base &rhs ) const {
+                    return index != rhs.index;
+                }
+
+            private:
+                friend class small_slot_map;
+                template<bool>
+                friend class iterator_base;
+
+                void skip_unused() {
+                    const size_t end = container->num_slots();
+                    while( index < end && !container->slot_at( index ).is_used() ) {
+                        ++index;
+                    }
+                }
+
+                container_type *container = nullptr;
+                size_t index = 0;
+        };
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = value_storage;
+        using size_type = size_t;
+        using iterator = iterator_base<false>;
+        using const_iterator = iterator_base<true>;
+
+        small_slot_map() = default;
+        small_slot_map( const small_slot_map &other ) {
+            for( const value_type &elem : other ) {
+                emplace( elem.first, elem.second );
+            }
+        }
+        small_slot_map( small_slot_map &&other ) {
+            for( value_type &elem : other ) {
+                emplace( elem.first, std::move( elem.second ) );
+            }
+            other.clear();
+        }
+        small_slot_map &operator=( const small_slot_map &other ) {
+            if( this != &other ) {
+                clear();
+                for( const value_type &elem : other ) {
+                    emplace( elem.first, elem.second );
+                }
+            }
+            return *this;
+        }
+        small_slot_map &operator=( small_slot_map &&other ) {
+            if( this != &other ) {
+                clear();
+                for( value_type &elem : other ) {
+                    emplace( elem.first, std::move( elem.second ) );
+                }
+                other.clear();
+            }
+            return *this;
+        }
+        ~small_slot_map() {
+            clear();
+        }
+
+        iterator begin() {
+            return iterator( this, 0 );
+        }
+        const_iterator begin() const {
+            return const_iterator( this, 0 );
+        }
+        iterator end() {
+            return iterator( this, num_slots() );
+        }
+        const_iterator end() const {
+            return const_iterator( this, num_slots() );
+        }
+
+        size_type size() const {
+            return count;
+        }
+        bool empty() const {
+            return count == 0;
+        }
+
+        iterator find( const Key &key ) {
+            return iterator( this, find_index( key ) );
+        }
+        const_iterator find( const Key &key ) const {
+            return const_iterator( this, find_index( key ) );
+        }
+
+        /**
+         * Inserts a new element if there is none with that key yet.
+         * @return Iterator to the element with that key and whether it has been inserted.
+         */
+        template<typename... Args>
+        std::pair<iterator, bool> emplace( const Key &key, Args &&... args ) {
+            const size_t found = find_index( key );
+            if( found != num_slots() ) {
+                return { iterator( this, found ), false };
+            }
+            size_t index = 0;
+            while( index < num_slots() && slot_at( index ).is_used() ) {
+                ++index;
+            }
+            if( index == num_slots() ) {
+                std::unique_ptr<overflow_block> *last = &overflow;
+                while( *last ) {
+                    last = &( *last )->next;
+                }
+                last->reset( new overflow_block() );
+                ++num_blocks;
+            }
+            const slot_ref s = slot_at( index );
+            ::new( s.data ) value_type( std::piecewise_construct, std::forward_as_tuple( key ),
+                                        std::forward_as_tuple( std::forward<Args>( args )... ) );
+            *s.used |= s.bit;
+            ++count;
+            return { iterator( this, index ), true };
+        }
+
+        /** Erases the element, returns an iterator to the next element. */
+        iterator erase( const_iterator it ) {
+            const slot_ref s = slot_at( it.index );
+            s.get().~value_type();
+            *s.used &= ~s.bit;
+            --count;
+            return iterator( this, it.index + 1 );
+        }
+        /** @return The number of erased elements (0 or 1). */
+        size_type erase( const Key &key ) {
+            const size_t index = find_index( key );
+            if( index == num_slots() ) {
+                return 0;
+            }
+            erase( const_iterator( this, index ) );
+            return 1;
+        }
+
+        void clear() {
+            for( size_t i = 0; i < num_slots(); ++i ) {
+                const slot_ref s = slot_at( i );
+                if( s.is_used() ) {
+                    s.get().~value_type();
+                }
+            }
+            inline_used = 0;
+            overflow.reset();
+            num_blocks = 0;
+            count = 0;
+        }
+
+    private:
+        size_t num_slots() const {
+            return N + num_blocks * block_size;
+        }
+        // The iterators decide about constness of the element.
+        slot_ref slot_at( const size_t index ) const {
+            small_slot_map &self = const_cast<small_slot_map &>( *this );
+            if( index < N ) {
+                return { &self.inline_slots[index], &self.inline_used,
+                         static_cast<uint8_t>( 1 << index ) };
+            }
+            size_t i = index - N;
+            overflow_block *block = self.overflow.get();
+            for( ; i >= block_size; i -= block_size ) {
+                block = block->next.get();
+            }
+            return { &block->slots[i], &block->used, static_cast<uint8_t>( 1 << i ) };
+        }
+        size_t find_index( const Key &key ) const {
+            const size_t end = num_slots();
+            for( size_t i = 0; i < end; ++i ) {
+                const slot_ref s = slot_at( i );
+                if( s.is_used() && s.get().first == key ) {
+                    return i;
+                }
+            }
+            return end;
+        }
+
+        // Kept small: containers of this are often stored for every tile of the map, most
+        // of them empty.
+        std::array<storage, N> inline_slots;
+        uint8_t inline_used = 0;
+        uint8_t num_blocks = 0;
+        uint16_t count = 0;
+        std::unique_ptr<overflow_block> overflow;
+};
+
+} // namespace cata
+
+#endif // CATA_SMALL_SLOT_MAP_H
@@ -158,6 +158,65 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+static_assert( SEEX * SEEY <= 256, "submap::field_tile::index must hold all tile indices" );
+
+void submap::field_added( const point &p )
+{
+    const int index = field_tile_index( p );
+    const auto iter = std::lower_bound( field_tiles.begin(), field_tiles.end(), index,
+    []( const field_tile & tile, const int i ) {
+        return tile.index < i;
+    } );
+    if( iter != field_tiles.end() && iter->index == index ) {
+        return;
+    }
+    // The tile had no fields before, those are fully translucent.
+    field_tiles.insert( iter, field_tile{ static_cast<uint8_t>( index ), 1.0f } );
+}
+
+void submap::field_removed( const point &p )
+{
+    if( fld[p.x][p.y].field_count() > 0 ) {
+        return;
+    }
+    const int index = field_tile_index( p );
+    const auto iter = std::lower_bound( field_tiles.begin(), field_tiles.end(), index,
+    []( const field_tile & tile, const int i ) {
+        return tile.index < i;
+    } );
+    if( iter == field_tiles.end() || iter->index != index ) {
+        return;
+    }
+    if( iter->translucency != 1.0f ) {
+        field_translucency_changed = true;
+    }
+    field_tiles.erase( iter );
+}
+
+int submap::next_field_tile( const int index ) const
+{
+    const auto iter = std::upper_bound( field_tiles.begin(), field_tiles.end(), index,
+    []( const int i, const field_tile & tile ) {
+        return i < tile.index;
+    } );
+    return iter != field_tiles.end() ? iter->index : -1;
+}
+
+bool submap::update_field_translucency()
+{
+    bool changed = field_translucency_changed;
+    field_translucency_changed = false;
+    for( field_tile &tile : field_tiles ) {
+        const point p = field_tile_point( tile.index );
+        const float translucency = fld[p.x][p.y].translucency();
+        if( translucency != tile.translucency ) {
+            tile.translucency = translucency;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 void submap::rotate( int turns )
 {
     turns = turns % 4;
@@ -223,4 +282,11 @@ void submap::rotate( int turns )
         elem->face = elem->turn_dir;
         elem->precalc_mounts( 0, elem->turn_dir, elem->pivot_anchor[0] );
     }
+    for( field_tile &tile : field_tiles ) {
+        tile.index = field_tile_index( rotate_point( field_tile_point( tile.index ) ) );
+    }
+    std::sort( field_tiles.begin(), field_tiles.end(),
+    []( const field_tile & lhs, const field_tile & rhs ) {
+        return lhs.index < rhs.index;
+    } );
 }
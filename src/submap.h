@@ -175,6 +175,11 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
         void rotate( int turns );
 
         void store( JsonOut &jsout ) const;
+        /**
+         * Stores the members of @ref store that are not per tile layers (everything but the
+         * last touched turn, temperature, terrain, radiation, furniture and traps).
+         */
+        void store_objects( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, bool rubpow_update );
 
         // If is_uniform is true, this submap is a solid block of terrain
@@ -185,6 +190,28 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         active_item_cache active_items;
 
+        /** Index of the tile in @ref field_tiles, in the order the tiles are processed. */
+        static int field_tile_index( const point &p ) {
+            return p.x * SEEY + p.y;
+        }
+        static point field_tile_point( const int index ) {
+            return point( index / SEEY, index % SEEY );
+        }
+        /** Adds the tile to @ref field_tiles, call it whenever a field is added to it. */
+        void field_added( const point &p );
+        /** Drops the tile from @ref field_tiles, call it whenever a field is removed from it. */
+        void field_removed( const point &p );
+        /**
+         * Index of the first tile in @ref field_tiles after the given index, or -1 if there
+         * is none. Tiles that get fields while iterating this way are still visited.
+         */
+        int next_field_tile( int index ) const;
+        /**
+         * @return Whether the translucency of the fields on any tile changed since the
+         * last call (or since the tile got its first field).
+         */
+        bool update_field_translucency();
+
         int field_count = 0;
         time_point last_touched = calendar::time_of_cataclysm;
         std::vector<spawn_point> spawns;
@@ -200,6 +227,16 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
     private:
         int temperature = 0;
+        struct field_tile {
+            uint8_t index;
+            // Translucency of the fields on the tile when last checked
+            float translucency;
+        };
+        // Tiles that have fields, sorted by index, so field processing doesn't have to look at
+        // all tiles.
+        std::vector<field_tile> field_tiles;
+        // Set when the last field of a tile that wasn't fully translucent got removed.
+        bool field_translucency_changed = false;
 };
 
 /**
@@ -259,6 +296,7 @@ struct maptile {
             const bool ret = sm->fld[x][y].add_field( field_to_add, new_intensity, new_age );
             if( ret ) {
                 sm->field_count++;
+                sm->field_added( pos() );
             }
 
             return ret;
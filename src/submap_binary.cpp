@@ -0,0 +1,311 @@
+#include "submap_binary.h"
+
+#include <cstdint>
+#include <iterator>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "game.h"
+#include "json.h"
+#include "mapdata.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace submap_binary
+{
+
+static const std::string magic = "CDMB";
+// Increase this whenever the layout changes, older versions must still be readable.
+static constexpr uint64_t format_version = 1;
+
+// Tiles of a submap, in the order they are stored (same as in the JSON format).
+static constexpr int num_tiles = SEEX * SEEY;
+
+static point tile_at( const int n )
+{
+    return point( n % SEEX, n / SEEX );
+}
+
+class binary_writer
+{
+    public:
+        void put_varint( uint64_t v ) {
+            while( v >= 0x80 ) {
+                data.push_back( static_cast<char>( ( v & 0x7F ) | 0x80 ) );
+                v >>= 7;
+            }
+            data.push_back( static_cast<char>( v ) );
+        }
+        void put_int( const int64_t v ) {
+            put_varint( ( static_cast<uint64_t>( v ) << 1 ) ^ static_cast<uint64_t>( v >> 63 ) );
+        }
+        void put_string( const std::string &s ) {
+            put_varint( s.size() );
+            data += s;
+        }
+        /** Run length encodes value_at( tile ) for all tiles of a submap. */
+        template<typename F>
+        void put_runs( F value_at ) {
+            int run_start = 0;
+            for( int n = 1; n <= num_tiles; n++ ) {
+                if( n == num_tiles || value_at( tile_at( n ) ) != value_at( tile_at( run_start ) ) ) {
+                    put_int( value_at( tile_at( run_start ) ) );
+                    put_varint( n - run_start );
+                    run_start = n;
+                }
+            }
+        }
+
+        std::string data;
+};
+
+class binary_reader
+{
+    public:
+        explicit binary_reader( std::string data ) : data( std::move( data ) ) {}
+
+        uint64_t get_varint() {
+            uint64_t result = 0;
+            for( int shift = 0; shift < 64; shift += 7 ) {
+                if( pos >= data.size() ) {
+                    throw std::runtime_error( "unexpected end of binary map data" );
+                }
+                const uint8_t byte = static_cast<uint8_t>( data[pos++] );
+                result |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+                if( ( byte & 0x80 ) == 0 ) {
+                    return result;
+                }
+            }
+            throw std::runtime_error( "corrupt varint in binary map data" );
+        }
+        int64_t get_int() {
+            const uint64_t v = get_varint();
+            return static_cast<int64_t>( v >> 1 ) ^ -static_cast<int64_t>( v & 1 );
+        }
+        std::string get_string() {
+            return get_raw( get_varint() );
+        }
+        /** Reads runs written by @ref binary_writer::put_runs and calls set( tile, value ) for each tile. */
+        template<typename F>
+        void get_runs( F set ) {
+            int n = 0;
+            while( n < num_tiles ) {
+                const int64_t value = get_int();
+                const uint64_t length = get_varint();
+                if( length == 0 || length > static_cast<uint64_t>( num_tiles - n ) ) {
+                    throw std::runtime_error( "corrupt tile run in binary map data" );
+                }
+                for( const int end = n + static_cast<int>( length ); n < end; n++ ) {
+                    set( tile_at( n ), value );
+                }
+            }
+        }
+        std::string get_raw( const size_t size ) {
+            if( size > data.size() - pos ) {
+                throw std::runtime_error( "unexpected end of binary map data" );
+            }
+            std::string result = data.substr( pos, size );
+            pos += size;
+            return result;
+        }
+        bool at_end() const {
+            return pos == data.size();
+        }
+
+    private:
+        std::string data;
+        size_t pos = 0;
+};
+
+/** Maps the ids used in a file to indices into its string table. */
+class id_table
+{
+    public:
+        int index_of( const ter_id &id ) {
+            int &index = slot( ter_indices, id.to_i() );
+            if( index < 0 ) {
+                index = add( id.obj().id.str() );
+            }
+            return index;
+        }
+        int index_of( const furn_id &id ) {
+            int &index = slot( furn_indices, id.to_i() );
+            if( index < 0 ) {
+                index = add( id.obj().id.str() );
+            }
+            return index;
+        }
+        int index_of( const trap_id &id ) {
+            int &index = slot( trap_indices, id.to_i() );
+            if( index < 0 ) {
+                index = add( id.id().str() );
+            }
+            return index;
+        }
+
+        std::vector<std::string> strings;
+
+    private:
+        static int &slot( std::vector<int> &indices, const int i ) {
+            if( static_cast<size_t>( i ) >= indices.size() ) {
+                indices.resize( i + 1, -1 );
+            }
+            return indices[i];
+        }
+        int add( const std::string &str ) {
+            strings.push_back( str );
+            return static_cast<int>( strings.size() ) - 1;
+        }
+
+        // Indexed by int_id, -1 if the id is not in the table yet.
+        std::vector<int> ter_indices;
+        std::vector<int> furn_indices;
+        std::vector<int> trap_indices;
+};
+
+/** The ids of one type for the string table of a file, resolved when first used. */
+template<typename T>
+class id_lookup
+{
+    public:
+        explicit id_lookup( const std::vector<std::string> &strings ) : strings( strings ),
+            ids( strings.size() ), resolved( strings.size(), false ) {}
+
+        int_id<T> operator()( const int64_t index ) {
+            if( index < 0 || static_cast<size_t>( index ) >= strings.size() ) {
+                throw std::runtime_error( "invalid id index in binary map data" );
+            }
+            if( !resolved[index] ) {
+                ids[index] = string_id<T>( strings[index] ).id();
+                resolved[index] = true;
+            }
+            return ids[index];
+        }
+
+    private:
+        const std::vector<std::string> &strings;
+        std::vector<int_id<T>> ids;
+        std::vector<bool> resolved;
+};
+
+bool is_binary( std::istream &fin )
+{
+    char header[4] = {};
+    const std::streampos start = fin.tellg();
+    fin.read( header, sizeof( header ) );
+    const bool result = fin.gcount() == static_cast<std::streamsize>( sizeof( header ) ) &&
+                        std::string( header, sizeof( header ) ) == magic;
+    fin.clear();
+    fin.seekg( start );
+    return result;
+}
+
+void write( std::ostream &fout, const std::vector<std::pair<tripoint, const submap *>> &submaps )
+{
+    id_table table;
+    binary_writer body;
+    body.put_varint( submaps.size() );
+    for( const auto &elem : submaps ) {
+        const tripoint &p = elem.first;
+        const submap &sm = *elem.second;
+        body.put_int( p.x );
+        body.put_int( p.y );
+        body.put_int( p.z );
+        body.put_int( to_turn<int>( sm.last_touched ) );
+        body.put_int( sm.get_temperature() );
+        body.put_runs( [&]( const point & t ) {
+            return table.index_of( sm.get_ter( t ) );
+        } );
+        body.put_runs( [&]( const point & t ) {
+            return table.index_of( sm.get_furn( t ) );
+        } );
+        body.put_runs( [&]( const point & t ) {
+            return table.index_of( sm.get_trap( t ) );
+        } );
+        body.put_runs( [&]( const point & t ) {
+            return sm.get_radiation( t );
+        } );
+
+        std::ostringstream objects;
+        JsonOut jsout( objects );
+        jsout.start_object();
+        sm.store_objects( jsout );
+        jsout.end_object();
+        body.put_string( objects.str() );
+    }
+
+    binary_writer header;
+    header.data = magic;
+    header.put_varint( format_version );
+    header.put_varint( savegame_version );
+    header.put_varint( table.strings.size() );
+    for( const std::string &s : table.strings ) {
+        header.put_string( s );
+    }
+    fout << header.data << body.data;
+}
+
+void read( std::istream &fin, const add_submap_callback &add )
+{
+    std::string data{ std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() };
+    binary_reader in( std::move( data ) );
+    if( in.get_raw( magic.size() ) != magic ) {
+        throw std::runtime_error( "not a binary map file" );
+    }
+    const uint64_t version = in.get_varint();
+    if( version > format_version ) {
+        throw std::runtime_error( "binary map file version " + std::to_string( version ) +
+                                  " is newer than this game supports" );
+    }
+    const bool rubpow_update = in.get_varint() < 22;
+
+    std::vector<std::string> strings( in.get_varint() );
+    for( std::string &s : strings ) {
+        s = in.get_string();
+    }
+    id_lookup<ter_t> ter_ids( strings );
+    id_lookup<furn_t> furn_ids( strings );
+    id_lookup<trap> trap_ids( strings );
+
+    for( uint64_t count = in.get_varint(); count > 0; count-- ) {
+        tripoint p;
+        p.x = in.get_int();
+        p.y = in.get_int();
+        p.z = in.get_int();
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->last_touched = time_point::from_turn( in.get_int() );
+        sm->set_temperature( in.get_int() );
+        in.get_runs( [&]( const point & t, const int64_t index ) {
+            sm->ter[t.x][t.y] = ter_ids( index );
+        } );
+        in.get_runs( [&]( const point & t, const int64_t index ) {
+            sm->frn[t.x][t.y] = furn_ids( index );
+        } );
+        in.get_runs( [&]( const point & t, const int64_t index ) {
+            sm->trp[t.x][t.y] = trap_ids( index );
+        } );
+        in.get_runs( [&]( const point & t, const int64_t radiation ) {
+            sm->rad[t.x][t.y] = static_cast<int>( radiation );
+        } );
+
+        std::istringstream objects( in.get_string() );
+        JsonIn jsin( objects );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string member_name = jsin.get_member_name();
+            sm->load( jsin, member_name, rubpow_update );
+        }
+        add( p, sm );
+    }
+    if( !in.at_end() ) {
+        throw std::runtime_error( "trailing data in binary map file" );
+    }
+}
+
+} // namespace submap_binary
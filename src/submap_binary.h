@@ -0,0 +1,45 @@
+#pragma once
+#ifndef SUBMAP_BINARY_H
+#define SUBMAP_BINARY_H
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Compact binary format of the map files (quads of submaps), used instead of JSON
+ * if the BINARY_MAP_SAVES world option is enabled.
+ *
+ * A file starts with a magic number, the format version and the savegame version,
+ * followed by a table of all terrain, furniture and trap ids used in the file. The
+ * per tile layers (terrain, furniture, traps, radiation) are run length encoded
+ * indices into that table, so loading a submap does one id lookup per distinct id
+ * instead of one per tile. Everything else (items, fields, vehicles, ...) is stored
+ * as the same JSON that @ref submap::store_objects writes.
+ *
+ * Integers are stored as little endian base 128 varints, signed ones zigzag encoded.
+ */
+namespace submap_binary
+{
+
+using add_submap_callback = std::function<void( const tripoint &, std::unique_ptr<submap> & )>;
+
+/** Whether the stream contains a binary map file. Does not consume any input. */
+bool is_binary( std::istream &fin );
+/** Writes the given submaps (with their absolute submap coordinates) as one file. */
+void write( std::ostream &fout, const std::vector<std::pair<tripoint, const submap *>> &submaps );
+/**
+ * Reads a file written by @ref write and calls add for each submap in it.
+ * Throws std::runtime_error on corrupt data.
+ */
+void read( std::istream &fin, const add_submap_callback &add );
+
+} // namespace submap_binary
+
+#endif
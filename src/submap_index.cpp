@@ -0,0 +1,111 @@
+#include "submap_index.h"
+
+#include <algorithm>
+
+size_t submap_index::slot_of( const tripoint &p ) const
+{
+    // Submap coordinates fit comfortably into 28 bits for x and y and 8 bits for z.
+    uint64_t key = ( static_cast<uint64_t>( static_cast<uint32_t>( p.x ) ) & 0xFFFFFFF ) << 36 |
+                   ( static_cast<uint64_t>( static_cast<uint32_t>( p.y ) ) & 0xFFFFFFF ) << 8 |
+                   ( static_cast<uint64_t>( static_cast<uint32_t>( p.z ) ) & 0xFF );
+    // Fibonacci hashing, the high bits are the well mixed ones.
+    key *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>( key ^ ( key >> 32 ) ) & mask;
+}
+
+submap *submap_index::find( const tripoint &p ) const
+{
+    if( count == 0 ) {
+        return nullptr;
+    }
+    for( size_t i = slot_of( p ); slots[i].second != nullptr; i = ( i + 1 ) & mask ) {
+        if( slots[i].first == p ) {
+            return slots[i].second;
+        }
+    }
+    return nullptr;
+}
+
+bool submap_index::insert( const tripoint &p, submap *sm )
+{
+    if( sm == nullptr ) {
+        return false;
+    }
+    // Keep the load factor below 3/4, probe sequences get long beyond that.
+    if( ( count + 1 ) * 4 > slots.size() * 3 ) {
+        grow();
+    }
+    size_t i = slot_of( p );
+    for( ; slots[i].second != nullptr; i = ( i + 1 ) & mask ) {
+        if( slots[i].first == p ) {
+            return false;
+        }
+    }
+    slots[i] = value_type( p, sm );
+    count++;
+    return true;
+}
+
+submap *submap_index::erase( const tripoint &p )
+{
+    if( count == 0 ) {
+        return nullptr;
+    }
+    size_t hole = slot_of( p );
+    for( ; slots[hole].first != p; hole = ( hole + 1 ) & mask ) {
+        if( slots[hole].second == nullptr ) {
+            return nullptr;
+        }
+    }
+    if( slots[hole].second == nullptr ) {
+        return nullptr;
+    }
+    submap *const result = slots[hole].second;
+
+    // Backward shift deletion: move later entries of the probe sequence into the hole
+    // so no tombstones are needed and lookups can stop at the first empty slot.
+    for( size_t next = ( hole + 1 ) & mask; slots[next].second != nullptr; next = ( next + 1 ) & mask ) {
+        const size_t home = slot_of( slots[next].first );
+        // Distance from the entry's home slot to the hole / to its current slot.
+        const size_t to_hole = ( hole - home ) & mask;
+        const size_t to_next = ( next - home ) & mask;
+        if( to_hole < to_next ) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = value_type( tripoint_zero, nullptr );
+    count--;
+    return result;
+}
+
+void submap_index::clear()
+{
+    std::fill( slots.begin(), slots.end(), value_type( tripoint_zero, nullptr ) );
+    count = 0;
+}
+
+std::vector<tripoint> submap_index::sorted_keys() const
+{
+    std::vector<tripoint> result;
+    result.reserve( count );
+    for( const value_type &elem : *this ) {
+        result.push_back( elem.first );
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+void submap_index::grow()
+{
+    std::vector<value_type> old_slots( std::max<size_t>( 64, slots.size() * 2 ),
+                                       value_type( tripoint_zero, nullptr ) );
+    old_slots.swap( slots );
+    mask = slots.size() - 1;
+    count = 0;
+    for( const value_type &elem : old_slots ) {
+        if( elem.second != nullptr ) {
+            insert( elem.first, elem.second );
+        }
+    }
+}
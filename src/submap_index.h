@@ -0,0 +1,96 @@
+#pragma once
+#ifndef SUBMAP_INDEX_H
+#define SUBMAP_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Open addressing hash table from absolute submap coordinates to submaps, used by
+ * @ref mapbuffer. Lookups are a multiply and usually a single probe into a flat array,
+ * which matters because every submap of the reality bubble is looked up on each shift.
+ *
+ * Iteration order is unspecified, use @ref sorted_keys when the order matters.
+ * Null submaps can not be stored, a null value marks an empty slot.
+ */
+class submap_index
+{
+    public:
+        using value_type = std::pair<tripoint, submap *>;
+
+        class const_iterator
+        {
+            public:
+                const value_type &operator*() const {
+                    return *cur;
+                }
+                const value_type *operator->() const {
+                    return cur;
+                }
+                const_iterator &operator++() {
+                    ++cur;
+                    skip_empty();
+                    return *this;
+                }
+                bool operator==( const const_iterator &rhs ) const {
+                    return cur == rhs.cur;
+                }
+                bool operator!=( const const_iterator &rhs ) const {
+                    return cur != rhs.cur;
+                }
+            private:
+                friend class submap_index;
+                const_iterator( const value_type *cur, const value_type *last ) : cur( cur ), last( last ) {
+                    skip_empty();
+                }
+                void skip_empty() {
+                    while( cur != last && cur->second == nullptr ) {
+                        ++cur;
+                    }
+                }
+                const value_type *cur;
+                const value_type *last;
+        };
+
+        const_iterator begin() const {
+            return const_iterator( slots.data(), slots.data() + slots.size() );
+        }
+        const_iterator end() const {
+            return const_iterator( slots.data() + slots.size(), slots.data() + slots.size() );
+        }
+
+        size_t size() const {
+            return count;
+        }
+        bool empty() const {
+            return count == 0;
+        }
+
+        /** The submap at p, or nullptr if there is none. */
+        submap *find( const tripoint &p ) const;
+        /** Stores sm at p. Returns false (and stores nothing) if p is already taken. */
+        bool insert( const tripoint &p, submap *sm );
+        /** Removes the entry at p and returns its submap (nullptr if there was none). */
+        submap *erase( const tripoint &p );
+        /** Removes all entries, the submaps themselves are not deleted. */
+        void clear();
+        /** All stored coordinates in ascending order. */
+        std::vector<tripoint> sorted_keys() const;
+
+    private:
+        size_t slot_of( const tripoint &p ) const;
+        void grow();
+
+        std::vector<value_type> slots;
+        size_t count = 0;
+        // slots.size() - 1, the size is always a power of two.
+        size_t mask = 0;
+};
+
+#endif
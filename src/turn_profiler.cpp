@@ -0,0 +1,177 @@
+#include "turn_profiler.h"
+
+#if defined(TURN_PROFILER)
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+
+#include "filesystem.h"
+#include "options.h"
+#include "path_info.h"
+
+namespace turn_profiler
+{
+
+// Time spent in each stage during the turn that is currently being timed.
+static std::array<std::chrono::steady_clock::duration, num_stages> current_times;
+static std::array<long long, num_counters> current_counts;
+static std::chrono::steady_clock::time_point turn_start = std::chrono::steady_clock::now();
+
+static std::array<turn_record, history_size> records;
+// Index of the next record to write, and number of valid records.
+static int next_record = 0;
+static int num_records = 0;
+
+// Open while the TURN_PROFILE_CSV option is enabled.
+static std::unique_ptr<std::ofstream> csv_log;
+
+static clock_function test_clock = nullptr;
+
+static std::chrono::steady_clock::time_point now()
+{
+    return test_clock != nullptr ? test_clock() : std::chrono::steady_clock::now();
+}
+
+// The innermost running timer. Only the main thread runs do_turn, so this needs no locking.
+static scoped_timer *active_timer = nullptr;
+
+std::string stage_name( const stage s )
+{
+    switch( s ) {
+        case stage::weather:
+            return "weather";
+        case stage::scent:
+            return "scent";
+        case stage::vehicles:
+            return "vehicles";
+        case stage::fields:
+            return "fields";
+        case stage::active_items:
+            return "active_items";
+        case stage::sounds:
+            return "sounds";
+        case stage::map_cache:
+            return "map_cache";
+        case stage::monmove:
+            return "monmove";
+        case stage::npc_planning:
+            return "npc_planning";
+        case stage::num_stages:
+            break;
+    }
+    return "unknown";
+}
+
+std::string counter_name( const counter c )
+{
+    switch( c ) {
+        case counter::los_cache_hit:
+            return "los_cache_hit";
+        case counter::los_cache_miss:
+            return "los_cache_miss";
+        case counter::num_counters:
+            break;
+    }
+    return "unknown";
+}
+
+void add_time( const stage s, const std::chrono::steady_clock::duration elapsed )
+{
+    current_times[static_cast<int>( s )] += elapsed;
+}
+
+void count( const counter c )
+{
+    current_counts[static_cast<int>( c )]++;
+}
+
+scoped_timer::scoped_timer( const stage s ) : s( s ), start( now() ),
+    nested_time( 0 ), parent( active_timer )
+{
+    active_timer = this;
+}
+
+scoped_timer::~scoped_timer()
+{
+    const std::chrono::steady_clock::duration elapsed = now() - start;
+    add_time( s, elapsed - nested_time );
+    if( parent != nullptr ) {
+        parent->nested_time += elapsed;
+    }
+    active_timer = parent;
+}
+
+static void write_csv( const turn_record &rec )
+{
+    // Checked every turn, so changing the option takes effect right away.
+    if( !get_option<bool>( "TURN_PROFILE_CSV" ) ) {
+        csv_log.reset();
+        return;
+    }
+    if( !csv_log ) {
+        const std::string path = FILENAMES["config_dir"] + "turn_profile.csv";
+        const bool is_new = !file_exist( path );
+        csv_log.reset( new std::ofstream( path, std::ios::app ) );
+        if( is_new ) {
+            *csv_log << "turn";
+            for( int i = 0; i < num_stages; ++i ) {
+                *csv_log << "," << stage_name( static_cast<stage>( i ) );
+            }
+            *csv_log << ",total";
+            for( int i = 0; i < num_counters; ++i ) {
+                *csv_log << "," << counter_name( static_cast<counter>( i ) );
+            }
+            *csv_log << std::endl;
+        }
+    }
+    *csv_log << rec.turn;
+    for( const long long us : rec.stage_us ) {
+        *csv_log << "," << us;
+    }
+    *csv_log << "," << rec.total_us;
+    for( const long long n : rec.counts ) {
+        *csv_log << "," << n;
+    }
+    *csv_log << "\n";
+}
+
+void end_turn( const int turn )
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    const auto end = now();
+    turn_record &rec = records[next_record];
+    rec.turn = turn;
+    for( int i = 0; i < num_stages; ++i ) {
+        rec.stage_us[i] = duration_cast<microseconds>( current_times[i] ).count();
+    }
+    rec.total_us = duration_cast<microseconds>( end - turn_start ).count();
+    rec.counts = current_counts;
+    next_record = ( next_record + 1 ) % history_size;
+    num_records = std::min( num_records + 1, history_size );
+    write_csv( rec );
+
+    current_times.fill( std::chrono::steady_clock::duration::zero() );
+    current_counts.fill( 0 );
+    turn_start = end;
+}
+
+std::vector<turn_record> history()
+{
+    std::vector<turn_record> result;
+    result.reserve( num_records );
+    for( int i = num_records; i > 0; --i ) {
+        result.push_back( records[( next_record - i + history_size ) % history_size] );
+    }
+    return result;
+}
+
+void set_clock( const clock_function f )
+{
+    test_clock = f;
+}
+
+} // namespace turn_profiler
+
+#endif // TURN_PROFILER
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef TURN_PROFILER_H
+#define TURN_PROFILER_H
+
+/**
+ * Lightweight timing of the stages of @ref game::do_turn.
+ *
+ * Each stage is wrapped in a CATA_PROFILE_STAGE scope, CATA_PROFILE_END_TURN stores the
+ * timings of the finished turn in a ring buffer (shown in the debug menu) and, if the
+ * TURN_PROFILE_CSV option is enabled, appends them to turn_profile.csv in the config
+ * directory.
+ *
+ * CATA_PROFILE_COUNT counts events (e.g. cache hits) per turn, which are recorded and
+ * shown along with the timings.
+ *
+ * Everything here is only compiled in if TURN_PROFILER is defined, otherwise the macros
+ * expand to nothing.
+ */
+
+#if defined(TURN_PROFILER)
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace turn_profiler
+{
+
+enum class stage : int {
+    weather,
+    scent,
+    vehicles,
+    fields,
+    active_items,
+    sounds,
+    map_cache,
+    monmove,
+    npc_planning,
+    num_stages
+};
+
+constexpr int num_stages = static_cast<int>( stage::num_stages );
+
+enum class counter : int {
+    los_cache_hit,
+    los_cache_miss,
+    num_counters
+};
+
+constexpr int num_counters = static_cast<int>( counter::num_counters );
+
+std::string stage_name( stage s );
+std::string counter_name( counter c );
+
+struct turn_record {
+    int turn = 0;
+    /** Time spent in each stage, in microseconds. */
+    std::array<long long, num_stages> stage_us = {{}};
+    /** How often each counted event happened during the turn. */
+    std::array<long long, num_counters> counts = {{}};
+    /** Time of the whole turn (including the player's input), in microseconds. */
+    long long total_us = 0;
+};
+
+/** Number of turns kept in the ring buffer. */
+constexpr int history_size = 100;
+
+/** Adds time to a stage of the current turn. */
+void add_time( stage s, std::chrono::steady_clock::duration elapsed );
+/** Counts an event for the current turn. */
+void count( counter c );
+/** Finishes the current turn: stores it in the history and the CSV log. */
+void end_turn( int turn );
+/** The recorded turns, oldest first. */
+std::vector<turn_record> history();
+
+using clock_function = std::chrono::steady_clock::time_point( * )();
+/** Takes all timings from @p f instead of the steady clock, nullptr restores it. For tests. */
+void set_clock( clock_function f );
+
+/**
+ * Times the enclosing scope. Timers may nest (e.g. NPC planning inside monmove), the time
+ * of the inner timer is then not counted for the outer one.
+ */
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( stage s );
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+        ~scoped_timer();
+    private:
+        stage s;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration nested_time;
+        scoped_timer *parent;
+};
+
+} // namespace turn_profiler
+
+#define CATA_PROFILE_STAGE( s ) \
+    turn_profiler::scoped_timer turn_profiler_scope_timer( turn_profiler::stage::s )
+#define CATA_PROFILE_COUNT( c ) turn_profiler::count( turn_profiler::counter::c )
+#define CATA_PROFILE_END_TURN( turn ) turn_profiler::end_turn( turn )
+
+#else
+
+#define CATA_PROFILE_STAGE( s )
+#define CATA_PROFILE_COUNT( c )
+#define CATA_PROFILE_END_TURN( turn )
+
+#endif // TURN_PROFILER
+
+#endif
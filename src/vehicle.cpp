@@ -8,7 +8,6 @@
 #include <complex>
 #include <cmath>
 #include <cstdlib>
-#include <numeric>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -2938,14 +2937,17 @@ point vehicle::pivot_displacement() const
 
 int vehicle::fuel_left( const itype_id &ftype, bool recurse ) const
 {
-    int fl = std::accumulate( parts.begin(), parts.end(), 0, [&ftype]( const int &lhs,
-    const vehicle_part & rhs ) {
+    int fl = 0;
+    for( const int p : fuel_containers ) {
+        const vehicle_part &pt = parts[p];
         // don't count frozen liquid
-        if( rhs.is_tank() && rhs.base.contents_made_of( SOLID ) ) {
-            return lhs;
+        if( pt.is_tank() && pt.base.contents_made_of( SOLID ) ) {
+            continue;
         }
-        return lhs + ( rhs.ammo_current() == ftype ? rhs.ammo_remaining() : 0 );
-    } );
+        if( pt.ammo_current() == ftype ) {
+            fl += pt.ammo_remaining();
+        }
+    }
 
     if( recurse && ftype == fuel_type_battery ) {
         auto fuel_counting_visitor = [&]( vehicle const * veh, int amount, int ) {
@@ -2999,17 +3001,21 @@ int vehicle::engine_fuel_left( const int e, bool recurse ) const
 
 int vehicle::fuel_capacity( const itype_id &ftype ) const
 {
-    return std::accumulate( parts.begin(), parts.end(), 0, [&ftype]( const int &lhs,
-    const vehicle_part & rhs ) {
-        return lhs + ( rhs.ammo_current() == ftype ? rhs.ammo_capacity() : 0 );
-    } );
+    int capacity = 0;
+    for( const int p : fuel_containers ) {
+        if( parts[p].ammo_current() == ftype ) {
+            capacity += parts[p].ammo_capacity();
+        }
+    }
+    return capacity;
 }
 
 float vehicle::fuel_specific_energy( const itype_id &ftype ) const
 {
     float total_energy = 0;
     float total_mass = 0;
-    for( auto vehicle_part : parts ) {
+    for( const int p : fuel_containers ) {
+        const vehicle_part &vehicle_part = parts[p];
         if( vehicle_part.is_tank() && vehicle_part.ammo_current() == ftype  &&
             vehicle_part.base.contents_made_of( LIQUID ) ) {
             float energy = vehicle_part.base.contents.front().specific_energy;
@@ -3036,7 +3042,8 @@ int vehicle::drain( const itype_id &ftype, int amount )
     }
 
     int drained = 0;
-    for( auto &p : parts ) {
+    for( const int i : fuel_containers ) {
+        vehicle_part &p = parts[i];
         if( amount <= 0 ) {
             break;
         }
@@ -3990,7 +3997,8 @@ std::map<itype_id, int> vehicle::fuel_usage() const
 double vehicle::drain_energy( const itype_id &ftype, double energy_j )
 {
     double drained = 0.0f;
-    for( auto &p : parts ) {
+    for( const int i : fuel_containers ) {
+        vehicle_part &p = parts[i];
         if( energy_j <= 0.0f ) {
             break;
         }
@@ -4066,8 +4074,9 @@ void vehicle::consume_fuel( int load, const int t_seconds, bool skip_electric )
 std::vector<vehicle_part *> vehicle::lights( bool active )
 {
     std::vector<vehicle_part *> res;
-    for( auto &e : parts ) {
-        if( ( !active || e.enabled ) && e.is_available() && e.is_light() ) {
+    for( const int p : light_parts ) {
+        vehicle_part &e = parts[p];
+        if( ( !active || e.enabled ) && e.is_available() ) {
             res.push_back( &e );
         }
     }
@@ -4084,8 +4093,11 @@ int vehicle::total_epower_w( int &engine_epower, bool skip_solar )
 {
     int epower = 0;
 
-    for( const vpart_reference &vp : get_enabled_parts( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
-        epower += vp.info().epower;
+    for( const int p : epower_consumers ) {
+        const vehicle_part &pt = parts[p];
+        if( pt.enabled && pt.is_available() ) {
+            epower += pt.info().epower;
+        }
     }
 
     // Engines: can both produce (plasma) or consume (gas, diesel)
@@ -4214,17 +4226,21 @@ void vehicle::power_parts()
 
     if( battery_deficit != 0 ) {
         // Scoops need a special case since they consume power during actual use
-        for( const vpart_reference &vp : get_enabled_parts( "SCOOP" ) ) {
-            vp.part().enabled = false;
+        for( const int p : scoops ) {
+            if( parts[p].is_available() ) {
+                parts[p].enabled = false;
+            }
         }
         // Rechargers need special case since they consume power on demand
-        for( const vpart_reference &vp : get_enabled_parts( "RECHARGE" ) ) {
-            vp.part().enabled = false;
+        for( const int p : rechargers ) {
+            if( parts[p].is_available() ) {
+                parts[p].enabled = false;
+            }
         }
 
-        for( const vpart_reference &vp : get_enabled_parts( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
-            vehicle_part &pt = vp.part();
-            if( pt.info().epower < 0 ) {
+        for( const int p : epower_consumers ) {
+            vehicle_part &pt = parts[p];
+            if( pt.is_available() && pt.info().epower < 0 ) {
                 pt.enabled = false;
             }
         }
@@ -4330,8 +4346,9 @@ int vehicle::charge_battery( int amount, bool include_other_vehicles )
 {
     // Key parts by percentage charge level.
     std::multimap<int, vehicle_part *> chargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_capacity() > p.ammo_remaining() ) {
+    for( const int i : batteries ) {
+        vehicle_part &p = parts[i];
+        if( p.is_available() && p.ammo_capacity() > p.ammo_remaining() ) {
             chargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
         }
     }
@@ -4369,8 +4386,9 @@ int vehicle::discharge_battery( int amount, bool recurse )
 {
     // Key parts by percentage charge level.
     std::multimap<int, vehicle_part *> dischargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_remaining() > 0 ) {
+    for( const int i : batteries ) {
+        vehicle_part &p = parts[i];
+        if( p.is_available() && p.ammo_remaining() > 0 ) {
             dischargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
         }
     }
@@ -4489,7 +4507,8 @@ void vehicle::on_move()
 void vehicle::slow_leak()
 {
     // for each badly damaged tanks (lower than 50% health), leak a small amount
-    for( auto &p : parts ) {
+    for( const int i : fuel_containers ) {
+        vehicle_part &p = parts[i];
         auto health = p.health_percent();
         if( health > 0.5 || p.ammo_remaining() <= 0 ) {
             continue;
@@ -4836,6 +4855,12 @@ void vehicle::refresh()
     steering.clear();
     speciality.clear();
     floating.clear();
+    fuel_containers.clear();
+    batteries.clear();
+    light_parts.clear();
+    epower_consumers.clear();
+    scoops.clear();
+    rechargers.clear();
     alternator_load = 0;
     extra_drag = 0;
     all_wheels_on_one_axis = true;
@@ -4883,6 +4908,25 @@ void vehicle::refresh()
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
         }
+        // Broken parts may still hold fuel, and users check the availability themselves.
+        if( vp.part().is_fuel_store( false ) || vp.part().is_turret() ) {
+            fuel_containers.push_back( p );
+        }
+        if( vp.part().is_battery() ) {
+            batteries.push_back( p );
+        }
+        if( vp.part().is_light() ) {
+            light_parts.push_back( p );
+        }
+        if( vpi.has_flag( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
+            epower_consumers.push_back( p );
+        }
+        if( vpi.has_flag( "SCOOP" ) ) {
+            scoops.push_back( p );
+        }
+        if( vpi.has_flag( "RECHARGE" ) ) {
+            rechargers.push_back( p );
+        }
 
         if( vp.part().is_unavailable() ) {
             continue;
@@ -5526,7 +5570,8 @@ void vehicle::leak_fuel( vehicle_part &pt )
 std::map<itype_id, int> vehicle::fuels_left() const
 {
     std::map<itype_id, int> result;
-    for( const auto &p : parts ) {
+    for( const int i : fuel_containers ) {
+        const vehicle_part &p = parts[i];
         if( p.is_fuel_store() && p.ammo_current() != "null" ) {
             result[ p.ammo_current() ] += p.ammo_remaining();
         }
@@ -1271,8 +1271,9 @@ class vehicle
 
         // Handle given part collision with vehicle, monster/NPC/player or terrain obstacle
         // Returns collision, which has type, impulse, part, & target.
+        // Other vehicles are only checked if near_vehicle, see the broad phase in collision.
         veh_collision part_collision( int part, const tripoint &p,
-                                      bool just_detect, bool bash_floor );
+                                      bool just_detect, bool bash_floor, bool near_vehicle = true );
 
         // Process the trap beneath
         void handle_trap( const tripoint &p, int part );
@@ -1573,6 +1574,15 @@ class vehicle
         // List of parts that will not be on a vehicle very often, or which only one will be present
         std::vector<int> speciality;
         std::vector<int> floating;         // List of parts that provide buoyancy to boats
+        // List of parts that can hold fuel or ammo (tanks, batteries, reactors, turrets), including
+        // broken ones. Every part whose vehicle_part::ammo_current() can be set is in here.
+        std::vector<int> fuel_containers;
+        std::vector<int> batteries;        // List of batteries, including broken ones
+        std::vector<int> light_parts;      // List of lights, including broken ones
+        // List of ENABLED_DRAINS_EPOWER parts, including broken ones
+        std::vector<int> epower_consumers;
+        std::vector<int> scoops;           // List of SCOOP parts, including broken ones
+        std::vector<int> rechargers;       // List of RECHARGE parts, including broken ones
 
         // config values
         std::string name;   // vehicle name
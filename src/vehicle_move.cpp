@@ -364,6 +364,36 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
         just_detect = true;
     }
 
+    // Broad phase: only vehicles with bounds overlapping the swept bounds of the structure
+    // parts can be hit, the narrow phase only looks for vehicle parts within their bounds.
+    std::vector<rectangle> candidate_bounds;
+    if( !bash_floor ) {
+        cata::optional<box> swept;
+        for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
+            if( part_info( p ).location != part_location_structure || parts[p].removed ) {
+                continue;
+            }
+            const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
+            if( !swept ) {
+                swept = box( dsp, dsp );
+            } else {
+                swept->p_min = tripoint( std::min( swept->p_min.x, dsp.x ),
+                                         std::min( swept->p_min.y, dsp.y ),
+                                         std::min( swept->p_min.z, dsp.z ) );
+                swept->p_max = tripoint( std::max( swept->p_max.x, dsp.x ),
+                                         std::max( swept->p_max.y, dsp.y ),
+                                         std::max( swept->p_max.z, dsp.z ) );
+            }
+        }
+        if( swept ) {
+            for( const vehicle *other : g->m.vehicles_near( *swept, this ) ) {
+                if( const cata::optional<rectangle> bounds = g->m.vehicle_bounds( *other ) ) {
+                    candidate_bounds.push_back( *bounds );
+                }
+            }
+        }
+    }
+
     const int velocity_before = coll_velocity;
     const int sign_before = sgn( velocity_before );
     bool empty = true;
@@ -375,7 +405,11 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
         // Coordinates of where part will go due to movement (dx/dy/dz)
         //  and turning (precalc[1])
         const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
-        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
+        const bool near_vehicle = std::any_of( candidate_bounds.begin(), candidate_bounds.end(),
+        [&dsp]( const rectangle & bounds ) {
+            return bounds.contains_inclusive( dsp.xy() );
+        } );
+        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor, near_vehicle );
         if( coll.type == veh_coll_nothing ) {
             continue;
         }
@@ -425,7 +459,7 @@ static void terrain_collision_data( const tripoint &p, bool bash_floor,
 }
 
 veh_collision vehicle::part_collision( int part, const tripoint &p,
-                                       bool just_detect, bool bash_floor )
+                                       bool just_detect, bool bash_floor, bool near_vehicle )
 {
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
@@ -442,7 +476,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         ph = nullptr;
     }
 
-    const optional_vpart_position ovp = g->m.veh_at( p );
+    // Away from other vehicles the part is only needed to tell critters riding this one.
+    const optional_vpart_position ovp = near_vehicle || critter != nullptr ? g->m.veh_at( p ) :
+                                        optional_vpart_position( cata::nullopt );
     // Disable vehicle/critter collisions when bashing floor
     // TODO: More elegant code
     const bool is_veh_collision = !bash_floor && ovp && &ovp->vehicle() != this;
@@ -0,0 +1,71 @@
+#include <map>
+#include <vector>
+
+#include "active_item_cache.h"
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "item.h"
+#include "point.h"
+
+// How often each item is returned by get_for_processing in the given number of turns.
+static std::map<const item *, int> process_turns( active_item_cache &cache, const int turns )
+{
+    std::map<const item *, int> processed;
+    for( int i = 0; i < turns; i++ ) {
+        for( const item_reference &ref : cache.get_for_processing() ) {
+            processed[ref.item_ref.get()]++;
+        }
+        calendar::turn += 1;
+    }
+    return processed;
+}
+
+TEST_CASE( "active_item_cache_processes_items_when_due", "[item][active_item_cache]" )
+{
+    const calendar old_turn = calendar::turn;
+    calendar::turn = calendar::start;
+
+    std::vector<item> food( 20, item( "apple" ) );
+    item tool( "flashlight" );
+    const int food_speed = food.front().processing_speed();
+    REQUIRE( food_speed > 1 );
+    REQUIRE( tool.processing_speed() == 1 );
+
+    active_item_cache cache;
+    for( item &it : food ) {
+        cache.add( it, point_zero );
+    }
+    cache.add( tool, point_zero );
+    cache.add( tool, point_zero );
+    CHECK( cache.get().size() == food.size() + 1 );
+
+    SECTION( "each item is processed once per its processing speed" ) {
+        std::map<const item *, int> processed = process_turns( cache, food_speed * 3 );
+        CHECK( processed[&tool] == food_speed * 3 );
+        for( const item &it : food ) {
+            CHECK( processed[&it] == 3 );
+        }
+    }
+    SECTION( "processing the same turn again returns the same items" ) {
+        const size_t first = cache.get_for_processing().size();
+        CHECK( cache.get_for_processing().size() == first );
+    }
+    SECTION( "items due while the cache was not processed are caught up" ) {
+        process_turns( cache, 1 );
+        calendar::turn += 10 * food_speed;
+        std::map<const item *, int> processed = process_turns( cache, food_speed );
+        CHECK( processed[&tool] == food_speed );
+        for( const item &it : food ) {
+            CHECK( processed[&it] == 1 );
+        }
+    }
+    SECTION( "removed items are not processed" ) {
+        cache.remove( &tool );
+        cache.remove( &food.front() );
+        std::map<const item *, int> processed = process_turns( cache, food_speed );
+        CHECK( processed.count( &tool ) == 0 );
+        CHECK( processed.count( &food.front() ) == 0 );
+        CHECK( processed.size() == food.size() - 1 );
+    }
+    calendar::turn = old_turn;
+}
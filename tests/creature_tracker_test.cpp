@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "mtype.h"
+#include "point.h"
+#include "rng.h"
+
+static std::vector<monster *> brute_force( const tripoint &center, const int radius,
+        const Creature_tracker::monster_filter &filter )
+{
+    std::vector<monster *> result;
+    for( monster &critter : g->all_monsters() ) {
+        if( rl_dist( center, critter.pos() ) <= radius && ( !filter || filter( critter ) ) ) {
+            result.push_back( &critter );
+        }
+    }
+    std::sort( result.begin(), result.end(), [&center]( const monster * a, const monster * b ) {
+        const int da = rl_dist( center, a->pos() );
+        const int db = rl_dist( center, b->pos() );
+        return da != db ? da < db : a->pos() < b->pos();
+    } );
+    return result;
+}
+
+static void check_queries( const Creature_tracker::monster_filter &filter )
+{
+    const Creature_tracker &tracker = *g->critter_tracker;
+    for( int i = 0; i < 20; i++ ) {
+        const tripoint center( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        for( const int radius : { 0, 5, 13, 40, MAX_VIEW_DISTANCE, 1000 } ) {
+            const std::vector<monster *> expected = brute_force( center, radius, filter );
+            CHECK( tracker.find_in_radius( center, radius, filter ) == expected );
+            for( const size_t k : { 1, 3, 10 } ) {
+                std::vector<monster *> nearest( expected.begin(),
+                                                expected.begin() + std::min( k, expected.size() ) );
+                CHECK( tracker.find_nearest( center, k, radius, filter ) == nearest );
+            }
+        }
+    }
+}
+
+TEST_CASE( "creature_tracker_spatial_queries", "[monster][creature_tracker]" )
+{
+    clear_map();
+    for( int i = 0; i < 80; i++ ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( g->critter_at( p ) == nullptr ) {
+            spawn_test_monster( one_in( 2 ) ? "mon_zombie" : "mon_dog", p );
+        }
+    }
+    const mtype_id zombie( "mon_zombie" );
+    const Creature_tracker::monster_filter zombies_only = [&zombie]( const monster & critter ) {
+        return critter.type->id == zombie;
+    };
+
+    SECTION( "queries match a brute force search" ) {
+        check_queries( nullptr );
+        check_queries( zombies_only );
+    }
+    SECTION( "the index follows moved and removed monsters" ) {
+        std::vector<monster *> critters;
+        for( monster &critter : g->all_monsters() ) {
+            critters.push_back( &critter );
+        }
+        for( size_t i = 0; i < critters.size(); i += 3 ) {
+            const tripoint dest( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+            if( g->critter_at( dest ) == nullptr ) {
+                critters[i]->setpos( dest );
+            }
+        }
+        g->remove_zombie( *critters[1] );
+        check_queries( nullptr );
+        check_queries( zombies_only );
+    }
+    clear_map();
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "filesystem.h"
+#include "init.h"
+#include "json.h"
+#include "loading_ui.h"
+#include "parallel.h"
+#include "path_info.h"
+
+// Records the ids of the objects it loads, in order.
+class test_data_loader : public DynamicDataLoader
+{
+    public:
+        test_data_loader() {
+            add( "test_data_entry", [this]( JsonObject & jo ) {
+                loaded.push_back( jo.get_string( "id" ) );
+            } );
+        }
+
+        // The plain loader without the parallel parsing, one file at a time.
+        void load_file_serially( const std::string &file ) {
+            std::ifstream fin( file, std::ios::binary );
+            JsonIn jsin( fin );
+            loading_ui ui( false );
+            try {
+                load_all_from_json( jsin, "test", ui, file, file );
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( file + ": " + err.what() );
+            }
+        }
+
+        std::vector<std::string> loaded;
+};
+
+static void write_file( const std::string &path, const std::string &content )
+{
+    std::ofstream fout( path, std::ios::binary | std::ios::trunc );
+    fout << content;
+}
+
+static std::string entry( const std::string &id )
+{
+    return "{ \"type\": \"test_data_entry\", \"id\": \"" + id + "\" }";
+}
+
+static std::vector<std::string> load_in_parallel( const std::string &dir, std::string &error )
+{
+    test_data_loader loader;
+    loading_ui ui( false );
+    try {
+        loader.load_data_from_path( dir, "test", ui );
+    } catch( const std::exception &err ) {
+        error = err.what();
+    }
+    return loader.loaded;
+}
+
+static std::vector<std::string> load_serially( const std::string &dir, std::string &error )
+{
+    test_data_loader loader;
+    try {
+        for( const std::string &file : get_files_from_path( ".json", dir, true, true ) ) {
+            loader.load_file_serially( file );
+        }
+    } catch( const std::exception &err ) {
+        error = err.what();
+    }
+    return loader.loaded;
+}
+
+static void remove_test_dir( const std::string &dir )
+{
+    for( const std::string &file : get_files_from_path( ".json", dir, true, true ) ) {
+        remove_file( file );
+    }
+    remove_directory( dir );
+}
+
+TEST_CASE( "parallel_data_loading_keeps_the_file_order", "[init]" )
+{
+    const std::string dir = FILENAMES["user_dir"] + "data_loading_test";
+    remove_test_dir( dir );
+    REQUIRE( assure_dir_exist( dir ) );
+    // More files than are parsed in one batch.
+    const int num_files = 4 * parallel_thread_count() + 3;
+    for( int i = 0; i < num_files; ++i ) {
+        const std::string name = dir + "/file_" + std::to_string( i ) + ".json";
+        if( i == 1 ) {
+            // A file with a single object instead of an array.
+            write_file( name, entry( "single" ) );
+        } else {
+            const std::string prefix = std::to_string( i ) + "_";
+            write_file( name, "[ " + entry( prefix + "a" ) + ", " + entry( prefix + "b" ) + " ]" );
+        }
+    }
+
+    std::string parallel_error;
+    const std::vector<std::string> parallel = load_in_parallel( dir, parallel_error );
+    std::string serial_error;
+    const std::vector<std::string> serial = load_serially( dir, serial_error );
+    CHECK( parallel_error.empty() );
+    CHECK( serial_error.empty() );
+    CHECK( parallel.size() == static_cast<size_t>( num_files * 2 - 1 ) );
+    CHECK( parallel == serial );
+
+    SECTION( "a parse error is reported the same way" ) {
+        write_file( dir + "/file_2.json", "[ " + entry( "before_error" ) + ",\n  { \"type\": ] " );
+        std::string broken_parallel_error;
+        const std::vector<std::string> broken_parallel = load_in_parallel( dir,
+                broken_parallel_error );
+        std::string broken_serial_error;
+        const std::vector<std::string> broken_serial = load_serially( dir, broken_serial_error );
+        CHECK( broken_parallel_error.find( "file_2.json: " ) != std::string::npos );
+        CHECK( broken_parallel_error.find( "expected JSON value" ) != std::string::npos );
+        CHECK( broken_parallel_error == broken_serial_error );
+        // The objects in front of the error have been loaded, nothing after it.
+        CHECK( std::find( broken_parallel.begin(), broken_parallel.end(),
+                          "before_error" ) != broken_parallel.end() );
+        CHECK( broken_parallel == broken_serial );
+    }
+    remove_test_dir( dir );
+}
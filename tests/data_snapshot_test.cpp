@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "data_snapshot.h"
+#include "filesystem.h"
+#include "item_factory.h"
+#include "mapdata.h"
+#include "monstergenerator.h"
+#include "path_info.h"
+#include "requirements.h"
+
+TEST_CASE( "data_snapshot_digest_is_deterministic", "[data_snapshot]" )
+{
+    data_snapshot::snapshot first;
+    first.digests = data_snapshot::digest_finalized_data();
+    data_snapshot::snapshot second;
+    second.digests = data_snapshot::digest_finalized_data();
+    for( const char *kind : {
+             "items", "monsters", "terrain", "furniture", "recipes", "requirements"
+         } ) {
+        CAPTURE( kind );
+        CHECK_FALSE( first.digests[kind].empty() );
+    }
+    CHECK( first.digests == second.digests );
+    CHECK( data_snapshot::report_differences( first, second ) == 0 );
+}
+
+TEST_CASE( "data_snapshot_round_trip", "[data_snapshot]" )
+{
+    const std::string path = FILENAMES["user_dir"] + "data_snapshot_test.bin";
+    data_snapshot::snapshot written;
+    written.key = data_snapshot::initial_key();
+    written.digests = data_snapshot::digest_finalized_data();
+    REQUIRE( data_snapshot::write( path, written ) );
+
+    data_snapshot::snapshot read;
+    REQUIRE( data_snapshot::read( path, read ) );
+    CHECK( read.key == written.key );
+    CHECK( read.digests == written.digests );
+
+    // A truncated file is rejected rather than read partially.
+    {
+        std::ofstream fout( path, std::ios::binary | std::ios::trunc );
+        fout << "CDDASNAP";
+    }
+    CHECK_FALSE( data_snapshot::read( path, read ) );
+    remove_file( path );
+    CHECK_FALSE( data_snapshot::read( path, read ) );
+}
+
+static long long microseconds_since( const std::chrono::steady_clock::time_point &start )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>
+           ( std::chrono::steady_clock::now() - start ).count();
+}
+
+// What hashing the json files costs on every start, against the checks it lets us skip.
+TEST_CASE( "data_snapshot_performance", "[.]" )
+{
+    std::vector<std::string> contents;
+    size_t total_size = 0;
+    for( const std::string &file : get_files_from_path( ".json", FILENAMES["datadir"] + "json/",
+            true, true ) ) {
+        std::ifstream fin( file, std::ios::binary );
+        std::ostringstream content;
+        content << fin.rdbuf();
+        contents.push_back( content.str() );
+        total_size += contents.back().size();
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t key = data_snapshot::initial_key();
+    for( const std::string &content : contents ) {
+        const uint64_t hash = data_snapshot::hash_bytes( content.data(), content.size() );
+        key = data_snapshot::hash_bytes( &hash, sizeof( hash ), key );
+    }
+    const long long hashing = microseconds_since( start );
+
+    start = std::chrono::steady_clock::now();
+    data_snapshot::digest_finalized_data();
+    const long long digesting = microseconds_since( start );
+
+    start = std::chrono::steady_clock::now();
+    requirement_data::check_consistency();
+    item_controller->check_definitions();
+    MonsterGenerator::generator().check_monster_definitions();
+    check_furniture_and_terrain();
+    const long long checks = microseconds_since( start );
+
+    printf( "Hashing %d json files (%d bytes, key %llx) took %lld microseconds.\n",
+            static_cast<int>( contents.size() ), static_cast<int>( total_size ),
+            static_cast<unsigned long long>( key ), hashing );
+    printf( "Digesting the finalized data for a new snapshot took %lld microseconds.\n",
+            digesting );
+    printf( "The checks skipped for unchanged data took %lld microseconds.\n", checks );
+}
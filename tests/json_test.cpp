@@ -0,0 +1,100 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "json.h"
+
+static const std::string test_json =
+    "{\n"
+    "  \"plain\": \"some text\",\n"
+    "  \"escaped\": \"a \\\"quote\\\", a \\\\ and \\u00e4\\n\",\n"
+    "  \"numbers\": [ 0, -12, 3.5, 1.2e3, 7 ],\n"
+    "  \"flags\": [ true, false, null ],\n"
+    "  \"nested\": { \"empty\": [], \"text\": \"\" }\n"
+    "}";
+
+static void check_test_json( JsonIn &jsin )
+{
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.get_string( "plain" ) == "some text" );
+    CHECK( jo.get_string( "escaped" ) == "a \"quote\", a \\ and \xc3\xa4\n" );
+    CHECK( jo.get_int_array( "numbers" ) == std::vector<int>( { 0, -12, 3, 1200, 7 } ) );
+    JsonArray numbers = jo.get_array( "numbers" );
+    numbers.next_int();
+    numbers.next_int();
+    CHECK( numbers.next_float() == Approx( 3.5 ) );
+    JsonArray flags = jo.get_array( "flags" );
+    CHECK( flags.next_bool() );
+    CHECK_FALSE( flags.next_bool() );
+    CHECK( flags.test_null() );
+    JsonObject nested = jo.get_object( "nested" );
+    CHECK( nested.get_array( "empty" ).empty() );
+    CHECK( nested.get_string( "text" ).empty() );
+}
+
+TEST_CASE( "json_input_from_stream_and_buffer", "[json]" )
+{
+    SECTION( "stream" ) {
+        std::istringstream buffer( test_json );
+        JsonIn jsin( buffer );
+        check_test_json( jsin );
+    }
+    SECTION( "buffer" ) {
+        JsonIn jsin( test_json.data(), test_json.size() );
+        check_test_json( jsin );
+    }
+    SECTION( "stream after a header line" ) {
+        std::istringstream buffer( "# version 1\n" + test_json );
+        std::string header;
+        std::getline( buffer, header );
+        JsonIn jsin( buffer );
+        check_test_json( jsin );
+    }
+}
+
+TEST_CASE( "json_values_at_end_of_input", "[json]" )
+{
+    const std::string number = "42";
+    JsonIn number_in( number.data(), number.size() );
+    CHECK( number_in.get_int() == 42 );
+    CHECK_FALSE( number_in.good() );
+
+    const std::string boolean = "true";
+    JsonIn bool_in( boolean.data(), boolean.size() );
+    CHECK( bool_in.get_bool() );
+
+    const std::string unterminated = "\"text";
+    JsonIn string_in( unterminated.data(), unterminated.size() );
+    CHECK_THROWS_AS( string_in.get_string(), JsonError );
+}
+
+TEST_CASE( "json_string_view_of_unescaped_strings", "[json]" )
+{
+    const std::string input = "[ \"plain\", \"with \\\"escape\\\"\", \"\" ]";
+    JsonIn jsin( input.data(), input.size() );
+    jsin.start_array();
+    json_string_view view;
+    REQUIRE( jsin.get_string_view( view ) );
+    CHECK( view == "plain" );
+    // Escaped strings are left for get_string.
+    CHECK_FALSE( jsin.get_string_view( view ) );
+    CHECK( jsin.get_string() == "with \"escape\"" );
+    REQUIRE( jsin.get_string_view( view ) );
+    CHECK( view.size == 0 );
+    CHECK( jsin.end_array() );
+}
+
+TEST_CASE( "json_errors_point_to_the_location", "[json]" )
+{
+    const std::string input = "{\n  \"a\": 1,\n  \"b\": tru\n}";
+    JsonIn jsin( input.data(), input.size() );
+    try {
+        jsin.skip_value();
+        FAIL( "invalid json was accepted" );
+    } catch( const JsonError &err ) {
+        const std::string message = err.what();
+        CHECK( message.find( "line 3:8" ) != std::string::npos );
+        CHECK( message.find( "expected \"true\"" ) != std::string::npos );
+    }
+}
@@ -0,0 +1,121 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "avatar.h"
+#include "catch/catch.hpp"
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "rng.h"
+#include "shadowcasting.h"
+#include "type_id.h"
+#include "game_constants.h"
+#include "point.h"
+
+// Builds the lightmap (incrementally if possible) and compares it against the
+// result of building it from scratch. Returns whether it was built incrementally.
+static bool check_lightmap_matches_full_rebuild( const int zlev )
+{
+    g->m.build_map_cache( zlev );
+    const level_cache &cache = g->m.access_cache( zlev );
+    const bool incremental = cache.lightmap_incremental;
+    const std::vector<four_quadrants> incremental_lm( &cache.lm[0][0],
+            &cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    const std::vector<float> incremental_sm( &cache.sm[0][0], &cache.sm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+
+    g->m.set_lightmap_dirty( zlev );
+    g->m.build_map_cache( zlev );
+    CHECK_FALSE( cache.lightmap_incremental );
+
+    CHECK( std::memcmp( incremental_lm.data(), &cache.lm[0][0],
+                        sizeof( four_quadrants ) * MAPSIZE_X * MAPSIZE_Y ) == 0 );
+    CHECK( std::memcmp( incremental_sm.data(), &cache.sm[0][0],
+                        sizeof( float ) * MAPSIZE_X * MAPSIZE_Y ) == 0 );
+    return incremental;
+}
+
+TEST_CASE( "incremental_lightmap_matches_full_rebuild", "[lightmap]" )
+{
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+    const ter_id t_grass( "t_grass" );
+
+    clear_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    g->u.worn.clear();
+    g->u.clear_effects();
+    g->reset_light_level();
+    // Midnight, so the light sources actually show up in the lightmap.
+    calendar::turn = DAYS( 1 );
+
+    // A few walls so the light sources cast some shadows.
+    for( int x = 40; x < 80; x += 3 ) {
+        for( int y = 40; y < 80; y += 5 ) {
+            g->m.ter_set( tripoint( x, y, 0 ), t_brick_wall );
+        }
+    }
+    g->m.build_map_cache( 0 );
+
+    const auto random_floor = [&t_brick_wall]() {
+        tripoint p;
+        do {
+            p = tripoint( rng( 30, 90 ), rng( 30, 90 ), 0 );
+        } while( g->m.ter( p ) == t_brick_wall || p == g->u.pos() );
+        return p;
+    };
+
+    SECTION( "light sources appearing and disappearing" ) {
+        std::vector<tripoint> lights;
+        for( int i = 0; i < 20; ++i ) {
+            const tripoint p = random_floor();
+            switch( rng( 0, 3 ) ) {
+                case 0:
+                    g->m.ter_set( p, t_utility_light );
+                    break;
+                case 1:
+                    g->m.add_field( p, fd_fire, 1 );
+                    break;
+                default:
+                    g->m.add_item( p, item( "candle_lit" ) );
+                    break;
+            }
+            lights.push_back( p );
+            check_lightmap_matches_full_rebuild( 0 );
+
+            if( one_in( 3 ) ) {
+                const tripoint &q = random_entry( lights );
+                g->m.ter_set( q, t_grass );
+                g->m.remove_field( q, fd_fire );
+                g->m.i_clear( q );
+                check_lightmap_matches_full_rebuild( 0 );
+            }
+        }
+    }
+
+    SECTION( "a light source moving around" ) {
+        tripoint p = random_floor();
+        for( int i = 0; i < 20; ++i ) {
+            g->m.i_clear( p );
+            p = random_floor();
+            g->m.add_item( p, item( "candle_lit" ) );
+            // Only the light sources changed, so the last lightmap is reused.
+            CHECK( check_lightmap_matches_full_rebuild( 0 ) );
+        }
+    }
+
+    SECTION( "walls changing next to light sources" ) {
+        const tripoint light = random_floor();
+        g->m.ter_set( light, t_utility_light );
+        check_lightmap_matches_full_rebuild( 0 );
+        for( int i = 0; i < 10; ++i ) {
+            g->m.ter_set( light + point( rng( -3, 3 ), rng( -3, 3 ) ), one_in( 2 ) ? t_brick_wall : t_floor );
+            g->m.ter_set( light, t_utility_light );
+            check_lightmap_matches_full_rebuild( 0 );
+        }
+    }
+}
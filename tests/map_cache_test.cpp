@@ -0,0 +1,98 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options.h"
+#include "parallel.h"
+#include "rng.h"
+#include "type_id.h"
+#include "game_constants.h"
+#include "point.h"
+
+struct level_caches {
+    std::vector<bool> outside;
+    std::vector<bool> floor;
+    std::vector<float> transparency;
+};
+
+// Rebuilds the caches of all z-levels from scratch and returns a copy of them.
+static std::vector<level_caches> rebuild_map_caches( map &m )
+{
+    const int minz = m.has_zlevels() ? -OVERMAP_DEPTH : 0;
+    const int maxz = m.has_zlevels() ? OVERMAP_HEIGHT : 0;
+    for( int z = minz; z <= maxz; z++ ) {
+        m.set_outside_cache_dirty( z );
+        m.set_transparency_cache_dirty( z );
+        m.set_floor_cache_dirty( z );
+    }
+    m.build_map_cache( 0, true );
+
+    std::vector<level_caches> result;
+    for( int z = minz; z <= maxz; z++ ) {
+        const level_cache &ch = m.access_cache( z );
+        const bool *outside = &ch.outside_cache[0][0];
+        const bool *floor = &ch.floor_cache[0][0];
+        const float *transparency = &ch.transparency_cache[0][0];
+        result.push_back( level_caches{
+            std::vector<bool>( outside, outside + MAPSIZE_X * MAPSIZE_Y ),
+            std::vector<bool>( floor, floor + MAPSIZE_X * MAPSIZE_Y ),
+            std::vector<float>( transparency, transparency + MAPSIZE_X * MAPSIZE_Y )
+        } );
+    }
+    return result;
+}
+
+TEST_CASE( "parallel_map_cache_matches_serial", "[map][cache]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+    const ter_id t_open_air( "t_open_air" );
+    clear_map();
+    // The caches are only built in parallel if there are several z-levels.
+    map m( true );
+    m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+
+    for( int i = 0; i < 200; ++i ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), rng( -2, 2 ) );
+        switch( rng( 0, 3 ) ) {
+            case 0:
+                m.ter_set( p, t_brick_wall );
+                break;
+            case 1:
+                m.ter_set( p, t_floor );
+                break;
+            case 2:
+                m.ter_set( p, t_open_air );
+                break;
+            default:
+                m.add_field( p, fd_smoke, 3 );
+                break;
+        }
+    }
+
+    options_manager::cOpt &opt = get_options().get_option( "PARALLEL_MAP_CACHE" );
+    const std::string old_value = opt.getValue();
+
+    opt.setValue( "false" );
+    const std::vector<level_caches> serial = rebuild_map_caches( m );
+    opt.setValue( "true" );
+    // Several threads, even on single core machines.
+    set_parallel_thread_count( 4 );
+    const std::vector<level_caches> parallel = rebuild_map_caches( m );
+    set_parallel_thread_count( 0 );
+    opt.setValue( old_value );
+
+    REQUIRE( serial.size() == parallel.size() );
+    for( size_t i = 0; i < serial.size(); ++i ) {
+        INFO( "z-level " << static_cast<int>( i ) - OVERMAP_DEPTH );
+        CHECK( serial[i].outside == parallel[i].outside );
+        CHECK( serial[i].floor == parallel[i].floor );
+        CHECK( std::memcmp( serial[i].transparency.data(), parallel[i].transparency.data(),
+                            sizeof( float ) * MAPSIZE_X * MAPSIZE_Y ) == 0 );
+    }
+}
@@ -1,7 +1,10 @@
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "avatar.h"
 #include "catch/catch.hpp"
+#include "field.h"
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -9,6 +12,7 @@
 #include "game_constants.h"
 #include "type_id.h"
 #include "point.h"
+#include "rng.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
 {
@@ -78,3 +82,87 @@ TEST_CASE( "tinymap_bounds_checking" )
         }
     }
 }
+
+TEST_CASE( "sees_follows_transparency_changes", "[map][vision]" )
+{
+    clear_map();
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 70, 64, 0 );
+    const auto set_column = []( const ter_id & ter ) {
+        for( int y = 55; y <= 70; y++ ) {
+            g->m.ter_set( tripoint( 65, y, 0 ), ter );
+        }
+    };
+    g->m.build_map_cache( 0 );
+    REQUIRE( g->m.sees( from, to, 60 ) );
+    // Asked again, this is answered from the memoized result.
+    CHECK( g->m.sees( from, to, 60 ) );
+    CHECK_FALSE( g->m.sees( from, to, 5 ) );
+
+    set_column( ter_id( "t_wall" ) );
+    g->m.build_map_cache( 0 );
+    CHECK_FALSE( g->m.sees( from, to, 60 ) );
+    CHECK_FALSE( g->m.sees( from, to, 60 ) );
+
+    set_column( ter_id( "t_floor" ) );
+    g->m.build_map_cache( 0 );
+    CHECK( g->m.sees( from, to, 60 ) );
+    clear_map();
+}
+
+TEST_CASE( "precomputed_sees_matches_walked_lines", "[map][vision]" )
+{
+    clear_map();
+    for( int i = 0; i < 200; i++ ) {
+        g->m.ter_set( tripoint( rng( 40, 90 ), rng( 40, 90 ), 0 ), ter_id( "t_wall" ) );
+    }
+    g->m.build_map_cache( 0 );
+    std::vector<std::pair<tripoint, tripoint>> lines;
+    for( int i = 0; i < 500; i++ ) {
+        lines.emplace_back( tripoint( rng( 40, 90 ), rng( 40, 90 ), 0 ),
+                            tripoint( rng( 40, 90 ), rng( 40, 90 ), 0 ) );
+    }
+    std::vector<bool> expected;
+    for( const auto &line : lines ) {
+        expected.push_back( g->m.sees( line.first, line.second, 60 ) );
+    }
+
+    // Drop the remembered results, then let them be computed in advance.
+    g->m.set_transparency_cache_dirty( 0 );
+    g->m.build_map_cache( 0 );
+    g->m.precompute_sees( lines );
+    for( size_t i = 0; i < lines.size(); i++ ) {
+        CHECK( g->m.sees( lines[i].first, lines[i].second, 60 ) == expected[i] );
+    }
+    clear_map();
+}
+
+TEST_CASE( "process_fields_dirties_transparency_only_for_opacity_changes", "[map][field]" )
+{
+    clear_map();
+    // clear_map only clears the z-levels most tests use, any other field could dirty the cache.
+    if( g->m.has_zlevels() ) {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+            clear_fields( z );
+        }
+    }
+    const tripoint blood_pos( 60, 60, 0 );
+    const tripoint smoke_pos( 70, 60, 0 );
+    // Settle whatever fields clear_map removed.
+    g->m.process_fields();
+
+    // Blood never blocks any light, no matter how it changes.
+    g->m.add_field( blood_pos, fd_blood, 3 );
+    for( int turn = 0; turn < 20; turn++ ) {
+        CHECK_FALSE( g->m.process_fields() );
+    }
+
+    g->m.add_field( smoke_pos, fd_smoke, 3 );
+    bool dirtied = false;
+    for( int turn = 0; turn < 100 && g->m.get_field( smoke_pos, fd_smoke ) != nullptr; turn++ ) {
+        dirtied |= g->m.process_fields();
+    }
+    // Smoke spreads, thins out and finally vanishes, all of which changes the translucency.
+    CHECK( dirtied );
+    clear_map();
+}
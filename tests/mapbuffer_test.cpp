@@ -0,0 +1,117 @@
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "field.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "options.h"
+#include "game_constants.h"
+#include "point.h"
+#include "submap.h"
+#include "submap_binary.h"
+#include "trap.h"
+
+static bool mapbuffer_contains( const tripoint &sm_addr )
+{
+    for( const auto &elem : MAPBUFFER ) {
+        if( elem.first == sm_addr ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE( "async_map_io_round_trip", "[map][mapbuffer]" )
+{
+    clear_map();
+    const tripoint abs_sub = g->m.get_abs_sub();
+    const std::vector<tripoint> spots = { { 5, 5, 0 }, { 40, 70, 0 }, { 100, 30, 0 } };
+    for( const tripoint &p : spots ) {
+        g->m.i_clear( p );
+        g->m.add_item( p, item( "rock" ) );
+    }
+
+    options_manager::cOpt &opt = get_options().get_option( "ASYNC_MAP_IO" );
+    const std::string old_value = opt.getValue();
+    opt.setValue( "true" );
+
+    // Saving with delete_after_save removes all submaps from the buffer, the map has to
+    // be loaded again right away (its submap pointers are dangling until then).
+    SECTION( "submaps written in the background are read back" ) {
+        MAPBUFFER.save( true );
+        g->m.load( abs_sub, false );
+    }
+    SECTION( "prefetched submaps are loaded before they are looked up" ) {
+        MAPBUFFER.save( true );
+        MAPBUFFER.prefetch( abs_sub, abs_sub + tripoint( MAPSIZE - 1, MAPSIZE - 1, 0 ) );
+        MAPBUFFER.flush();
+        MAPBUFFER.load_prefetched( MAPSIZE * MAPSIZE );
+        for( const tripoint &p : spots ) {
+            CHECK( mapbuffer_contains( abs_sub + tripoint( p.x / SEEX, p.y / SEEY, 0 ) ) );
+        }
+        g->m.load( abs_sub, false );
+    }
+    opt.setValue( old_value );
+
+    for( const tripoint &p : spots ) {
+        INFO( p.to_string() );
+        CHECK( g->m.i_at( p ).size() == 1 );
+    }
+    clear_map();
+}
+
+static std::string submap_json( const submap &sm )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    sm.store( jsout );
+    jsout.end_object();
+    return os.str();
+}
+
+TEST_CASE( "binary_submap_format_is_lossless", "[map][mapbuffer]" )
+{
+    clear_map();
+    g->m.ter_set( tripoint( 1, 1, 0 ), ter_id( "t_rock_floor" ) );
+    g->m.ter_set( tripoint( 2, 1, 0 ), ter_id( "t_rock_floor" ) );
+    g->m.furn_set( tripoint( 3, 4, 0 ), furn_id( "f_chair" ) );
+    g->m.trap_set( tripoint( 5, 6, 0 ), tr_bubblewrap );
+    g->m.set_radiation( tripoint( 7, 8, 0 ), 25 );
+    g->m.add_field( tripoint( 9, 10, 0 ), fd_blood, 2 );
+    g->m.add_item( tripoint( 11, 3, 0 ), item( "rock" ) );
+    g->m.add_item( tripoint( 14, 20, 0 ), item( "rock" ) );
+
+    const tripoint abs_sub = g->m.get_abs_sub();
+    std::vector<std::pair<tripoint, const submap *>> quad;
+    for( int x = 0; x < 2; x++ ) {
+        for( int y = 0; y < 2; y++ ) {
+            const tripoint p = abs_sub + tripoint( x, y, 0 );
+            quad.emplace_back( p, MAPBUFFER.lookup_submap( p ) );
+        }
+    }
+
+    std::stringstream binary;
+    submap_binary::write( binary, quad );
+    REQUIRE( submap_binary::is_binary( binary ) );
+
+    size_t n = 0;
+    submap_binary::read( binary, [&]( const tripoint & p, std::unique_ptr<submap> &sm ) {
+        REQUIRE( n < quad.size() );
+        CHECK( p == quad[n].first );
+        CHECK( submap_json( *sm ) == submap_json( *quad[n].second ) );
+        n++;
+    } );
+    CHECK( n == quad.size() );
+
+    std::stringstream json( "[]" );
+    CHECK_FALSE( submap_binary::is_binary( json ) );
+    clear_map();
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <vector>
+
+#include "avatar.h"
+#include "catch/catch.hpp"
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "game_constants.h"
+#include "mongroup.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+
+static mongroup make_group( const tripoint &pos, const int tag )
+{
+    mongroup group( mongroup_id( "GROUP_ZOMBIE" ), pos.x, pos.y, pos.z, 1, 10 );
+    // Identifies the group in the checks below.
+    group.interest = tag;
+    return group;
+}
+
+// Tags of the groups at the position, sorted.
+static std::vector<int> tags_at( const mongroup_map &groups, const tripoint &p )
+{
+    std::vector<int> tags;
+    for( const mongroup *group : groups.at( p ) ) {
+        CHECK( group->pos == p );
+        tags.push_back( group->interest );
+    }
+    std::sort( tags.begin(), tags.end() );
+    return tags;
+}
+
+// Every group must be found at its own position.
+static void check_index( const mongroup_map &groups )
+{
+    for( const mongroup &group : groups ) {
+        const std::vector<int> tags = tags_at( groups, group.pos );
+        CHECK( std::count( tags.begin(), tags.end(), group.interest ) == 1 );
+    }
+}
+
+TEST_CASE( "mongroup_map_finds_groups_by_position", "[mongroup]" )
+{
+    mongroup_map groups;
+    groups.insert( make_group( tripoint( 5, 5, 0 ), 1 ) );
+    groups.insert( make_group( tripoint( 5, 5, 0 ), 2 ) );
+    groups.insert( make_group( tripoint( 6, 5, 0 ), 3 ) );
+    groups.insert( make_group( tripoint( 5, 5, -1 ), 4 ) );
+    // Outside of the overmap.
+    groups.insert( make_group( tripoint( -1, -3, 0 ), 5 ) );
+    REQUIRE( groups.size() == 5 );
+
+    CHECK( tags_at( groups, tripoint( 5, 5, 0 ) ) == std::vector<int>( { 1, 2 } ) );
+    CHECK( tags_at( groups, tripoint( 6, 5, 0 ) ) == std::vector<int>( { 3 } ) );
+    CHECK( tags_at( groups, tripoint( 5, 5, -1 ) ) == std::vector<int>( { 4 } ) );
+    CHECK( tags_at( groups, tripoint( -1, -3, 0 ) ) == std::vector<int>( { 5 } ) );
+    CHECK( tags_at( groups, tripoint( 3, -3, 0 ) ).empty() );
+    CHECK( tags_at( groups, tripoint( 7, 7, 0 ) ).empty() );
+
+    SECTION( "moved groups are found at their new position" ) {
+        for( mongroup &group : groups ) {
+            if( group.interest == 1 ) {
+                // Into another cell.
+                groups.move( group, tripoint( 40, -20, 0 ) );
+            } else if( group.interest == 3 ) {
+                // Within the same cell.
+                groups.move( group, tripoint( 7, 7, 0 ) );
+            }
+        }
+        CHECK( tags_at( groups, tripoint( 5, 5, 0 ) ) == std::vector<int>( { 2 } ) );
+        CHECK( tags_at( groups, tripoint( 40, -20, 0 ) ) == std::vector<int>( { 1 } ) );
+        CHECK( tags_at( groups, tripoint( 6, 5, 0 ) ).empty() );
+        CHECK( tags_at( groups, tripoint( 7, 7, 0 ) ) == std::vector<int>( { 3 } ) );
+        check_index( groups );
+    }
+    SECTION( "removed groups are no longer found" ) {
+        groups.remove_if( []( const mongroup & group ) {
+            return group.interest % 2 == 1;
+        } );
+        CHECK( groups.size() == 2 );
+        CHECK( tags_at( groups, tripoint( 5, 5, 0 ) ) == std::vector<int>( { 2 } ) );
+        CHECK( tags_at( groups, tripoint( 6, 5, 0 ) ).empty() );
+        CHECK( tags_at( groups, tripoint( -1, -3, 0 ) ).empty() );
+        check_index( groups );
+    }
+    SECTION( "extracted groups are returned" ) {
+        std::vector<mongroup> extracted = groups.extract_if( []( const mongroup & group ) {
+            return group.pos.z == 0 && group.pos.x > 0;
+        } );
+        std::vector<int> tags;
+        for( const mongroup &group : extracted ) {
+            tags.push_back( group.interest );
+        }
+        std::sort( tags.begin(), tags.end() );
+        CHECK( tags == std::vector<int>( { 1, 2, 3 } ) );
+        CHECK( groups.size() == 2 );
+        CHECK( tags_at( groups, tripoint( 5, 5, 0 ) ).empty() );
+        check_index( groups );
+    }
+}
+
+// Number of zombie hordes at the absolute submap position, looked up in the overmap
+// that contains the position.
+static int hordes_at( const tripoint &p )
+{
+    int result = 0;
+    for( const mongroup *group : overmap_buffer.groups_at( p ) ) {
+        if( group->horde && group->type == mongroup_id( "GROUP_ZOMBIE" ) ) {
+            result++;
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "hordes_walk_into_the_adjacent_overmap", "[mongroup][overmap]" )
+{
+    // The overmap of the player, its hordes are moved, and the one east of it.
+    const tripoint player_sm = g->u.global_sm_location();
+    const point om = sm_to_om_copy( player_sm.xy() );
+    overmap &west = overmap_buffer.get( om );
+    overmap &east = overmap_buffer.get( om + point( 1, 0 ) );
+    west.clear_mon_groups();
+    east.clear_mon_groups();
+
+    // At the east border of the player's overmap, heading into the next one.
+    const point west_sm = om_to_sm_copy( om );
+    const tripoint start( west_sm.x + OMAPX * 2 - 1, player_sm.y, 0 );
+    const tripoint next = start + tripoint( 1, 0, 0 );
+    mongroup horde( mongroup_id( "GROUP_ZOMBIE" ), start.x - west_sm.x, start.y - west_sm.y, 0,
+                    1, 10 );
+    horde.horde = true;
+    horde.horde_behaviour = "roam";
+    horde.target = horde.pos + tripoint( 5, 0, 0 );
+    west.insert_mongroup( horde );
+    REQUIRE( hordes_at( start ) == 1 );
+
+    // Whether the horde moves is random, keep it interested until it did.
+    for( int i = 0; i < 1000 && hordes_at( start ) == 1; ++i ) {
+        for( mongroup *group : overmap_buffer.groups_at( start ) ) {
+            group->set_interest( 100 );
+        }
+        overmap_buffer.move_hordes();
+        REQUIRE( hordes_at( start ) + hordes_at( next ) == 1 );
+    }
+    CHECK( hordes_at( start ) == 0 );
+    // Found through the east overmap, so it has been handed over with local coordinates.
+    CHECK( hordes_at( next ) == 1 );
+    CHECK( east.mongroup_check( *overmap_buffer.groups_at( next ).front() ) );
+    west.clear_mon_groups();
+    east.clear_mon_groups();
+}
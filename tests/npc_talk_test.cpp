@@ -76,8 +76,7 @@ static void gen_response_lines( dialogue &d, size_t expected_count )
 static void change_om_type( const std::string &new_type )
 {
     const tripoint omt_pos = ms_to_omt_copy( g->m.getabs( g->u.pos() ) );
-    oter_id &omt_ref = overmap_buffer.ter( omt_pos );
-    omt_ref = oter_id( new_type );
+    overmap_buffer.ter_set( omt_pos, oter_id( new_type ) );
 }
 
 TEST_CASE( "npc_talk_test" )
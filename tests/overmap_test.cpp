@@ -1,8 +1,12 @@
+#include <algorithm>
+#include <climits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "catch/catch.hpp"
+#include "line.h"
 #include "map.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
@@ -106,3 +110,106 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin" )
     CHECK( found_optional == true );
 }
 
+
+// Checks every location, as find_all did before the terrain index.
+static std::vector<tripoint> find_all_by_scanning( const tripoint &origin, const std::string &type,
+        const ot_match_type match_type, const int dist )
+{
+    std::vector<tripoint> found;
+    for( int x = -dist; x <= dist; x++ ) {
+        for( int y = -dist; y <= dist; y++ ) {
+            const tripoint p = origin + point( x, y );
+            if( is_ot_match( type, overmap_buffer.ter( p ), match_type ) ) {
+                found.push_back( p );
+            }
+        }
+    }
+    return found;
+}
+
+TEST_CASE( "overmap_terrain_index_finds_the_same_terrain_as_scanning", "[overmap]" )
+{
+    // Close to the corner of the overmap, so the search covers its neighbours as well.
+    const tripoint origin( 10, 12, 0 );
+    const int dist = 40;
+    const std::vector<std::pair<std::string, ot_match_type>> searches = {
+        { "field", ot_match_type::exact },
+        { "road", ot_match_type::type },
+        { "forest", ot_match_type::prefix },
+        { "river", ot_match_type::contains },
+    };
+    for( const auto &search : searches ) {
+        INFO( search.first );
+        CHECK( overmap_buffer.find_all( origin, search.first, dist, false, search.second ) ==
+               find_all_by_scanning( origin, search.first, search.second, dist ) );
+    }
+
+    SECTION( "changed terrain is found" ) {
+        const tripoint changed = origin + point( 3, -5 );
+        const oter_id previous = overmap_buffer.ter( changed );
+        overmap_buffer.ter_set( changed, oter_id( "crater" ) );
+        const std::vector<tripoint> craters = overmap_buffer.find_all( origin, "crater", dist, false,
+                                              ot_match_type::exact );
+        CHECK( std::count( craters.begin(), craters.end(), changed ) == 1 );
+        CHECK( craters == find_all_by_scanning( origin, "crater", ot_match_type::exact, dist ) );
+
+        overmap_buffer.ter_set( changed, previous );
+        const std::vector<tripoint> restored = overmap_buffer.find_all( origin, "crater", dist, false,
+                                               ot_match_type::exact );
+        CHECK( std::count( restored.begin(), restored.end(), changed ) == 0 );
+    }
+}
+
+TEST_CASE( "overmap_find_closest_finds_the_nearest_terrain", "[overmap]" )
+{
+    const tripoint origin( 90, 90, 0 );
+    const int radius = 30;
+    const std::vector<std::string> types = { "road", "forest", "river", "lab" };
+    for( const std::string &type : types ) {
+        INFO( type );
+        int nearest = INT_MAX;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            for( const tripoint &p : find_all_by_scanning( tripoint( origin.xy(), z ), type,
+                    ot_match_type::type, radius ) ) {
+                nearest = std::min( nearest, square_dist( origin.xy(), p.xy() ) );
+            }
+        }
+        const tripoint closest = overmap_buffer.find_closest( origin, type, radius, false );
+        if( nearest == INT_MAX ) {
+            CHECK( closest == overmap::invalid_tripoint );
+        } else {
+            REQUIRE( closest != overmap::invalid_tripoint );
+            CHECK( is_ot_match( type, overmap_buffer.ter( closest ), ot_match_type::type ) );
+            CHECK( square_dist( origin.xy(), closest.xy() ) == nearest );
+        }
+    }
+}
+
+TEST_CASE( "pregenerated_overmap_is_the_same_as_a_generated_one", "[overmap]" )
+{
+    const point om_pos( 40, 40 );
+    REQUIRE_FALSE( overmap_buffer.has( om_pos ) );
+    // Next to the west edge of the overmap.
+    const tripoint player_pos( om_pos.x * OMAPX - 1, om_pos.y * OMAPY + OMAPY / 2, 0 );
+    const int pregenerated_before = overmap_buffer.pregenerated_count();
+    overmap_buffer.pregenerate_near( player_pos, 4 );
+    // Waits for the generation.
+    const overmap &pregenerated = overmap_buffer.get( om_pos );
+    // Otherwise get has generated it on this thread.
+    REQUIRE_FALSE( overmap_buffer.pregeneration_failed_at( om_pos ) );
+    REQUIRE( overmap_buffer.pregenerated_count() == pregenerated_before + 1 );
+
+    overmap generated( om_pos );
+    generated.populate();
+    int differences = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                if( pregenerated.get_ter( x, y, z ) != generated.get_ter( x, y, z ) ) {
+                    differences++;
+                }
+            }
+        }
+    }
+    CHECK( differences == 0 );
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "type_id.h"
+#include "point.h"
+
+static void check_route( const std::vector<tripoint> &route, const tripoint &from,
+                         const tripoint &to )
+{
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        INFO( "from " << prev << " to " << p );
+        CHECK( rl_dist( prev, p ) == 1 );
+        CHECK( g->m.passable( p ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "route_reuses_pathfinder_state", "[pathfinding]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    clear_map();
+    // The search heuristic only finds the shortest routes with square distances.
+    const bool old_trigdist = trigdist;
+    trigdist = false;
+
+    // A wall with a single gap, so the straight line doesn't work.
+    for( int y = 20; y < 100; y++ ) {
+        if( y != 60 ) {
+            g->m.ter_set( tripoint( 60, y, 0 ), t_brick_wall );
+        }
+    }
+
+    const pathfinding_settings settings( 0, 100, 200, 0, false, false, true, false );
+    const tripoint a( 50, 50, 0 );
+    const tripoint b( 70, 50, 0 );
+
+    const std::vector<tripoint> first = g->m.route( a, b, settings );
+    check_route( first, a, b );
+    CHECK( std::find( first.begin(), first.end(), tripoint( 60, 60, 0 ) ) != first.end() );
+
+    // Searches in between must not leave anything behind for the next one.
+    const std::vector<tripoint> back = g->m.route( b, a, settings );
+    check_route( back, b, a );
+    CHECK( back.size() == first.size() );
+
+    const std::set<tripoint> closed = { tripoint( 60, 60, 0 ) };
+    CHECK( g->m.route( a, b, settings, closed ).empty() );
+
+    for( int i = 0; i < 3; i++ ) {
+        CHECK( g->m.route( a, b, settings ) == first );
+    }
+    trigdist = old_trigdist;
+}
+
+TEST_CASE( "long_routes_use_submap_graph", "[pathfinding]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_grass( "t_grass" );
+    clear_map();
+
+    // Several walls across the map, each with a gap at a different spot.
+    const std::vector<int> gaps = { 30, 90, 45, 100 };
+    for( size_t i = 0; i < gaps.size(); i++ ) {
+        const int x = 35 + 20 * i;
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( y != gaps[i] ) {
+                g->m.ter_set( tripoint( x, y, 0 ), t_brick_wall );
+            }
+        }
+    }
+
+    const pathfinding_settings settings( 0, 200, 1000, 0, false, false, true, false );
+    const tripoint a( 20, 60, 0 );
+    const tripoint b( 115, 60, 0 );
+
+    const std::vector<tripoint> first = g->m.route( a, b, settings );
+    check_route( first, a, b );
+    for( size_t i = 0; i < gaps.size(); i++ ) {
+        CHECK( std::find( first.begin(), first.end(),
+                          tripoint( 35 + 20 * i, gaps[i], 0 ) ) != first.end() );
+    }
+
+    WHEN( "a gap is moved" ) {
+        g->m.ter_set( tripoint( 55, 90, 0 ), t_brick_wall );
+        g->m.ter_set( tripoint( 55, 20, 0 ), t_grass );
+        const std::vector<tripoint> second = g->m.route( a, b, settings );
+        THEN( "the route goes through the new gap" ) {
+            check_route( second, a, b );
+            CHECK( std::find( second.begin(), second.end(), tripoint( 55, 20, 0 ) ) != second.end() );
+        }
+    }
+
+    WHEN( "a wall is closed completely" ) {
+        g->m.ter_set( tripoint( 75, 45, 0 ), t_brick_wall );
+        THEN( "there is no route" ) {
+            CHECK( g->m.route( a, b, settings ).empty() );
+        }
+    }
+}
+
+TEST_CASE( "long_detours_are_found_on_the_submap_graph", "[pathfinding]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    clear_map();
+
+    // The only gap is far outside the area the regular search looks at around both ends.
+    const tripoint gap( 60, 5, 0 );
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        if( y != gap.y ) {
+            g->m.ter_set( tripoint( gap.x, y, 0 ), t_brick_wall );
+        }
+    }
+    const tripoint a( 20, 60, 0 );
+    const tripoint b( 100, 60, 0 );
+
+    const pathfinding_settings settings( 0, 200, 1000, 0, false, false, true, false );
+    const std::vector<tripoint> route = g->m.route( a, b, settings );
+    check_route( route, a, b );
+    CHECK( std::find( route.begin(), route.end(), gap ) != route.end() );
+
+    // 55 steps to the gap and back down, 40 of them diagonal each way.
+    const pathfinding_settings too_short( 0, 200, 250, 0, false, false, true, false );
+    CHECK( g->m.route( a, b, too_short ).empty() );
+
+    SECTION( "doors are part of the graph for settings that open them" ) {
+        const tripoint door( gap.x, 100, 0 );
+        g->m.ter_set( door, ter_id( "t_door_c" ) );
+        const pathfinding_settings doors( 0, 200, 1000, 0, true, false, true, false );
+        const std::vector<tripoint> door_route = g->m.route( a, b, doors );
+        REQUIRE( !door_route.empty() );
+        CHECK( door_route.back() == b );
+        CHECK( std::find( door_route.begin(), door_route.end(), door ) != door_route.end() );
+        // Without opening doors, the way through the gap is the only one.
+        CHECK( g->m.route( a, b, settings ) == route );
+    }
+}
@@ -77,3 +77,34 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "scoped_rng_engine_gives_a_repeatable_sequence", "[rng]" )
+{
+    const auto draw = []() {
+        std::vector<double> values;
+        for( int i = 0; i < 20; i++ ) {
+            values.push_back( rng( 0, 1000 ) );
+            values.push_back( rng_float( 0.0, 1.0 ) );
+            values.push_back( normal_roll( 0.0, 1.0 ) );
+        }
+        return values;
+    };
+    // Leaves a cached value in the normal distribution of the global engine.
+    normal_roll( 0.0, 1.0 );
+    std::vector<double> first;
+    {
+        scoped_rng_engine engine( 1234 );
+        first = draw();
+    }
+    std::vector<double> second;
+    {
+        scoped_rng_engine engine( 1234 );
+        {
+            // Nested engines do not disturb the outer sequence.
+            scoped_rng_engine inner( 1 );
+            draw();
+        }
+        second = draw();
+    }
+    CHECK( first == second );
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include "avatar.h"
+#include "catch/catch.hpp"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "type_id.h"
+
+template<typename T>
+using scent_array = scent_map::scent_array<T>;
+
+static constexpr int scent_radius = 40;
+
+// The scent diffusion as it was before it was restricted to the scented area and
+// vectorized, the results have to be identical.
+static void reference_diffusion( scent_array<int> &grscent, const scent_array<bool> &blocks_scent,
+                                 const scent_array<bool> &reduces_scent, const tripoint &center )
+{
+    std::unique_ptr<scent_array<int>> sum_3_scent_y_ptr( new scent_array<int>() );
+    std::unique_ptr<scent_array<int>> squares_used_y_ptr( new scent_array<int>() );
+    scent_array<int> &sum_3_scent_y = *sum_3_scent_y_ptr;
+    scent_array<int> &squares_used_y = *squares_used_y_ptr;
+
+    const int scentmap_minx = center.x - scent_radius;
+    const int scentmap_maxx = center.x + scent_radius;
+    const int scentmap_miny = center.y - scent_radius;
+    const int scentmap_maxy = center.y + scent_radius;
+    const int diffusivity = 100;
+
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                        squares_used_y[y][x] += 2;
+                    } else {
+                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                        squares_used_y[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+
+    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            auto &scent_here = grscent[x][y];
+            if( !blocks_scent[x][y] ) {
+                const int squares_used = squares_used_y[y][x - 1]
+                                         + squares_used_y[y][x]
+                                         + squares_used_y[y][x + 1];
+
+                int this_diffusivity;
+                if( !reduces_scent[x][y] ) {
+                    this_diffusivity = diffusivity;
+                } else {
+                    this_diffusivity = diffusivity / 5;
+                }
+                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                scent_here =
+                    ( temp_scent
+                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
+                                             + sum_3_scent_y[y][x]
+                                             + sum_3_scent_y[y][x + 1] )
+                    ) / ( 1000 * 10 );
+            } else {
+                scent_here = 0;
+            }
+        }
+    }
+}
+
+TEST_CASE( "scent_diffusion_kernel_matches_reference", "[scent]" )
+{
+    std::unique_ptr<scent_array<int>> scent( new scent_array<int>() );
+    std::unique_ptr<scent_array<int>> expected( new scent_array<int>() );
+    std::unique_ptr<scent_array<bool>> blocks( new scent_array<bool>() );
+    std::unique_ptr<scent_array<bool>> reduces( new scent_array<bool>() );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            ( *scent )[x][y] = one_in( 3 ) ? rng( 0, 1000 ) : 0;
+            ( *blocks )[x][y] = one_in( 10 );
+            ( *reduces )[x][y] = !( *blocks )[x][y] && one_in( 10 );
+        }
+    }
+    *expected = *scent;
+
+    const tripoint center( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+    const rectangle area( center.xy() - point( scent_radius, scent_radius ),
+                          center.xy() + point( scent_radius, scent_radius ) );
+    for( int step = 0; step < 10; ++step ) {
+        reference_diffusion( *expected, *blocks, *reduces, center );
+        scent_map::diffuse( *scent, *blocks, *reduces, area );
+        CHECK( *scent == *expected );
+    }
+}
+
+TEST_CASE( "scent_update_matches_reference", "[scent]" )
+{
+    clear_map();
+    const tripoint center = g->u.pos();
+    for( int i = 0; i < 30; ++i ) {
+        g->m.ter_set( center + tripoint( rng( -20, 20 ), rng( -20, 20 ), 0 ), ter_id( "t_wall" ) );
+    }
+
+    scent_map scent( *g );
+    scent.reset();
+    std::unique_ptr<scent_array<int>> expected( new scent_array<int>() );
+    for( auto &column : *expected ) {
+        column.fill( 0 );
+    }
+    // A few scent trails, one of them partially outside the updated radius.
+    const std::array<tripoint, 4> sources = { {
+            center + tripoint( 3, 2, 0 ), center + tripoint( -15, 8, 0 ),
+            center + tripoint( 38, -39, 0 ), center + tripoint( -45, 0, 0 )
+        }
+    };
+    for( const tripoint &p : sources ) {
+        scent.set( p, 500 );
+        ( *expected )[p.x][p.y] = 500;
+    }
+
+    std::unique_ptr<scent_array<bool>> blocks( new scent_array<bool>() );
+    std::unique_ptr<scent_array<bool>> reduces( new scent_array<bool>() );
+    g->m.scent_blockers( *blocks, *reduces, center.x - scent_radius - 1, center.y - scent_radius - 1,
+                         center.x + scent_radius + 1, center.y + scent_radius + 1 );
+    for( int step = 0; step < 20; ++step ) {
+        reference_diffusion( *expected, *blocks, *reduces, center );
+        scent.update( center, g->m );
+    }
+    std::unique_ptr<scent_array<int>> actual( new scent_array<int>() );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            ( *actual )[x][y] = scent.get( tripoint( x, y, center.z ) );
+            ( *expected )[x][y] = std::max( 0, ( *expected )[x][y] );
+        }
+    }
+    CHECK( *actual == *expected );
+    clear_map();
+}
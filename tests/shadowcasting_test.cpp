@@ -1,5 +1,6 @@
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <random>
 #include <array>
 #include <functional>
@@ -8,6 +9,7 @@
 #include <vector>
 
 #include "catch/catch.hpp"
+#include "game.h" // For trigdist.
 #include "line.h" // For rl_dist.
 #include "map.h"
 #include "rng.h"
@@ -404,6 +406,71 @@ static void shadowcasting_3d_2d( const int iterations )
     REQUIRE( passed );
 }
 
+static void shadowcasting_rows_vs_recursive( const int iterations,
+        const unsigned int denominator = DENOMINATOR )
+{
+    float seen_recursive[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    float seen_rows[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    four_quadrants lit_recursive[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{}};
+    four_quadrants lit_rows[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{}};
+    float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+
+    randomly_fill_transparency( transparency_cache, NUMERATOR, denominator );
+    // Mix in some partially transparent tiles, so the cumulative transparency varies.
+    for( auto &inner : transparency_cache ) {
+        for( float &square : inner ) {
+            if( square != LIGHT_TRANSPARENCY_SOLID && one_in( 4 ) ) {
+                square = LIGHT_TRANSPARENCY_OPEN_AIR * rng( 2, 10 );
+            }
+        }
+    }
+
+    // Near the middle, near the edges and in the corners of the map.
+    const int offsetX = one_in( 3 ) ? rng( 0, 10 ) : rng( 40, 90 );
+    const int offsetY = one_in( 3 ) ? rng( 120, MAPSIZE * SEEY - 1 ) : rng( 40, 90 );
+    const int offsetDistance = one_in( 2 ) ? 0 : rng( 1, 30 );
+    const bool old_row_shadowcasting = row_shadowcasting;
+    INFO( "origin " << offsetX << "," << offsetY << " offset distance " << offsetDistance );
+
+    row_shadowcasting = false;
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            seen_recursive, transparency_cache, offsetX, offsetY, offsetDistance );
+        castLightAll<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                     accumulate_transparency>(
+                         lit_recursive, transparency_cache, offsetX, offsetY, offsetDistance );
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    row_shadowcasting = true;
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            seen_rows, transparency_cache, offsetX, offsetY, offsetDistance );
+        castLightAll<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                     accumulate_transparency>(
+                         lit_rows, transparency_cache, offsetX, offsetY, offsetDistance );
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+    row_shadowcasting = old_row_shadowcasting;
+
+    if( iterations > 1 ) {
+        const long long diff1 =
+            std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+        const long long diff2 =
+            std::chrono::duration_cast<std::chrono::microseconds>( end2 - start2 ).count();
+        printf( "recursive castLight (denominator %u) executed %d times in %lld microseconds.\n",
+                denominator, iterations, diff1 );
+        printf( "castLightRows (denominator %u) executed %d times in %lld microseconds.\n",
+                denominator, iterations, diff2 );
+    }
+
+    // Not just equivalent, the values have to be exactly the same.
+    CHECK( std::memcmp( seen_recursive, seen_rows, sizeof( seen_rows ) ) == 0 );
+    CHECK( std::memcmp( lit_recursive, lit_rows, sizeof( lit_rows ) ) == 0 );
+}
+
 
 // T, O and V are 'T'ransparent, 'O'paque and 'V'isible.
 // X marks the player location, which is not set to visible by this algorithm.
@@ -642,3 +709,22 @@ TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
     shadowcasting_runoff( 1, true );
 }
+
+TEST_CASE( "shadowcasting_rows_match_recursive", "[shadowcasting]" )
+{
+    const bool old_trigdist = trigdist;
+    for( int use_trigdist = 0; use_trigdist < 2; use_trigdist++ ) {
+        trigdist = use_trigdist == 1;
+        INFO( "trigdist " << trigdist );
+        for( int i = 0; i < 20; i++ ) {
+            shadowcasting_rows_vs_recursive( 1, rng( 3, 20 ) );
+        }
+    }
+    trigdist = old_trigdist;
+}
+
+TEST_CASE( "shadowcasting_rows_performance", "[.]" )
+{
+    shadowcasting_rows_vs_recursive( 10000 );
+    shadowcasting_rows_vs_recursive( 10000, 100 );
+}
@@ -0,0 +1,78 @@
+#include <map>
+#include <string>
+#include <utility>
+
+#include "catch/catch.hpp"
+#include "rng.h"
+#include "small_slot_map.h"
+
+using test_map = cata::small_slot_map<int, std::string, 2>;
+
+static std::map<int, std::string> as_std_map( const test_map &m )
+{
+    std::map<int, std::string> result;
+    for( const auto &elem : m ) {
+        result.emplace( elem.first, elem.second );
+    }
+    return result;
+}
+
+TEST_CASE( "small_slot_map", "[small_slot_map]" )
+{
+    test_map m;
+    CHECK( m.empty() );
+    CHECK( m.begin() == m.end() );
+
+    CHECK( m.emplace( 5, "five" ).second );
+    CHECK( m.emplace( 3, "three" ).second );
+    CHECK_FALSE( m.emplace( 5, "other" ).second );
+    CHECK( m.find( 5 )->second == "five" );
+    CHECK( m.find( 4 ) == m.end() );
+
+    SECTION( "references stay valid when elements are added and removed" ) {
+        std::string &three = m.find( 3 )->second;
+        for( int i = 10; i < 20; ++i ) {
+            m.emplace( i, std::to_string( i ) );
+        }
+        std::string &fifteen = m.find( 15 )->second;
+        CHECK( m.erase( 5 ) == 1 );
+        CHECK( m.erase( 5 ) == 0 );
+        for( int i = 20; i < 30; ++i ) {
+            m.emplace( i, std::to_string( i ) );
+        }
+        CHECK( &three == &m.find( 3 )->second );
+        CHECK( &fifteen == &m.find( 15 )->second );
+        CHECK( m.size() == 21 );
+    }
+    SECTION( "erasing while iterating" ) {
+        m.emplace( 7, "seven" );
+        m.emplace( 8, "eight" );
+        for( auto it = m.begin(); it != m.end(); ) {
+            if( it->first % 2 == 1 ) {
+                it = m.erase( it );
+            } else {
+                ++it;
+            }
+        }
+        CHECK( as_std_map( m ) == std::map<int, std::string> { { 8, "eight" } } );
+    }
+    SECTION( "behaves like a std::map" ) {
+        std::map<int, std::string> ref = as_std_map( m );
+        for( int i = 0; i < 1000; ++i ) {
+            const int key = rng( 0, 6 );
+            if( one_in( 2 ) ) {
+                const std::string value = std::to_string( i );
+                CHECK( m.emplace( key, value ).second == ref.emplace( key, value ).second );
+            } else {
+                CHECK( m.erase( key ) == ref.erase( key ) );
+            }
+            CHECK( m.size() == ref.size() );
+            CHECK( as_std_map( m ) == ref );
+        }
+        const test_map copy = m;
+        CHECK( as_std_map( copy ) == ref );
+        test_map moved = std::move( m );
+        CHECK( as_std_map( moved ) == ref );
+        CHECK( m.empty() );
+    }
+}
@@ -0,0 +1,64 @@
+#include <map>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "point.h"
+#include "rng.h"
+#include "submap_index.h"
+
+class submap;
+
+TEST_CASE( "submap_index_matches_std_map", "[mapbuffer]" )
+{
+    // The index never dereferences the submaps, fake addresses are fine for testing.
+    std::vector<char> storage( 1000 );
+    const auto fake_submap = [&]( const int i ) {
+        return reinterpret_cast<submap *>( &storage[i] );
+    };
+
+    submap_index index;
+    std::map<tripoint, submap *> reference;
+    for( int i = 0; i < 20000; ++i ) {
+        // A small area, so inserts, lookups and erases hit the same coordinates a lot,
+        // including negative ones.
+        const tripoint p( rng( -20, 20 ), rng( -20, 20 ), rng( -2, 2 ) );
+        submap *const sm = fake_submap( rng( 0, 999 ) );
+        switch( rng( 0, 2 ) ) {
+            case 0:
+                CHECK( index.insert( p, sm ) == reference.emplace( p, sm ).second );
+                break;
+            case 1: {
+                const auto iter = reference.find( p );
+                CHECK( index.erase( p ) == ( iter == reference.end() ? nullptr : iter->second ) );
+                if( iter != reference.end() ) {
+                    reference.erase( iter );
+                }
+                break;
+            }
+            default: {
+                const auto iter = reference.find( p );
+                CHECK( index.find( p ) == ( iter == reference.end() ? nullptr : iter->second ) );
+                break;
+            }
+        }
+    }
+
+    CHECK( index.size() == reference.size() );
+    std::vector<tripoint> reference_keys;
+    for( const auto &elem : reference ) {
+        reference_keys.push_back( elem.first );
+        CHECK( index.find( elem.first ) == elem.second );
+    }
+    CHECK( index.sorted_keys() == reference_keys );
+
+    size_t iterated = 0;
+    for( const auto &elem : index ) {
+        CHECK( reference.at( elem.first ) == elem.second );
+        ++iterated;
+    }
+    CHECK( iterated == reference.size() );
+
+    index.clear();
+    CHECK( index.empty() );
+    CHECK( index.find( reference_keys.front() ) == nullptr );
+}
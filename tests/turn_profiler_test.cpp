@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+#include "turn_profiler.h"
+
+#if defined(TURN_PROFILER)
+
+#include <chrono>
+#include <vector>
+
+TEST_CASE( "turn_profiler_keeps_the_last_turns", "[turn_profiler]" )
+{
+    const int first_turn = 1000000;
+    for( int i = 0; i < turn_profiler::history_size + 10; ++i ) {
+        CATA_PROFILE_END_TURN( first_turn + i );
+    }
+    const std::vector<turn_profiler::turn_record> turns = turn_profiler::history();
+    REQUIRE( turns.size() == static_cast<size_t>( turn_profiler::history_size ) );
+    CHECK( turns.front().turn == first_turn + 10 );
+    CHECK( turns.back().turn == first_turn + turn_profiler::history_size + 9 );
+}
+
+// Stands in for the steady clock, so the recorded times are exact.
+static std::chrono::steady_clock::time_point fake_now;
+
+static std::chrono::steady_clock::time_point fake_clock()
+{
+    return fake_now;
+}
+
+TEST_CASE( "turn_profiler_excludes_nested_stages", "[turn_profiler]" )
+{
+    using std::chrono::milliseconds;
+    turn_profiler::set_clock( fake_clock );
+    // Finish whatever turn was being recorded before.
+    CATA_PROFILE_END_TURN( 0 );
+    {
+        CATA_PROFILE_STAGE( monmove );
+        fake_now += milliseconds( 5 );
+        {
+            CATA_PROFILE_STAGE( npc_planning );
+            fake_now += milliseconds( 20 );
+            CATA_PROFILE_COUNT( los_cache_hit );
+        }
+        fake_now += milliseconds( 1 );
+        CATA_PROFILE_COUNT( los_cache_hit );
+    }
+    {
+        CATA_PROFILE_STAGE( npc_planning );
+        fake_now += milliseconds( 3 );
+    }
+    // Outside of any stage, only counts for the whole turn.
+    fake_now += milliseconds( 2 );
+    CATA_PROFILE_END_TURN( 1 );
+    turn_profiler::set_clock( nullptr );
+
+    const turn_profiler::turn_record &rec = turn_profiler::history().back();
+    CHECK( rec.turn == 1 );
+    for( int i = 0; i < turn_profiler::num_stages; ++i ) {
+        const turn_profiler::stage s = static_cast<turn_profiler::stage>( i );
+        CAPTURE( turn_profiler::stage_name( s ) );
+        if( s == turn_profiler::stage::monmove ) {
+            CHECK( rec.stage_us[i] == 6000 );
+        } else if( s == turn_profiler::stage::npc_planning ) {
+            CHECK( rec.stage_us[i] == 23000 );
+        } else {
+            CHECK( rec.stage_us[i] == 0 );
+        }
+    }
+    CHECK( rec.total_us == 31000 );
+    CHECK( rec.counts[static_cast<int>( turn_profiler::counter::los_cache_hit )] == 2 );
+    CHECK( rec.counts[static_cast<int>( turn_profiler::counter::los_cache_miss )] == 0 );
+}
+
+#endif
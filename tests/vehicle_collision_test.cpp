@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "optional.h"
+#include "point.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+static vehicle &place_car( const tripoint &p )
+{
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), p, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    return *veh;
+}
+
+static rectangle bounds_of( const vehicle &veh )
+{
+    const cata::optional<rectangle> bounds = g->m.vehicle_bounds( veh );
+    REQUIRE( bounds );
+    return *bounds;
+}
+
+// Prepares a move of the vehicle like map::move_vehicle does, returns the displacement of its
+// position, which cancels out the change of the pivot.
+static tripoint precalc_move( vehicle &veh, const tripoint &dp )
+{
+    veh.precalc_mounts( 1, veh.face.dir(), veh.pivot_point() );
+    return dp - veh.pivot_displacement();
+}
+
+static bool detects_collision( vehicle &veh, const tripoint &dp, const vehicle *target )
+{
+    std::vector<veh_collision> colls;
+    if( !veh.collision( colls, precalc_move( veh, dp ), true ) ) {
+        return false;
+    }
+    REQUIRE( colls.size() == 1 );
+    CHECK( colls[0].type == veh_coll_veh );
+    CHECK( colls[0].target == target );
+    return true;
+}
+
+static box bounds_box( const rectangle &bounds, const int z )
+{
+    return box( bounds, z, z );
+}
+
+TEST_CASE( "vehicle_broad_phase_tracks_vehicle_bounds", "[vehicle]" )
+{
+    clear_map_and_put_player_underground();
+    vehicle &car = place_car( tripoint( 30, 30, 0 ) );
+    const rectangle car_bounds = bounds_of( car );
+    const int width = car_bounds.p_max.x - car_bounds.p_min.x + 1;
+    // In the same grid cell and in another one.
+    vehicle &near_car = place_car( tripoint( 30 + width + 2, 30, 0 ) );
+    vehicle &far_car = place_car( tripoint( 90, 90, 0 ) );
+
+    const rectangle near_bounds = bounds_of( near_car );
+    CHECK( near_bounds.p_min.x > car_bounds.p_max.x );
+    for( const tripoint &p : car.get_points() ) {
+        CHECK( car_bounds.contains_inclusive( p.xy() ) );
+    }
+
+    box area = bounds_box( car_bounds, 0 );
+    CHECK( g->m.vehicles_near( area, &car ).empty() );
+    area.p_max.x = near_bounds.p_min.x;
+    CHECK( g->m.vehicles_near( area, &car ) == std::vector<vehicle *>( { &near_car } ) );
+    CHECK( g->m.vehicles_near( area ).size() == 2 );
+    // Vehicles are only found on their own z-level.
+    CHECK( g->m.vehicles_near( bounds_box( near_bounds, 1 ) ).empty() );
+
+    SECTION( "moved vehicles are found at their new position" ) {
+        const rectangle old_bounds = bounds_of( far_car );
+        tripoint origin = far_car.global_pos3();
+        g->m.displace_vehicle( origin, precalc_move( far_car, tripoint( -60, -40, 0 ) ) );
+        const rectangle moved_bounds = bounds_of( far_car );
+        CHECK( moved_bounds.p_min == old_bounds.p_min + point( -60, -40 ) );
+        const std::vector<vehicle *> found = g->m.vehicles_near( bounds_box( moved_bounds, 0 ) );
+        CHECK( std::count( found.begin(), found.end(), &far_car ) == 1 );
+        CHECK( g->m.vehicles_near( bounds_box( old_bounds, 0 ) ).empty() );
+    }
+    SECTION( "detached vehicles are no longer found" ) {
+        g->m.detach_vehicle( &near_car );
+        CHECK( g->m.vehicles_near( area ) == std::vector<vehicle *>( { &car } ) );
+    }
+}
+
+TEST_CASE( "vehicle_collision_only_with_vehicles_in_the_way", "[vehicle]" )
+{
+    clear_map_and_put_player_underground();
+    vehicle &car = place_car( tripoint( 40, 60, 0 ) );
+    const rectangle car_bounds = bounds_of( car );
+    const int width = car_bounds.p_max.x - car_bounds.p_min.x + 1;
+    vehicle &other = place_car( tripoint( 40 + width + 4, 60, 0 ) );
+    const int gap = bounds_of( other ).p_min.x - car_bounds.p_max.x;
+    REQUIRE( gap > 1 );
+    // Both cars have the same shape, this moves one exactly onto the other.
+    const tripoint onto = other.global_pos3() - car.global_pos3();
+
+    CHECK_FALSE( detects_collision( car, tripoint( gap - 1, 0, 0 ), &other ) );
+    CHECK( detects_collision( car, onto, &other ) );
+    CHECK( detects_collision( other, -onto, &car ) );
+    // Passing beside it.
+    const int height = car_bounds.p_max.y - car_bounds.p_min.y + 1;
+    CHECK_FALSE( detects_collision( car, onto + tripoint( 0, height, 0 ), &other ) );
+    CHECK_FALSE( detects_collision( car, onto + tripoint( 0, -height, 0 ), &other ) );
+}
+
+// Fills the map with cars, leaving the given number of free tiles between them.
+static std::vector<vehicle *> fill_with_cars( const int spacing )
+{
+    clear_map_and_put_player_underground();
+    std::vector<vehicle *> cars;
+    vehicle &first = place_car( tripoint( 10, 10, 0 ) );
+    const rectangle bounds = bounds_of( first );
+    const point step( bounds.p_max.x - bounds.p_min.x + 1 + spacing,
+                      bounds.p_max.y - bounds.p_min.y + 1 + spacing );
+    cars.push_back( &first );
+    for( int x = 10; x + step.x < MAPSIZE_X - 10; x += step.x ) {
+        for( int y = 10; y + step.y < MAPSIZE_Y - 10; y += step.y ) {
+            if( x != 10 || y != 10 ) {
+                cars.push_back( &place_car( tripoint( x, y, 0 ) ) );
+            }
+        }
+    }
+    return cars;
+}
+
+static void collision_benchmark( const char *scene, const int spacing )
+{
+    const std::vector<vehicle *> cars = fill_with_cars( spacing );
+    constexpr int iterations = 1000;
+    int collisions = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        for( vehicle *veh : cars ) {
+            std::vector<veh_collision> colls;
+            if( veh->collision( colls, precalc_move( *veh, tripoint( 1, 0, 0 ) ), true ) ) {
+                collisions++;
+            }
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const long long diff = std::chrono::duration_cast<std::chrono::microseconds>
+                           ( end - start ).count();
+    printf( "%s: %d collision checks of %d cars (%d collisions) in %lld microseconds.\n", scene,
+            iterations * static_cast<int>( cars.size() ), static_cast<int>( cars.size() ),
+            collisions, diff );
+}
+
+TEST_CASE( "vehicle_collision_performance", "[.]" )
+{
+    collision_benchmark( "traffic", 6 );
+    collision_benchmark( "parking lot", 1 );
+}
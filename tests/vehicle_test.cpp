@@ -1,3 +1,4 @@
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -45,3 +46,54 @@ TEST_CASE( "destroy_grabbed_vehicle_section" )
         }
     }
 }
+
+TEST_CASE( "vehicle_part_indices_match_the_parts", "[vehicle]" )
+{
+    clear_map();
+    vehicle *veh_ptr = g->m.add_vehicle( vproto_id( "car" ), tripoint( 60, 60, 0 ), 0, 100, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+
+    const auto check_fuels = [&veh]() {
+        std::map<itype_id, int> left;
+        std::map<itype_id, int> capacity;
+        int batteries = 0;
+        int lights = 0;
+        for( const vehicle_part &pt : veh.parts ) {
+            if( pt.removed ) {
+                continue;
+            }
+            left[pt.ammo_current()] += pt.ammo_remaining();
+            capacity[pt.ammo_current()] += pt.ammo_capacity();
+            batteries += pt.is_battery() ? 1 : 0;
+            lights += pt.is_light() ? 1 : 0;
+        }
+        left.erase( "null" );
+        for( const auto &fuel : left ) {
+            INFO( fuel.first );
+            CHECK( veh.fuel_left( fuel.first ) == fuel.second );
+            CHECK( veh.fuel_capacity( fuel.first ) == capacity[fuel.first] );
+        }
+        CHECK( veh.batteries.size() == static_cast<size_t>( batteries ) );
+        CHECK( veh.light_parts.size() == static_cast<size_t>( lights ) );
+    };
+
+    REQUIRE_FALSE( veh.batteries.empty() );
+    REQUIRE( veh.fuel_capacity( "gasoline" ) > 0 );
+    check_fuels();
+
+    SECTION( "after the batteries are charged and drained" ) {
+        veh.charge_battery( veh.fuel_capacity( "battery" ) );
+        CHECK( veh.fuel_left( "battery" ) == veh.fuel_capacity( "battery" ) );
+        veh.discharge_battery( veh.fuel_left( "battery" ) / 2 );
+        veh.drain( "gasoline", veh.fuel_left( "gasoline" ) / 2 );
+        check_fuels();
+    }
+    SECTION( "after a battery is removed" ) {
+        const int battery = veh.batteries.front();
+        veh.remove_part( battery );
+        check_fuels();
+        veh.part_removal_cleanup();
+        check_fuels();
+    }
+}